@@ -17,6 +17,8 @@
 * limitations under the License.
 **/
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 
 #include "Bluetooth.h"
@@ -70,6 +72,14 @@ const string WPEFramework::Plugin::Bluetooth::METHOD_GET_DEVICE_VOLUME_MUTE_INFO
 const string WPEFramework::Plugin::Bluetooth::METHOD_SET_DEVICE_VOLUME_MUTE_INFO = "setDeviceVolumeMuteInfo";
 const string WPEFramework::Plugin::Bluetooth::METHOD_SET_AUTO_CONNECT = "setAutoConnect";
 const string WPEFramework::Plugin::Bluetooth::METHOD_GET_AUTO_CONNECT_STATUS = "getAutoConnect";
+const string WPEFramework::Plugin::Bluetooth::METHOD_GET_EVENT_STATS = "getEventStats";
+const string WPEFramework::Plugin::Bluetooth::METHOD_GET_EVENTS_SINCE = "getEventsSince";
+const string WPEFramework::Plugin::Bluetooth::METHOD_RECONCILE_DEVICES = "reconcileDevices";
+const string WPEFramework::Plugin::Bluetooth::METHOD_GET_DEVICE_SNAPSHOT = "getDeviceSnapshot";
+const string WPEFramework::Plugin::Bluetooth::METHOD_SET_BACKGROUND_DISCOVERY = "setBackgroundDiscovery";
+const string WPEFramework::Plugin::Bluetooth::METHOD_GET_BACKGROUND_DISCOVERY = "getBackgroundDiscovery";
+const string WPEFramework::Plugin::Bluetooth::METHOD_GET_OPERATION_STATUS = "getOperationStatus";
+const string WPEFramework::Plugin::Bluetooth::METHOD_CANCEL_OPERATION = "cancelOperation";
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
 const string WPEFramework::Plugin::Bluetooth::METHOD_PERFORM_MIGRATION = "performMigration";
 const string WPEFramework::Plugin::Bluetooth::METHOD_CLEAR_MIGRATION = "clearMigration";
@@ -91,11 +101,15 @@ const string WPEFramework::Plugin::Bluetooth::EVT_PLAYBACK_NEW_TRACK = "onPlayba
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_FOUND = "onDeviceFound";
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_LOST_OR_OUT_OF_RANGE = "onDeviceLost";
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_DISCOVERY_UPDATE = "onDiscoveredDevice";
+const string WPEFramework::Plugin::Bluetooth::EVT_DISCOVERED_DEVICES = "onDiscoveredDevices";
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_MEDIA_STATUS = "onDeviceMediaStatus";
+const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_MATCHED = "onDeviceMatched";
+const string WPEFramework::Plugin::Bluetooth::EVT_OPERATION_COMPLETE = "onOperationComplete";
 
 const string WPEFramework::Plugin::Bluetooth::STATUS_NO_BLUETOOTH_HARDWARE = "NO_BLUETOOTH_HARDWARE";
 const string WPEFramework::Plugin::Bluetooth::STATUS_SOFTWARE_DISABLED = "SOFTWARE_DISABLED";
 const string WPEFramework::Plugin::Bluetooth::STATUS_AVAILABLE = "AVAILABLE";
+const string WPEFramework::Plugin::Bluetooth::STATUS_DISCOVERY_FAILED = "DISCOVERY_FAILED";
 const string WPEFramework::Plugin::Bluetooth::ENABLE_CONNECT = "CONNECT";
 const string WPEFramework::Plugin::Bluetooth::ENABLE_DISCONNECT = "DISCONNECT";
 const string WPEFramework::Plugin::Bluetooth::ENABLE_BLUETOOTH_ENABLED = "BLUETOOTH_ENABLED";
@@ -151,24 +165,76 @@ namespace WPEFramework
 
         Bluetooth* Bluetooth::_instance = nullptr;
         static Core::TimerType<DiscoveryTimer> _discoveryTimer(64 * 1024, "DiscoveryTimer");
+        static Core::TimerType<EventTimer> _eventTimer(64 * 1024, "BluetoothEventTimer");
+
+        void DeferredEventTimer::Schedule(uint64_t delayMs)
+        {
+            if (!m_scheduled) {
+                m_scheduled = true;
+                _eventTimer.Schedule(Core::Time::Now().Add(static_cast<uint32_t>(delayMs)), m_timer);
+            }
+        }
+
+        uint64_t DeferredEventTimer::Reschedule(uint64_t delayMs)
+        {
+            m_scheduled = (0 != delayMs);
+            return m_scheduled ? Core::Time::Now().Add(static_cast<uint32_t>(delayMs)).Ticks() : 0;
+        }
+
+        void DeferredEventTimer::Revoke()
+        {
+            _eventTimer.Revoke(m_timer);
+            m_lock.Lock();
+            m_scheduled = false;
+            m_lock.Unlock();
+        }
+
+        static uint64_t monotonicTimeMs()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static uint64_t monotonicTimeUs()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
 
         BTRMGR_Result_t bluetoothSrv_EventCallback (BTRMGR_EventMessage_t eventMsg)
         {
+            const uint64_t ingressUs = monotonicTimeUs();
             if (!Bluetooth::_instance) {
                 LOGERR ("Invalid pointer. Bluetooth is not initialized (yet?). Event of type %d ignored.", eventMsg.m_eventType);
                 return BTRMGR_RESULT_INIT_FAILED;
             } else {
-                Bluetooth::_instance->notifyEventWrapper(eventMsg);
+                // Runs on the BTRMGR/IARM thread: only hand the message over to the dispatcher.
+                Bluetooth::_instance->queueEvent(eventMsg, ingressUs);
                 return BTRMGR_RESULT_SUCCESS;
             }
         }
 
         Bluetooth::Bluetooth()
-        : PluginHost::JSONRPC()
+        : PluginHost::JSONRPCSupportsEventStatus()
         , m_apiVersionNumber(API_VERSION_NUMBER_MAJOR)
         , m_discoveryRunning(false)
+        , m_discoveryType(BTRMGR_DEVICE_OP_TYPE_UNKNOWN)
         , m_discoveryTimer(this)
+        , m_discoveryTimerTicks(0)
+        , m_discoveryScanningMs(0)
+        , m_discoveryStartedMs(0)
         , m_powerManagerNotification(*this)
+        , m_playbackProgressTimer(this, EventTimer::PLAYBACK_PROGRESS)
+        , m_discoveryBatchTimer(this, EventTimer::DISCOVERY_BATCH)
+        , m_discoveryIndexTimer(this, EventTimer::DISCOVERY_INDEX)
+        , m_connectionSettleTimer(this, EventTimer::CONNECTION_SETTLE)
+        , m_deviceRegistryTimer(this, EventTimer::DEVICE_REGISTRY)
+        , m_deviceRegistryInterval(BLUETOOTH_DEVICE_REGISTRY_DEFAULT_INTERVAL_MS)
+        , m_backgroundDiscoveryTimer(this, EventTimer::BACKGROUND_DISCOVERY)
+        , m_backgroundDiscoveryEnabled(false)
+        , m_backgroundDiscoveryType(BTRMGR_DEVICE_OP_TYPE_UNKNOWN)
+        , m_backgroundDiscoveryTicks(0)
+        , m_powerState(WPEFramework::Exchange::IPowerManager::PowerState::POWER_STATE_UNKNOWN)
         {
             Bluetooth::_instance = this;
         }
@@ -177,26 +243,52 @@ namespace WPEFramework
         {
         }
 
+        bool Bluetooth::connectedDevices(std::vector<RegisteredDevice>& devices)
+        {
+            if (registeredDevices(BluetoothDeviceRegistry::LIST_CONNECTED, devices)) {
+                return true;
+            }
+
+            return readDeviceList(BluetoothDeviceRegistry::LIST_CONNECTED, devices);
+        }
+
+        bool Bluetooth::isAudioStreaming()
+        {
+            std::vector<RegisteredDevice> connected;
+            if (!connectedDevices(connected)) {
+                return false;
+            }
+            for (const RegisteredDevice& device : connected) {
+                const BluetoothDeviceCategory category = bluetoothDeviceCategory(bluetoothDeviceTypeFromBtrmgr(device.deviceType));
+                if ((BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT == category) || (BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT == category)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         void Bluetooth::disconnectExternallyConnectedDevices()
         {
-            JsonArray connectedDevicesJson = getConnectedDevices();
+            std::vector<RegisteredDevice> connected;
+            if (!connectedDevices(connected)) {
+                return;
+            }
 
-            for (size_t i = 0; i < connectedDevicesJson.Length(); i++)
+            for (const RegisteredDevice& device : connected)
             {
-                JsonObject device = connectedDevicesJson[i].Object();
-                string deviceID = device["deviceID"].String();
-                string deviceType = device["deviceType"].String();
+                const BluetoothDeviceType deviceType = bluetoothDeviceTypeFromBtrmgr(device.deviceType);
 
-                if (device.HasLabel("autoconnect") &&
-                    !device["autoconnect"].Boolean() &&
-                    deviceType != "HUMAN INTERFACE DEVICE")
+                // Only devices whose autoconnect was stored as disabled, see encodeStoredDeviceFields().
+                AutoConnectStatus autoConnectStatus;
+                if ((Core::ERROR_NONE == m_bluetoothDeviceManager.getAutoConnect(device.deviceHandle, autoConnectStatus)) &&
+                    (AUTO_CONNECT_STATUS_DISABLED == autoConnectStatus) &&
+                    !isHumanInterfaceDevice(deviceType))
                 {
-                    LOGINFO("Disconnecting externally connected device with deviceID=%s\n", deviceID.c_str());
-                    try {
-                        (void)setDeviceConnection(std::stoll(deviceID), false, deviceType);
-                    } catch (const std::exception& e) {
-                        LOGERR("Failed to disconnect device with deviceID=%s: %s\n", deviceID.c_str(), e.what());
-                    }
+                    LOGINFO("Disconnecting externally connected device with deviceID=%llu\n", device.deviceHandle);
+                    const BluetoothDeviceCategory category = bluetoothDeviceCategory(deviceType);
+                    const BTRMgrDeviceHandle deviceHandle = device.deviceHandle;
+                    (void)m_operationExecutor.execute(METHOD_DISCONNECT, deviceHandle,
+                        [this, deviceHandle, category]() { return setDeviceConnection(deviceHandle, false, category); });
                 }
             }
         }
@@ -230,13 +322,57 @@ namespace WPEFramework
             Register(METHOD_SET_DEVICE_VOLUME_MUTE_INFO, &Bluetooth::setDeviceVolumeMuteInfoWrapper, this);
             Register(METHOD_SET_AUTO_CONNECT, &Bluetooth::setAutoConnectWrapper, this);
             Register(METHOD_GET_AUTO_CONNECT_STATUS, &Bluetooth::getAutoConnectWrapper, this);
+            Register(METHOD_GET_EVENT_STATS, &Bluetooth::getEventStatsWrapper, this);
+            Register(METHOD_GET_EVENTS_SINCE, &Bluetooth::getEventsSinceWrapper, this);
+            Register(METHOD_RECONCILE_DEVICES, &Bluetooth::reconcileDevicesWrapper, this);
+            Register(METHOD_GET_DEVICE_SNAPSHOT, &Bluetooth::getDeviceSnapshotWrapper, this);
+            Register(METHOD_SET_BACKGROUND_DISCOVERY, &Bluetooth::setBackgroundDiscoveryWrapper, this);
+            Register(METHOD_GET_BACKGROUND_DISCOVERY, &Bluetooth::getBackgroundDiscoveryWrapper, this);
+            Register(METHOD_GET_OPERATION_STATUS, &Bluetooth::getOperationStatusWrapper, this);
+            Register(METHOD_CANCEL_OPERATION, &Bluetooth::cancelOperationWrapper, this);
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             Register(METHOD_PERFORM_MIGRATION, &Bluetooth::performMigrationWrapper, this);
             Register(METHOD_CLEAR_MIGRATION, &Bluetooth::clearMigrationWrapper, this);
 #endif
 
+            m_eventSubscribers.attach(*this, {
+                EVT_STATUS_CHANGED,
+                EVT_PAIRING_REQUEST,
+                EVT_REQUEST_FAILED,
+                EVT_CONNECTION_REQUEST,
+                EVT_PLAYBACK_REQUEST,
+                EVT_PLAYBACK_STARTED, // shared by all onPlaybackChange actions
+                EVT_PLAYBACK_POSITION,
+                EVT_PLAYBACK_NEW_TRACK,
+                EVT_DEVICE_FOUND,
+                EVT_DEVICE_LOST_OR_OUT_OF_RANGE,
+                EVT_DEVICE_DISCOVERY_UPDATE,
+                EVT_DISCOVERED_DEVICES,
+                EVT_DEVICE_MEDIA_STATUS,
+                EVT_DEVICE_MATCHED,
+                EVT_OPERATION_COMPLETE
+            });
+
+            Config config;
+            config.FromString(service->ConfigLine());
+
+            m_playbackProgressCoalescer.setInterval(config.PlaybackProgressInterval.Value());
+            m_discoveryBatcher.setLimits(config.DiscoveryBatchWindow.Value(), config.DiscoveryBatchSize.Value());
+            std::vector<DiscoveredDeviceUpdate> evicted; // the index is empty until the first discovery update
+            m_discoveryIndex.setLimits(config.DiscoveryTtl.Value(), config.DiscoveryIndexSize.Value(), evicted);
+            m_eventJournal.setCapacity(config.EventReplaySize.Value());
+            m_connectionDebouncer.setSettleTime(config.ConnectionSettleTime.Value());
+            m_deviceRegistryInterval = config.DeviceRegistryInterval.Value();
+            m_batchExecutor.start(config.BatchWorkers.Value());
+            m_operationExecutor.start(config.OperationWorkers.Value(), [this](const BluetoothOperationExecutor::Job& job) { notifyOperationComplete(job); });
+
             Utils::IARM::init();
 
+            if (Core::ERROR_NONE != m_eventQueue.start(config.EventQueueDepth.Value(),
+                    [this](BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs) { notifyEventWrapper(eventMsg, ingressUs); })) {
+                LOGWARN("Failed to start the event queue, BTRMGR events are notified from the callback thread");
+            }
+
             BTRMGR_Result_t rc = BTRMGR_RegisterForCallbacks(Utils::IARM::NAME);
             if (BTRMGR_RESULT_SUCCESS != rc)
             {
@@ -273,6 +409,14 @@ namespace WPEFramework
                 return message;
             }
 
+            if (0 != m_deviceRegistryInterval) {
+                uint32_t mismatches = 0;
+                if (!reconcileDeviceRegistry(mismatches)) {
+                    LOGWARN("Device registry not seeded, device lists are read from BTRMGR until the next reconciliation");
+                }
+                _eventTimer.Schedule(Core::Time::Now().Add(m_deviceRegistryInterval), m_deviceRegistryTimer);
+            }
+
             disconnectExternallyConnectedDevices();
 
             return message;
@@ -280,19 +424,93 @@ namespace WPEFramework
 
         void Bluetooth::Deinitialize(PluginHost::IShell* service)
         {
+            // Stop taking BTRMGR events before stopping the dispatcher, so that no event is notified
+            // inline and re-arms the timers revoked below.
+            Bluetooth::_instance = nullptr;
+
+            BTRMGR_Result_t rc = BTRMGR_UnRegisterFromCallbacks(Utils::IARM::NAME);
+            if (BTRMGR_RESULT_SUCCESS != rc)
+            {
+                LOGWARN("Failed to UnRegister BTRMgr...!");
+            }
+
+            // Stop the dispatcher so no queued event races with the teardown below. Events still
+            // queued are dropped; stop() returns once no callback is inside push().
+            m_eventQueue.stop();
+
+            m_playbackProgressTimer.Revoke();
+            m_playbackProgressTimer.Lock();
+            m_playbackProgressCoalescer.clear();
+            m_playbackProgressTimer.Unlock();
+
+            _eventTimer.Revoke(m_backgroundDiscoveryTimer);
+            m_backgroundDiscoveryLock.Lock();
+            m_backgroundDiscoveryEnabled = false;
+            m_backgroundDiscoveryTicks = 0;
+            m_discoveryDutyCycle.reset();
+            m_backgroundDiscoveryLock.Unlock();
+
+            _discoveryTimer.Revoke(m_discoveryTimer);
+            m_discoveryLock.Lock();
+            m_discoverySessions.clear();
+            m_discoveryMatcher.clear();
+            m_discoveryTimerTicks = 0;
+            m_discoveryLock.Unlock();
+
+            m_discoveryBatchTimer.Revoke();
+            m_discoveryBatchTimer.Lock();
+            m_discoveryBatcher.clear();
+            m_discoveryBatchTimer.Unlock();
+
+            m_discoveryIndexTimer.Revoke();
+            m_discoveryIndexTimer.Lock();
+            m_discoveryIndex.clear();
+            m_discoveryIndexTimer.Unlock();
+
+            m_connectionSettleTimer.Revoke();
+            m_connectionSettleTimer.Lock();
+            m_connectionDebouncer.clear();
+            m_connectionSettleTimer.Unlock();
+
+            _eventTimer.Revoke(m_deviceRegistryTimer);
+            m_deviceRegistryLock.Lock();
+            m_deviceRegistry.clear();
+            m_deviceRegistryLock.Unlock();
+
+            m_batchExecutor.stop();
+            m_operationExecutor.stop();
+
+            m_eventSubscribers.detach(*this);
+
+            m_eventJournalLock.Lock();
+            m_eventJournal.clear();
+            m_eventJournalLock.Unlock();
+
             m_bluetoothDeviceManager.deinit();
 
             if (m_powerManagerPlugin) {
                 m_powerManagerPlugin->Unregister(&m_powerManagerNotification);
                 m_powerManagerPlugin.Reset();
             }
+        }
 
-            Bluetooth::_instance = nullptr;
-
-            BTRMGR_Result_t rc = BTRMGR_UnRegisterFromCallbacks(Utils::IARM::NAME);
-            if (BTRMGR_RESULT_SUCCESS != rc)
-            {
-                LOGWARN("Failed to UnRegister BTRMgr...!");
+        void Bluetooth::queueEvent(const BTRMGR_EventMessage_t &eventMsg, uint64_t ingressUs)
+        {
+            const BluetoothEventQueue::Lane lane = eventLane(eventMsg.m_eventType);
+            const Core::hresult result = m_eventQueue.push(eventMsg, ingressUs, lane);
+            if (Core::ERROR_UNAVAILABLE == result) {
+                // Also the case of a callback that was already running when Deinitialize started;
+                // drop its event rather than notify it into the teardown.
+                if (this != Bluetooth::_instance) {
+                    LOGWARN("Bluetooth is shutting down, event of type %d dropped", eventMsg.m_eventType);
+                    return;
+                }
+                BTRMGR_EventMessage_t inlineEventMsg = eventMsg;
+                notifyEventWrapper(inlineEventMsg, ingressUs);
+            } else if (Core::ERROR_NONE != result) {
+                LOGWARN("Event queue %s lane full (depth %u), dropped event of type %d; dropped=%llu",
+                    BluetoothEventQueue::laneName(lane), m_eventQueue.depth(), eventMsg.m_eventType,
+                    static_cast<unsigned long long>(m_eventQueue.dropped(lane)));
             }
         }
 
@@ -354,87 +572,176 @@ namespace WPEFramework
             return result;
         }
 
-        string Bluetooth::startDeviceDiscovery(int timeout, const string &discProfile)
+        string Bluetooth::startDeviceDiscovery(int timeout, BluetoothDiscoverySessions::SessionId& sessionId, const string &discProfile,
+                                               const BluetoothDiscoveryMatcher::Target* target)
+        {
+            return openDiscoverySession(bluetoothDiscoveryOperationType(bluetoothDiscoveryProfiles(discProfile)), (timeout > 0) ? (static_cast<uint64_t>(timeout) * 1000) : 0, sessionId, target);
+        }
+
+        string Bluetooth::openDiscoverySession(BTRMGR_DeviceOperationType_t lenDevOpDiscType, uint64_t timeoutMs, BluetoothDiscoverySessions::SessionId& sessionId,
+                                               const BluetoothDiscoveryMatcher::Target* target)
         {
             BTRMGR_Result_t rc = BTRMGR_RESULT_SUCCESS;
             unsigned char numOfAdapters = 0;
 
+            sessionId = 0;
+
+            m_discoveryLock.Lock();
             if (!m_discoveryRunning)
             {
                 rc = BTRMGR_GetNumberOfAdapters(&numOfAdapters);
                 if (BTRMGR_RESULT_SUCCESS != rc)
                     LOGERR("Failed to get the number of adapters..!");
-                if (numOfAdapters) {
-     		    BTRMGR_DeviceOperationType_t lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_UNKNOWN;
-                    if ((Utils::String::contains(discProfile, "LOUDSPEAKER") ||
-                        Utils::String::contains(discProfile, "HEADPHONES") ||
-                        Utils::String::contains(discProfile, "WEARABLE HEADSET") ||
-			Utils::String::contains(discProfile, "HIFI AUDIO DEVICE")) &&
-                        (Utils::String::contains(discProfile, "KEYBOARD") ||
-			Utils::String::contains(discProfile, "MOUSE") ||
-			Utils::String::contains(discProfile, "JOYSTICK"))) {
-			    lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID;
-			}
-		     else if (Utils::String::contains(discProfile, "LOUDSPEAKER") ||
-			     Utils::String::contains(discProfile, "HEADPHONES") ||
-			     Utils::String::contains(discProfile, "WEARABLE HEADSET") ||
-			     Utils::String::contains(discProfile, "HIFI AUDIO DEVICE")) {
-                        lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
-                    }
-                    else if (Utils::String::contains(discProfile, "SMARTPHONE") ||
-                             Utils::String::contains(discProfile, "TABLET")) {
-                        lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT;
-                    }
-                    else if (Utils::String::contains(discProfile, "KEYBOARD") ||
-                             Utils::String::contains(discProfile, "MOUSE") ||
-                             Utils::String::contains(discProfile, "JOYSTICK")) {
-                        lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_HID;
-                    }
-                    else if (Utils::String::contains(discProfile, "LE TILE") ||
-                             Utils::String::contains(discProfile, "LE")) {
-                        lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_LE;
-                    }
-                    else if (Utils::String::contains(discProfile, "DEFAULT")) {
-                        lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_UNKNOWN;
-                    }
+                if (!numOfAdapters) {
+                    m_discoveryLock.Unlock();
+                    return STATUS_NO_BLUETOOTH_HARDWARE;
+                }
+            }
 
-                    rc = BTRMGR_StartDeviceDiscovery(0, lenDevOpDiscType);
-                    if (BTRMGR_RESULT_SUCCESS != rc)
-                    {
-                        LOGERR("Failed to start the discovery..!");
-                    } else {
-                        LOGWARN("Started discovery..!");
-                    }
+            sessionId = m_discoverySessions.open(lenDevOpDiscType, monotonicTimeMs() + timeoutMs);
+            const BTRMGR_DeviceOperationType_t mergedType = m_discoverySessions.mergedType();
+            if (m_discoveryRunning && BluetoothDiscoverySessions::covers(m_discoveryType, mergedType))
+            {
+                LOGINFO("Discovery is in progress, session %u joined it", sessionId);
+            }
+            else
+            {
+                if (m_discoveryRunning)
+                {
+                    // BTRMGR runs one discovery at a time, restart it for the union of the sessions.
+                    LOGINFO("Widening the discovery in progress for session %u", sessionId);
+                    endDeviceDiscovery();
+                }
 
-                    /* Set the discovery flag */
-                    m_discoveryRunning = true;
-                    if (timeout <= 0)
-                    {
-                        stopDeviceDiscovery();
-                    }
-                    else
-                    {
-                        startDiscoveryTimer(timeout * 1000);
-                    }
+                rc = BTRMGR_StartDeviceDiscovery(0, mergedType);
+                if (BTRMGR_RESULT_SUCCESS != rc)
+                {
+                    // Nothing runs for later sessions to join; the next one starts the discovery again.
+                    LOGERR("Failed to start the discovery..!");
+                    m_discoverySessions.close(sessionId);
+                    sessionId = 0;
+                    m_discoveryLock.Unlock();
+                    return STATUS_DISCOVERY_FAILED;
+                }
+                LOGWARN("Started discovery..!");
+
+                /* Set the discovery flag */
+                m_discoveryRunning = true;
+                m_discoveryType = mergedType;
+                m_discoveryStartedMs = monotonicTimeMs();
+            }
+
+            if (0 == timeoutMs)
+            {
+                m_discoverySessions.close(sessionId);
+                sessionId = 0;
+                if (m_discoverySessions.empty())
+                {
+                    endDeviceDiscovery();
                 }
-                else
-                    return STATUS_NO_BLUETOOTH_HARDWARE;
             }
             else
-                LOGWARN ("Discovery is in progress..!");
+            {
+                if (nullptr != target)
+                {
+                    m_discoveryMatcher.add(sessionId, *target);
+                }
+                scheduleDiscoveryTimer();
+            }
+            m_discoveryLock.Unlock();
 
             return STATUS_AVAILABLE;
         }
 
         bool Bluetooth::stopDeviceDiscovery()
+        {
+            m_discoveryLock.Lock();
+            m_discoverySessions.clear();
+            m_discoveryMatcher.clear();
+            m_discoveryTimerTicks = 0;
+            const bool result = endDeviceDiscovery();
+            m_discoveryLock.Unlock();
+            return result;
+        }
+
+        bool Bluetooth::releaseDiscoverySession(BluetoothDiscoverySessions::SessionId sessionId)
+        {
+            bool result = true;
+
+            m_discoveryLock.Lock();
+            if (!m_discoverySessions.close(sessionId))
+            {
+                LOGERR("Discovery session %u is unknown or already ended", sessionId);
+                result = false;
+            }
+            else
+            {
+                m_discoveryMatcher.remove(sessionId);
+                if (m_discoverySessions.empty())
+                {
+                    m_discoveryTimerTicks = 0;
+                    result = endDeviceDiscovery();
+                }
+                else
+                {
+                    LOGINFO("Discovery session %u ended, %zu still running", sessionId, m_discoverySessions.size());
+                }
+            }
+            m_discoveryLock.Unlock();
+
+            return result;
+        }
+
+        void Bluetooth::matchDiscoveredDevice(const RegisteredDevice& device, const char* address)
+        {
+            std::vector<BluetoothDiscoverySessions::SessionId> matched;
+
+            m_discoveryLock.Lock();
+            if (!m_discoveryMatcher.empty())
+            {
+                m_discoveryMatcher.match(device, address, matched);
+                for (const BluetoothDiscoverySessions::SessionId sessionId : matched)
+                {
+                    m_discoverySessions.close(sessionId);
+                    LOGINFO("Discovery session %u found device %llu", sessionId, static_cast<unsigned long long>(device.deviceHandle));
+                }
+                // No need to scan on until the timeout when nobody else waits for devices.
+                if (!matched.empty() && m_discoverySessions.empty())
+                {
+                    m_discoveryTimerTicks = 0;
+                    endDeviceDiscovery();
+                }
+            }
+            m_discoveryLock.Unlock();
+
+            if (matched.empty()) {
+                return;
+            }
+            const bool replay = m_eventJournal.enabled();
+            if (!replay && !hasSubscribers(EVT_DEVICE_MATCHED)) {
+                return;
+            }
+
+            const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(device.deviceType);
+            for (const BluetoothDiscoverySessions::SessionId sessionId : matched) {
+                JsonObject params;
+                params["sessionID"] = sessionId;
+                params["deviceID"] = std::to_string(device.deviceHandle);
+                params["name"] = device.name;
+                params["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                params["address"] = string(address);
+                params["paired"] = device.paired;
+                publishEvent(EVT_DEVICE_MATCHED, params, replay);
+            }
+        }
+
+        bool Bluetooth::endDeviceDiscovery()
         {
             BTRMGR_Result_t rc = BTRMGR_RESULT_GENERIC_FAILURE;
 
             if (m_discoveryRunning)
             {
-                stopDiscoveryTimer();
-
-                rc = BTRMGR_StopDeviceDiscovery(0, BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT);
+                rc = BTRMGR_StopDeviceDiscovery(0, m_discoveryType);
                 if (BTRMGR_RESULT_SUCCESS != rc)
                 {
                     LOGERR("Failed to stop the discovery..!");
@@ -443,182 +750,459 @@ namespace WPEFramework
                 }
 
                 m_discoveryRunning = false;
+                m_discoveryScanningMs += monotonicTimeMs() - m_discoveryStartedMs;
             }
 
             return BTRMGR_RESULT_SUCCESS == rc;
         }
 
-        void Bluetooth::startDiscoveryTimer(int msec)
+        void Bluetooth::scheduleDiscoveryTimer()
         {
-            stopDiscoveryTimer();
-            _discoveryTimer.Schedule(Core::Time::Now().Add(msec), m_discoveryTimer);
+            const uint64_t deadlineMs = m_discoverySessions.nextDeadline();
+            if (0 == deadlineMs) {
+                return;
+            }
+
+            const uint64_t nowMs = monotonicTimeMs();
+            const Core::Time due = Core::Time::Now().Add(static_cast<uint32_t>((deadlineMs > nowMs) ? (deadlineMs - nowMs) : 0));
+            // Only an earlier deadline needs a new timer, the pending one covers later ones.
+            if ((0 == m_discoveryTimerTicks) || (due.Ticks() < m_discoveryTimerTicks)) {
+                m_discoveryTimerTicks = due.Ticks();
+                _discoveryTimer.Schedule(due, m_discoveryTimer);
+            }
         }
 
-        void Bluetooth::stopDiscoveryTimer()
+        uint64_t Bluetooth::onDiscoveryTimer(uint64_t scheduledTime)
         {
-            _discoveryTimer.Revoke(m_discoveryTimer);
+            uint64_t result = 0;
+
+            m_discoveryLock.Lock();
+            if (scheduledTime == m_discoveryTimerTicks)
+            {
+                m_discoveryTimerTicks = 0;
+                const uint64_t nowMs = monotonicTimeMs();
+                std::vector<BluetoothDiscoverySessions::SessionId> expired;
+                m_discoverySessions.expire(nowMs, &expired);
+                for (const BluetoothDiscoverySessions::SessionId sessionId : expired)
+                {
+                    m_discoveryMatcher.remove(sessionId);
+                }
+                if (m_discoverySessions.empty())
+                {
+                    endDeviceDiscovery();
+                }
+                else
+                {
+                    const uint64_t deadlineMs = m_discoverySessions.nextDeadline();
+                    result = Core::Time::Now().Add(static_cast<uint32_t>((deadlineMs > nowMs) ? (deadlineMs - nowMs) : 0)).Ticks();
+                    m_discoveryTimerTicks = result;
+                }
+            }
+            m_discoveryLock.Unlock();
+
+            return result;
         }
 
-        void Bluetooth::onDiscoveryTimer()
+        void Bluetooth::encodeStoredDeviceFields(BTRMgrDeviceHandle deviceHandle, JsonObject& deviceDetails)
         {
-            stopDeviceDiscovery();
+            string lastConnectTimeUtc;
+            Core::hresult result = m_bluetoothDeviceManager.getLastConnectTimeUtc(deviceHandle, lastConnectTimeUtc);
+
+            if (Core::ERROR_NONE == result && !lastConnectTimeUtc.empty()) {
+                deviceDetails["lastConnectTimeUtc"] = lastConnectTimeUtc;
+            }
+
+            AutoConnectStatus autoConnectStatus;
+            result = m_bluetoothDeviceManager.getAutoConnect(deviceHandle, autoConnectStatus);
+
+            if (Core::ERROR_NONE == result && AUTO_CONNECT_STATUS_UNSET != autoConnectStatus) {
+                deviceDetails["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus);
+            }
         }
 
-        JsonArray Bluetooth::getDiscoveredDevices()
+        bool Bluetooth::registeredDevices(BluetoothDeviceRegistry::List list, std::vector<RegisteredDevice>& devices)
         {
-            JsonArray deviceArray;
-            BTRMGR_DiscoveredDevicesList_t *discoveredDevices = (BTRMGR_DiscoveredDevicesList_t*)malloc(sizeof(BTRMGR_DiscoveredDevicesList_t));
-            if(discoveredDevices == nullptr)
-            {
+            if (0 == m_deviceRegistryInterval) {
+                return false;
+            }
+
+            m_deviceRegistryLock.Lock();
+            const bool seeded = m_deviceRegistry.seeded(list);
+            if (seeded) {
+                m_deviceRegistry.devices(list, devices);
+            }
+            m_deviceRegistryLock.Unlock();
+            return seeded;
+        }
+
+        bool Bluetooth::reconcileDeviceRegistry(uint32_t& mismatches)
+        {
+            mismatches = 0;
+
+            auto discoveredDevices = BluetoothListBuffers::discovered().acquire();
+            auto pairedDevices = BluetoothListBuffers::paired().acquire();
+            auto connectedDevices = BluetoothListBuffers::connected().acquire();
+            if (!discoveredDevices || !pairedDevices || !connectedDevices) {
                 LOGERR("Failed to allocate memory");
-                return deviceArray;
+                return false;
             }
 
-            memset (discoveredDevices, 0, sizeof(BTRMGR_DiscoveredDevicesList_t));
-            BTRMGR_Result_t rc = BTRMGR_GetDiscoveredDevices(0, discoveredDevices);
-            if (BTRMGR_RESULT_SUCCESS != rc)
-            {
-                LOGERR("Failed to get the discovered devices");
+            m_deviceRegistryLock.Lock();
+            const uint64_t applied = m_deviceRegistry.applied();
+            m_deviceRegistryLock.Unlock();
+
+            const bool discoveredRead = (BTRMGR_RESULT_SUCCESS == BTRMGR_GetDiscoveredDevices(0, discoveredDevices.get()));
+            const bool pairedRead = (BTRMGR_RESULT_SUCCESS == BTRMGR_GetPairedDevices(0, pairedDevices.get()));
+            const bool connectedRead = (BTRMGR_RESULT_SUCCESS == BTRMGR_GetConnectedDevices(0, connectedDevices.get()));
+            if (!discoveredRead || !pairedRead || !connectedRead) {
+                LOGERR("Failed to read the device lists (discovered=%d paired=%d connected=%d)", discoveredRead, pairedRead, connectedRead);
             }
-            else
-            {
-                int i = 0;
-                JsonObject deviceDetails;
-                LOGINFO ("Success....   Discovered %d Devices", discoveredDevices->m_numOfDevices);
-                for (; i < discoveredDevices->m_numOfDevices; i++)
-                {
-                    deviceDetails["deviceID"] = std::to_string(discoveredDevices->m_deviceProperty[i].m_deviceHandle);
-                    deviceDetails["name"] = string(discoveredDevices->m_deviceProperty[i].m_name);
-                    const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(discoveredDevices->m_deviceProperty[i].m_deviceType);
-                    deviceDetails["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
-                    deviceDetails["connected"] = discoveredDevices->m_deviceProperty[i].m_isConnected?true:false;
-                    deviceDetails["paired"] = discoveredDevices->m_deviceProperty[i].m_isPairedDevice?true:false;
-                    deviceDetails["rawDeviceType"] = std::to_string(discoveredDevices->m_deviceProperty[i].m_ui32DevClassBtSpec);
-                    deviceDetails["rawBleDeviceType"] = std::to_string(discoveredDevices->m_deviceProperty[i].m_ui16DevAppearanceBleSpec);
-                    deviceArray.Add(deviceDetails);
+
+            m_deviceRegistryLock.Lock();
+            // An event applied meanwhile may be newer than the lists read, retry on the next pass.
+            const bool raced = (m_deviceRegistry.applied() != applied);
+            if (!raced) {
+                if (discoveredRead) {
+                    mismatches += m_deviceRegistry.syncDiscovered(*discoveredDevices, monotonicTimeMs());
+                }
+                if (pairedRead) {
+                    mismatches += m_deviceRegistry.syncPaired(*pairedDevices);
+                }
+                if (connectedRead) {
+                    mismatches += m_deviceRegistry.syncConnected(*connectedDevices);
                 }
             }
+            m_deviceRegistryLock.Unlock();
 
-            free(discoveredDevices);
-            return deviceArray;
+            if (raced) {
+                LOGINFO("Device registry reconciliation skipped, events arrived while the lists were read");
+                return false;
+            }
+            if (0 != mismatches) {
+                LOGWARN("Device registry reconciliation corrected %u devices", mismatches);
+            }
+            return discoveredRead && pairedRead && connectedRead;
         }
 
-        JsonArray Bluetooth::getPairedDevices()
+        bool Bluetooth::getDeviceSnapshot(JsonArray& deviceArray)
         {
-            JsonArray deviceArray;
-            BTRMGR_PairedDevicesList_t *pairedDevices = (BTRMGR_PairedDevicesList_t*)malloc(sizeof(BTRMGR_PairedDevicesList_t));
-            if(pairedDevices == nullptr)
-            {
-                LOGERR("Failed to allocate memory");
-                return deviceArray;
+            std::vector<RegisteredDevice> devices;
+            bool registered = false;
+            if (0 != m_deviceRegistryInterval) {
+                m_deviceRegistryLock.Lock();
+                registered = m_deviceRegistry.seeded(BluetoothDeviceRegistry::LIST_DISCOVERED) &&
+                             m_deviceRegistry.seeded(BluetoothDeviceRegistry::LIST_PAIRED) &&
+                             m_deviceRegistry.seeded(BluetoothDeviceRegistry::LIST_CONNECTED);
+                if (registered) {
+                    m_deviceRegistry.devices(devices);
+                }
+                m_deviceRegistryLock.Unlock();
             }
 
-            memset (pairedDevices, 0, sizeof(BTRMGR_PairedDevicesList_t));
-            BTRMGR_Result_t rc = BTRMGR_GetPairedDevices(0, pairedDevices);
-            if (BTRMGR_RESULT_SUCCESS != rc)
-            {
-                LOGERR("Failed to get the paired devices");
+            if (!registered) {
+                auto discoveredDevices = BluetoothListBuffers::discovered().acquire();
+                auto pairedDevices = BluetoothListBuffers::paired().acquire();
+                auto connectedDevices = BluetoothListBuffers::connected().acquire();
+                if (!discoveredDevices || !pairedDevices || !connectedDevices) {
+                    LOGERR("Failed to allocate memory");
+                    return false;
+                }
+                if ((BTRMGR_RESULT_SUCCESS != BTRMGR_GetDiscoveredDevices(0, discoveredDevices.get())) ||
+                    (BTRMGR_RESULT_SUCCESS != BTRMGR_GetPairedDevices(0, pairedDevices.get())) ||
+                    (BTRMGR_RESULT_SUCCESS != BTRMGR_GetConnectedDevices(0, connectedDevices.get()))) {
+                    LOGERR("Failed to get the device lists");
+                    return false;
+                }
+
+                // Merged by handle the same way the device registry merges them.
+                BluetoothDeviceRegistry lists;
+                lists.syncDiscovered(*discoveredDevices, monotonicTimeMs());
+                lists.syncPaired(*pairedDevices);
+                lists.syncConnected(*connectedDevices);
+                lists.devices(devices);
             }
-            else
-            {
-                int i = 0;
-                LOGINFO ("Success....   Paired %d Devices", pairedDevices->m_numOfDevices);
-                for (; i < pairedDevices->m_numOfDevices; i++)
+
+            const BluetoothDeviceInfoMap deviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
+            for (const RegisteredDevice& device : devices) {
+                JsonObject deviceDetails;
+                const string deviceId = std::to_string(device.deviceHandle);
+                deviceDetails["deviceID"] = deviceId;
+                deviceDetails["name"] = device.name;
+                const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(device.deviceType);
+                deviceDetails["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                deviceDetails["rawDeviceType"] = std::to_string(device.rawDeviceType);
+                deviceDetails["rawBleDeviceType"] = std::to_string(device.rawBleDeviceType);
+                deviceDetails["discovered"] = device.discovered;
+                deviceDetails["paired"] = device.paired;
+                deviceDetails["connected"] = device.connected;
+                if (device.connected) {
+                    deviceDetails["activeState"] = std::to_string(device.powerStatus);
+                }
+
+                auto info = deviceInfos.find(device.deviceHandle);
+                if (info != deviceInfos.end()) {
+                    if (AUTO_CONNECT_STATUS_UNSET != info->second.autoConnectStatus) {
+                        deviceDetails["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == info->second.autoConnectStatus);
+                    }
+                    if (!info->second.lastConnectTimeUtc.empty()) {
+                        deviceDetails["lastConnectTimeUtc"] = info->second.lastConnectTimeUtc;
+                    }
+                    deviceDetails["lastVolumeSetting"] = info->second.lastVolumeSetting;
+                }
+                deviceArray.Add(deviceDetails);
+            }
+            return true;
+        }
+
+        JsonArray Bluetooth::getDiscoveredDevices(const BluetoothDeviceQuery& query, uint32_t* total)
+        {
+            JsonArray deviceArray;
+            if (nullptr != total) {
+                *total = 0;
+            }
+
+            std::vector<RegisteredDevice> devices;
+            if (!registeredDevices(BluetoothDeviceRegistry::LIST_DISCOVERED, devices)) {
+                auto discoveredDevices = BluetoothListBuffers::discovered().acquire();
+                if (!discoveredDevices)
                 {
-                    JsonObject deviceDetails;
+                    LOGERR("Failed to allocate memory");
+                    return deviceArray;
+                }
 
-                    string deviceId = std::to_string(pairedDevices->m_deviceProperty[i].m_deviceHandle);
+                BTRMGR_Result_t rc = BTRMGR_GetDiscoveredDevices(0, discoveredDevices.get());
+                if (BTRMGR_RESULT_SUCCESS != rc)
+                {
+                    LOGERR("Failed to get the discovered devices");
+                    return deviceArray;
+                }
 
-                    deviceDetails["deviceID"] = deviceId;
-                    deviceDetails["name"] = string(pairedDevices->m_deviceProperty[i].m_name);
-                    const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(pairedDevices->m_deviceProperty[i].m_deviceType);
-                    deviceDetails["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
-                    deviceDetails["connected"] = pairedDevices->m_deviceProperty[i].m_isConnected?true:false;
-		            deviceDetails["rawDeviceType"] = std::to_string(pairedDevices->m_deviceProperty[i].m_ui32DevClassBtSpec);
-		            deviceDetails["rawBleDeviceType"] = std::to_string(pairedDevices->m_deviceProperty[i].m_ui16DevAppearanceBleSpec);
-                    
-                    string lastConnectTimeUtc;
-                    Core::hresult result = m_bluetoothDeviceManager.getLastConnectTimeUtc(deviceId, lastConnectTimeUtc);
+                LOGINFO ("Success....   Discovered %d Devices", discoveredDevices->m_numOfDevices);
+                devices.reserve(discoveredDevices->m_numOfDevices);
+                for (int i = 0; i < discoveredDevices->m_numOfDevices; i++)
+                {
+                    const BTRMGR_DiscoveredDevices_t& source = discoveredDevices->m_deviceProperty[i];
+                    RegisteredDevice device;
+                    device.deviceHandle = source.m_deviceHandle;
+                    device.name = string(source.m_name);
+                    device.deviceType = source.m_deviceType;
+                    device.rawDeviceType = source.m_ui32DevClassBtSpec;
+                    device.rawBleDeviceType = source.m_ui16DevAppearanceBleSpec;
+                    device.discovered = true;
+                    device.paired = source.m_isPairedDevice ? true : false;
+                    device.connected = source.m_isConnected ? true : false;
+                    devices.push_back(std::move(device));
+                }
+            }
 
-                    if (Core::ERROR_NONE == result && !lastConnectTimeUtc.empty()) {
-                        deviceDetails["lastConnectTimeUtc"] = lastConnectTimeUtc;
-                    }
+            filterDiscoveryIndex(devices);
+
+            // Filtered and paged before encoding, devices left out are never serialized.
+            const uint32_t matched = query.apply(devices);
+            if (nullptr != total) {
+                *total = matched;
+            }
 
-                    AutoConnectStatus autoConnectStatus;
-                    result = m_bluetoothDeviceManager.getAutoConnect(deviceId, autoConnectStatus);
+            for (const RegisteredDevice& device : devices) {
+                JsonObject deviceDetails;
+                deviceDetails["deviceID"] = std::to_string(device.deviceHandle);
+                deviceDetails["name"] = device.name;
+                const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(device.deviceType);
+                deviceDetails["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                deviceDetails["connected"] = device.connected;
+                deviceDetails["paired"] = device.paired;
+                deviceDetails["rawDeviceType"] = std::to_string(device.rawDeviceType);
+                deviceDetails["rawBleDeviceType"] = std::to_string(device.rawBleDeviceType);
+                deviceArray.Add(deviceDetails);
+            }
+            return deviceArray;
+        }
 
-                    if (Core::ERROR_NONE == result && AUTO_CONNECT_STATUS_UNSET != autoConnectStatus) {
-                        deviceDetails["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus);
+        bool Bluetooth::parseDeviceQuery(const JsonObject& parameters, BluetoothDeviceQuery& query)
+        {
+            if (parameters.HasLabel("deviceTypes")) {
+                const JsonArray deviceTypes = parameters["deviceTypes"].Array();
+                query.restrictDeviceTypes();
+                for (uint16_t i = 0; i < deviceTypes.Length(); i++) {
+                    const string requested = deviceTypes[i].String();
+                    bool known = false;
+                    // Several BTRMGR types can share a name, all of them are matched.
+                    for (int type = BTRMGR_DEVICE_TYPE_UNKNOWN; type < BTRMGR_DEVICE_TYPE_END; type++) {
+                        const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(static_cast<BTRMGR_DeviceType_t>(type));
+                        if ((nullptr != deviceTypeStr) && (requested == deviceTypeStr)) {
+                            query.addDeviceType(static_cast<BTRMGR_DeviceType_t>(type));
+                            known = true;
+                        }
+                    }
+                    if (!known) {
+                        LOGWARN("Unknown device type '%s' matches no device", requested.c_str());
                     }
+                }
+            }
+            if (parameters.HasLabel("paired")) {
+                bool paired = false;
+                getBoolParameter("paired", paired);
+                query.setPaired(paired);
+            }
+            if (parameters.HasLabel("name")) {
+                query.setName(parameters["name"].String());
+            }
+            if (parameters.HasLabel("offset")) {
+                uint32_t offset = 0;
+                getNumberParameter("offset", offset);
+                query.setOffset(offset);
+            }
+            if (parameters.HasLabel("limit")) {
+                uint32_t limit = 0;
+                getNumberParameter("limit", limit);
+                query.setLimit(limit);
+            }
+            if (parameters.HasLabel("sortBy")) {
+                const string sortBy = parameters["sortBy"].String();
+                if ("lastSeen" == sortBy) {
+                    query.setSort(BluetoothDeviceQuery::SORT_LAST_SEEN);
+                } else if ("none" != sortBy) {
+                    LOGERR("Unsupported sortBy '%s', expected \"lastSeen\" or \"none\"", sortBy.c_str());
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool Bluetooth::checkProfiles(const string& profileList, JsonObject& response)
+        {
+            std::vector<std::string> unknown;
+            (void)bluetoothDiscoveryProfiles(profileList, &unknown);
+            if (unknown.empty()) {
+                return true;
+            }
+
+            JsonArray unknownProfiles;
+            for (const std::string& name : unknown) {
+                unknownProfiles.Add(name);
+            }
+            response["unknownProfiles"] = unknownProfiles;
+            return false;
+        }
 
-                    deviceArray.Add(deviceDetails);
+        bool Bluetooth::parseDiscoveryTarget(const JsonObject& parameters, BluetoothDiscoveryMatcher::Target& target)
+        {
+            if (parameters.HasLabel("offset") || parameters.HasLabel("limit") || parameters.HasLabel("sortBy")) {
+                LOGERR("\"match\" takes address, name, deviceTypes and paired only");
+                return false;
+            }
+            if (!parseDeviceQuery(parameters, target.query)) {
+                return false;
+            }
+            if (parameters.HasLabel("address")) {
+                target.addressPrefix = BluetoothDiscoveryMatcher::addressDigits(parameters["address"].String());
+                if (target.addressPrefix.empty()) {
+                    LOGERR("\"address\" holds no hex digits");
+                    return false;
                 }
             }
-            free(pairedDevices);
-            return deviceArray;
+            if (target.query.empty() && target.addressPrefix.empty()) {
+                LOGERR("\"match\" needs at least one of address, name, deviceTypes or paired");
+                return false;
+            }
+            return true;
         }
 
-        JsonArray Bluetooth::getConnectedDevices()
+        bool Bluetooth::readDeviceList(BluetoothDeviceRegistry::List list, std::vector<RegisteredDevice>& devices)
         {
-            JsonArray deviceArray;
-            BTRMGR_ConnectedDevicesList_t *connectedDevices = (BTRMGR_ConnectedDevicesList_t*)malloc(sizeof(BTRMGR_ConnectedDevicesList_t));
-            if(connectedDevices == nullptr)
-            {
-                LOGERR("Failed to allocate memory");
-                return deviceArray;
+            if (BluetoothDeviceRegistry::LIST_PAIRED == list) {
+                auto pairedDevices = BluetoothListBuffers::paired().acquire();
+                if (!pairedDevices) {
+                    LOGERR("Failed to allocate memory");
+                    return false;
+                }
+                if (BTRMGR_RESULT_SUCCESS != BTRMGR_GetPairedDevices(0, pairedDevices.get())) {
+                    LOGERR("Failed to get the paired devices");
+                    return false;
+                }
+                LOGINFO ("Success....   Paired %d Devices", pairedDevices->m_numOfDevices);
+                devices.reserve(devices.size() + pairedDevices->m_numOfDevices);
+                for (int i = 0; i < pairedDevices->m_numOfDevices; i++) {
+                    const BTRMGR_PairedDevices_t& source = pairedDevices->m_deviceProperty[i];
+                    RegisteredDevice device;
+                    device.deviceHandle = source.m_deviceHandle;
+                    device.name = string(source.m_name);
+                    device.deviceType = source.m_deviceType;
+                    device.rawDeviceType = source.m_ui32DevClassBtSpec;
+                    device.rawBleDeviceType = source.m_ui16DevAppearanceBleSpec;
+                    device.paired = true;
+                    device.connected = source.m_isConnected ? true : false;
+                    devices.push_back(std::move(device));
+                }
+                return true;
             }
 
-            memset (connectedDevices, 0, sizeof(BTRMGR_ConnectedDevicesList_t));
-            BTRMGR_Result_t rc = BTRMGR_GetConnectedDevices(0, connectedDevices);
-            if (BTRMGR_RESULT_SUCCESS != rc)
-            {
+            auto connectedDevices = BluetoothListBuffers::connected().acquire();
+            if (!connectedDevices) {
+                LOGERR("Failed to allocate memory");
+                return false;
+            }
+            if (BTRMGR_RESULT_SUCCESS != BTRMGR_GetConnectedDevices(0, connectedDevices.get())) {
                 LOGERR("Failed to get the connected devices");
+                return false;
             }
-            else
-            {
-                int i = 0;
-                LOGINFO ("Success....   Connected %d Devices", connectedDevices->m_numOfDevices);
-                for (; i < connectedDevices->m_numOfDevices; i++)
-                {
-                    JsonObject deviceDetails;
-
-                    string deviceId = std::to_string(connectedDevices->m_deviceProperty[i].m_deviceHandle);
-
-                    deviceDetails["deviceID"] = deviceId;
-                    deviceDetails["name"] = string(connectedDevices->m_deviceProperty[i].m_name);
-                    const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(connectedDevices->m_deviceProperty[i].m_deviceType);
-                    deviceDetails["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
-                    deviceDetails["activeState"] = std::to_string(connectedDevices->m_deviceProperty[i].m_powerStatus);
-		            deviceDetails["rawDeviceType"] = std::to_string(connectedDevices->m_deviceProperty[i].m_ui32DevClassBtSpec);
-		            deviceDetails["rawBleDeviceType"] = std::to_string(connectedDevices->m_deviceProperty[i].m_ui16DevAppearanceBleSpec);
-                    
-                    string lastConnectTimeUtc;
-                    Core::hresult result = m_bluetoothDeviceManager.getLastConnectTimeUtc(deviceId, lastConnectTimeUtc);
-
-                    if (Core::ERROR_NONE == result && !lastConnectTimeUtc.empty()) {
-                        deviceDetails["lastConnectTimeUtc"] = lastConnectTimeUtc;
-                    }
-
-                    AutoConnectStatus autoConnectStatus;
-                    result = m_bluetoothDeviceManager.getAutoConnect(deviceId, autoConnectStatus);
-
-                    if (Core::ERROR_NONE == result && AUTO_CONNECT_STATUS_UNSET != autoConnectStatus) {
-                        deviceDetails["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus);
-                    }
+            LOGINFO ("Success....   Connected %d Devices", connectedDevices->m_numOfDevices);
+            devices.reserve(devices.size() + connectedDevices->m_numOfDevices);
+            for (int i = 0; i < connectedDevices->m_numOfDevices; i++) {
+                const BTRMGR_ConnectedDevice_t& source = connectedDevices->m_deviceProperty[i];
+                RegisteredDevice device;
+                device.deviceHandle = source.m_deviceHandle;
+                device.name = string(source.m_name);
+                device.deviceType = source.m_deviceType;
+                device.rawDeviceType = source.m_ui32DevClassBtSpec;
+                device.rawBleDeviceType = source.m_ui16DevAppearanceBleSpec;
+                device.powerStatus = source.m_powerStatus;
+                device.connected = true;
+                devices.push_back(std::move(device));
+            }
+            return true;
+        }
 
-                    deviceArray.Add(deviceDetails);
+        JsonArray Bluetooth::encodeListedDevices(BluetoothDeviceRegistry::List list, const std::vector<RegisteredDevice>& devices)
+        {
+            JsonArray deviceArray;
+            for (const RegisteredDevice& device : devices) {
+                JsonObject deviceDetails;
+                deviceDetails["deviceID"] = std::to_string(device.deviceHandle);
+                deviceDetails["name"] = device.name;
+                const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(device.deviceType);
+                deviceDetails["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                if (BluetoothDeviceRegistry::LIST_PAIRED == list) {
+                    deviceDetails["connected"] = device.connected;
+                } else {
+                    deviceDetails["activeState"] = std::to_string(device.powerStatus);
                 }
+                deviceDetails["rawDeviceType"] = std::to_string(device.rawDeviceType);
+                deviceDetails["rawBleDeviceType"] = std::to_string(device.rawBleDeviceType);
+                encodeStoredDeviceFields(device.deviceHandle, deviceDetails);
+                deviceArray.Add(deviceDetails);
             }
-            free(connectedDevices);
             return deviceArray;
         }
 
-        bool Bluetooth::setDeviceConnection(long long int deviceID, bool connect, const string &deviceType)
+        void Bluetooth::touchListedDevice(BTRMgrDeviceHandle deviceHandle)
+        {
+            m_deviceRegistryLock.Lock();
+            m_deviceRegistry.touch(deviceHandle);
+            m_deviceRegistryLock.Unlock();
+
+            m_deviceListLock.Lock();
+            m_pairedDeviceList.touch(deviceHandle);
+            m_connectedDeviceList.touch(deviceHandle);
+            m_deviceListLock.Unlock();
+        }
+
+        bool Bluetooth::setDeviceConnection(long long int deviceID, bool connect, BluetoothDeviceCategory category)
         {
             BTRMGR_Result_t rc = BTRMGR_RESULT_SUCCESS;
             BTRMgrDeviceHandle deviceHandle = (BTRMgrDeviceHandle) deviceID;
 
-            if (Utils::String::equal(deviceType, "LE TILE")) {
+            if (BLUETOOTH_DEVICE_CATEGORY_LE == category) {
                 if (connect) {
                     BTRMGR_DeviceOperationType_t stream_pref = BTRMGR_DEVICE_OP_TYPE_LE;
                     rc = BTRMGR_ConnectToDevice(0, deviceHandle, stream_pref);
@@ -626,10 +1210,7 @@ namespace WPEFramework
                     rc = BTRMGR_DisconnectFromDevice(0, deviceHandle);
                 }
             }
-            else if (Utils::String::equal(deviceType, "HUMAN INTERFACE DEVICE") ||
-			 Utils::String::contains(deviceType, "KEYBOARD") ||
-		         Utils::String::contains(deviceType, "MOUSE") ||
-			 Utils::String::contains(deviceType, "JOYSTICK")) {
+            else if (BLUETOOTH_DEVICE_CATEGORY_HID == category) {
                 if (connect) {
                     BTRMGR_DeviceOperationType_t stream_pref = BTRMGR_DEVICE_OP_TYPE_HID;
                     rc = BTRMGR_ConnectToDevice(0, deviceHandle, stream_pref);
@@ -637,7 +1218,7 @@ namespace WPEFramework
                     rc = BTRMGR_DisconnectFromDevice(0, deviceHandle);
                 }
             }
-            else if ((Utils::String::equal(deviceType, "SMARTPHONE")) || (Utils::String::equal(deviceType, "TABLET"))) {
+            else if (BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT == category) {
                 if (connect) {
                     BTRMGR_DeviceOperationType_t stream_pref = BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT;
                     rc = BTRMGR_StartAudioStreamingIn(0, deviceHandle, stream_pref);
@@ -656,7 +1237,8 @@ namespace WPEFramework
 
             if (BTRMGR_RESULT_SUCCESS == rc ) {
                 if (connect) {
-                    m_bluetoothDeviceManager.setLastConnectTimeUtc(std::to_string(deviceHandle));
+                    m_bluetoothDeviceManager.setLastConnectTimeUtc(deviceHandle);
+                    touchListedDevice(deviceHandle);
                 }
             } else {
                 LOGERR("Failed to do setDeviceConnection");
@@ -695,9 +1277,7 @@ namespace WPEFramework
                 return false;
             }
             
-            string deviceId = std::to_string(deviceHandle);
-
-            Core::hresult result = pair ? m_bluetoothDeviceManager.addDevice(deviceId) : m_bluetoothDeviceManager.removeDevice(deviceId);
+            Core::hresult result = pair ? m_bluetoothDeviceManager.addDevice(deviceHandle) : m_bluetoothDeviceManager.removeDevice(deviceHandle);
 
             if (Core::ERROR_NONE == result) {
                 LOGINFO("Successfully done %s ", (pair ? "Pair" : "Unpair"));
@@ -708,6 +1288,42 @@ namespace WPEFramework
             return true;
         }
 
+        bool Bluetooth::runDeviceOperation(const JsonObject& parameters, const string& operation, long long int deviceID,
+                                           const BluetoothOperationExecutor::Operation& run, JsonObject& response)
+        {
+            bool async = false;
+            if (parameters.HasLabel("async")) {
+                getBoolParameter("async", async);
+            }
+            if (!async) {
+                return m_operationExecutor.execute(operation, (BTRMgrDeviceHandle) deviceID, run);
+            }
+
+            const BluetoothOperationExecutor::JobId jobId = m_operationExecutor.submit(operation, (BTRMgrDeviceHandle) deviceID, run);
+            if (0 == jobId) {
+                return false;
+            }
+            response["jobID"] = jobId;
+            return true;
+        }
+
+        void Bluetooth::notifyOperationComplete(const BluetoothOperationExecutor::Job& job)
+        {
+            const bool replay = m_eventJournal.enabled();
+            if (!replay && !hasSubscribers(EVT_OPERATION_COMPLETE)) {
+                return;
+            }
+
+            JsonObject params;
+            params["jobID"] = job.id;
+            params["operation"] = job.operation;
+            params["deviceID"] = std::to_string(job.deviceHandle);
+            params["result"] = BluetoothOperationExecutor::stateName(job.state);
+            params["success"] = (BluetoothOperationExecutor::STATE_SUCCEEDED == job.state);
+            params["durationMs"] = (0 != job.startedMs) ? (job.finishedMs - job.startedMs) : 0;
+            publishEvent(EVT_OPERATION_COMPLETE, params, replay);
+        }
+
         bool Bluetooth::setBluetoothEnabled(const string &enabled)
         {
             BTRMGR_Result_t rc = BTRMGR_RESULT_GENERIC_FAILURE;
@@ -851,57 +1467,33 @@ namespace WPEFramework
             return BTRMGR_RESULT_SUCCESS == rc;
         }
 
-        BTRMGR_DeviceOperationType_t Bluetooth::btmgrDeviceOperationTypeFromString(const string &deviceProfile)
-        {
-             BTRMGR_DeviceOperationType_t lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
-
-             if (Utils::String::contains(deviceProfile, "LOUDSPEAKER") ||
-                 Utils::String::contains(deviceProfile, "HEADPHONES") ||
-                 Utils::String::contains(deviceProfile, "WEARABLE HEADSET") ||
-                 Utils::String::contains(deviceProfile, "HIFI AUDIO DEVICE")) {
-                 lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
-             }
-             else if (Utils::String::contains(deviceProfile, "SMARTPHONE") ||
-                      Utils::String::contains(deviceProfile, "TABLET")) {
-                      lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT;
-             }
-             else if (Utils::String::contains(deviceProfile, "KEYBOARD") ||
-                      Utils::String::contains(deviceProfile, "MOUSE") ||
-                      Utils::String::contains(deviceProfile, "JOYSTICK")) {
-                      lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_HID;
-             }
-             else if (Utils::String::contains(deviceProfile, "LE TILE") ||
-                      Utils::String::contains(deviceProfile, "LE")) {
-                      lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_LE;
-             }
-             else if (Utils::String::contains(deviceProfile, "DEFAULT")) {
-                      lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_UNKNOWN;
-             }
-
-             return lenDevOpDiscType;
-        }
-
         bool Bluetooth::setDeviceVolumeMuteProperties(long long int  deviceID, const string &deviceProfile, unsigned char ui8volume, unsigned char mute)
         {
              BTRMGR_Result_t rc = BTRMGR_RESULT_SUCCESS;
              BTRMgrDeviceHandle deviceHandle = (BTRMgrDeviceHandle) deviceID;
              BTRMGR_DeviceOperationType_t lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
 
-             lenDevOpDiscType = btmgrDeviceOperationTypeFromString(deviceProfile);
+             lenDevOpDiscType = bluetoothDeviceOperationType(bluetoothDiscoveryProfiles(deviceProfile));
              rc = BTRMGR_SetDeviceVolumeMute (0, deviceHandle, lenDevOpDiscType, ui8volume, mute);
              return BTRMGR_RESULT_SUCCESS == rc;
         }
 
         JsonObject Bluetooth::getDeviceVolumeMuteProperties(long long int  deviceID, const string &deviceProfile)
+        {
+            JsonObject volumeInfo;
+            readDeviceVolumeMuteProperties(deviceID, deviceProfile, volumeInfo);
+            return volumeInfo;
+        }
+
+        BTRMGR_Result_t Bluetooth::readDeviceVolumeMuteProperties(long long int deviceID, const string &deviceProfile, JsonObject& volumeInfo)
         {
              BTRMGR_Result_t rc = BTRMGR_RESULT_SUCCESS;
              BTRMgrDeviceHandle deviceHandle = (BTRMgrDeviceHandle) deviceID;
              BTRMGR_DeviceOperationType_t lenDevOpDiscType = BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
              unsigned char ui8volume;
              unsigned char mute;
-             JsonObject volumeInfo;
 
-             lenDevOpDiscType = btmgrDeviceOperationTypeFromString(deviceProfile);
+             lenDevOpDiscType = bluetoothDeviceOperationType(bluetoothDiscoveryProfiles(deviceProfile));
              rc = BTRMGR_GetDeviceVolumeMute (0, deviceHandle, lenDevOpDiscType, &ui8volume, &mute);
              if (BTRMGR_RESULT_SUCCESS != rc) {
                  LOGERR("Failed to get the volume info %d", rc);
@@ -910,7 +1502,59 @@ namespace WPEFramework
 	         volumeInfo ["mute"]   = mute ? true : false ;
 	     }
 
-             return volumeInfo;
+             return rc;
+        }
+
+        bool Bluetooth::lookupDevices(const JsonObject& parameters, const DeviceLookup& lookup, JsonObject& results)
+        {
+            const JsonArray deviceIDs = parameters["deviceIDs"].Array();
+            if (0 == deviceIDs.Length()) {
+                LOGERR("deviceIDs must list at least one device");
+                return false;
+            }
+
+            std::vector<string> ids;
+            ids.reserve(deviceIDs.Length());
+            for (uint16_t i = 0; i < deviceIDs.Length(); i++) {
+                const string id = deviceIDs[i].String();
+                if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+                    ids.push_back(id);
+                }
+            }
+
+            std::vector<JsonObject> lookups(ids.size());
+            std::vector<BTRMGR_Result_t> rcs(ids.size(), BTRMGR_RESULT_SUCCESS);
+            std::vector<bool> valid(ids.size(), false);
+            std::vector<BluetoothBatchExecutor::Task> tasks;
+            tasks.reserve(ids.size());
+            for (size_t i = 0; i < ids.size(); i++) {
+                long long int deviceID = 0;
+                try {
+                    deviceID = stoll(ids[i]);
+                } catch (const std::exception&) {
+                    continue;
+                }
+                valid[i] = true;
+                // Each task only writes its own slot of lookups and rcs.
+                tasks.push_back([&lookup, &lookups, &rcs, deviceID, i]() { rcs[i] = lookup(deviceID, lookups[i]); });
+            }
+
+            m_batchExecutor.run(tasks);
+
+            for (size_t i = 0; i < ids.size(); i++) {
+                if (!valid[i]) {
+                    JsonObject failure;
+                    failure["error"] = string("Invalid deviceID");
+                    results[ids[i].c_str()] = failure;
+                } else if (BTRMGR_RESULT_SUCCESS != rcs[i]) {
+                    JsonObject failure;
+                    failure["error"] = string("BTRMGR error ") + std::to_string(rcs[i]);
+                    results[ids[i].c_str()] = failure;
+                } else {
+                    results[ids[i].c_str()] = lookups[i];
+                }
+            }
+            return true;
         }
 
         bool Bluetooth::setEventResponse(long long int  deviceID, const string &eventType, const string &respValue)
@@ -952,6 +1596,12 @@ namespace WPEFramework
         JsonObject Bluetooth::getDeviceInfo(long long int deviceID)
         {
             JsonObject deviceDetails;
+            readDeviceInfo(deviceID, deviceDetails);
+            return deviceDetails;
+        }
+
+        BTRMGR_Result_t Bluetooth::readDeviceInfo(long long int deviceID, JsonObject& deviceDetails)
+        {
             string profileInfo;
 
             BTRMGR_Result_t rc = BTRMGR_RESULT_SUCCESS;
@@ -987,7 +1637,7 @@ namespace WPEFramework
                 }
                 deviceDetails["supportedProfile"] = profileInfo;
             }
-            return deviceDetails;
+            return rc;
         }
 
         JsonObject Bluetooth::getMediaTrackInfo(long long int deviceID)
@@ -1018,401 +1668,789 @@ namespace WPEFramework
             return mediaTrackInfo;
         }
 
-        void Bluetooth::notifyEventWrapper (BTRMGR_EventMessage_t &eventMsg)
+        // Describes how one BTRMGR event is turned into a notification. Events without a
+        // descriptor are not notified.
+        struct Bluetooth::EventDescriptor {
+            enum Source {
+                SOURCE_NONE = 0,
+                SOURCE_DISCOVERED_DEVICE,   // eventMsg.m_discoveredDevice
+                SOURCE_PAIRED_DEVICE,       // eventMsg.m_pairedDevice
+                SOURCE_EXTERNAL_DEVICE,     // eventMsg.m_externalDevice
+                SOURCE_MEDIA_INFO           // eventMsg.m_mediaInfo
+            };
+
+            BTRMGR_Events_t type;
+            const char*     name;       // for the log only
+            const string*   eventId;    // nullptr when the hook notifies on its own
+            Source          source;
+            const string*   newStatus;  // onStatusChanged/onRequestFailed
+            const char*     action;     // onPlaybackChange
+            bool            paired;     // "paired" value of SOURCE_PAIRED_DEVICE events
+            bool            replay;     // kept for getEventsSince, false for the high rate events
+            BluetoothEventQueue::Lane lane; // interactive only for requests waiting for a user response, they change no device state
+            EventHook       hook;       // runs whether or not the event has subscribers
+            EventEncoder    encode;
+        };
+
+        namespace {
+
+            constexpr uint8_t NO_EVENT_DESCRIPTOR = 0xFF;
+
+            struct EventDescriptorIndex {
+                uint8_t slot[BTRMGR_EVENT_MAX + 1];
+            };
+
+            template <typename DESCRIPTOR, size_t N>
+            constexpr EventDescriptorIndex makeEventDescriptorIndex(const DESCRIPTOR (&descriptors)[N])
+            {
+                EventDescriptorIndex index {};
+                for (size_t i = 0; i <= BTRMGR_EVENT_MAX; ++i) {
+                    index.slot[i] = NO_EVENT_DESCRIPTOR;
+                }
+                for (size_t i = 0; i < N; ++i) {
+                    index.slot[descriptors[i].type] = static_cast<uint8_t>(i);
+                }
+                return index;
+            }
+
+            template <typename DEVICE>
+            void encodeDeviceFields(const DEVICE& device, JsonObject& params)
+            {
+                params["deviceID"] = std::to_string(device.m_deviceHandle);
+                params["name"] = string(device.m_name);
+                params["deviceType"] = BTRMGR_GetDeviceTypeAsString(device.m_deviceType);
+                params["rawDeviceType"] = std::to_string(device.m_ui32DevClassBtSpec);
+                params["rawBleDeviceType"] = std::to_string(device.m_ui16DevAppearanceBleSpec);
+                params["lastConnectedState"] = device.m_isLastConnectedDevice ? true : false;
+            }
+
+            void encodeExternalDeviceFields(const BTRMGR_ExternalDevice_t& device, JsonObject& params)
+            {
+                string profileInfo;
+
+                params["deviceID"] = std::to_string(device.m_deviceHandle);
+                params["name"] = string(device.m_name);
+                params["deviceType"] = BTRMGR_GetDeviceTypeAsString(device.m_deviceType);
+                params["manufacturer"] = std::to_string(device.m_vendorID);
+                params["MAC"] = string(device.m_deviceAddress);
+
+                for (int i = 0; i < device.m_serviceInfo.m_numOfService; i++) {
+                    profileInfo += string(device.m_serviceInfo.m_profileInfo[i].m_profile);
+                    if ((i + 1) < device.m_serviceInfo.m_numOfService)
+                        profileInfo += string(";");
+                }
+
+                params["supportedProfile"] = profileInfo;
+            }
+
+        } // namespace
+
+        // BTRMGR_EVENT_DEVICE_OP_*, BTRMGR_EVENT_MEDIA_PLAYER_* and the media info events have no
+        // descriptor. A new event only needs an entry here, and a hook/encoder if none fits.
+        const Bluetooth::EventDescriptor* Bluetooth::eventDescriptor(BTRMGR_Events_t eventType)
+        {
+            typedef EventDescriptor D;
+            typedef BluetoothEventQueue Q;
+
+            static constexpr EventDescriptor descriptors[] = {
+                // TODO: Stopping the discovery timer and resetting the flag should not be needed on Discovery completed.
+                //       But is it logical to expect DISCOVERY_COMPLETED, when Bluetooth Service has not asked BTRMgr to
+                //       to Stop discovery. Should we change BTRMgr to send an alternate event to indicate DISCOVERY_PAUSED
+                //       and DISCOVERY_RESUMED.
+                //       Would it be sufficient to send the Discovery Type as part of DISCOVERY_STARTED and DISCOVERY_COMPLETE
+                //       events from BTRMgr ??
+                { BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE, "DISCOVERY_COMPLETED", &EVT_STATUS_CHANGED, D::SOURCE_NONE,
+                  &STATUS_DISCOVERY_COMPLETED, nullptr, false, true, Q::LANE_STREAMING, &Bluetooth::flushDiscoveryBatchHook, &Bluetooth::encodeStatus },
+                { BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED, "DISCOVERY_STARTED", &EVT_STATUS_CHANGED, D::SOURCE_NONE,
+                  &STATUS_DISCOVERY_STARTED, nullptr, false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeStatus },
+                { BTRMGR_EVENT_DEVICE_PAIRING_COMPLETE, "PAIRING_CHANGE", &EVT_STATUS_CHANGED, D::SOURCE_DISCOVERED_DEVICE,
+                  &STATUS_PAIRING_CHANGE, nullptr, false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeDeviceStatus },
+                { BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE, "PAIRING_CHANGE", &EVT_STATUS_CHANGED, D::SOURCE_PAIRED_DEVICE,
+                  &STATUS_PAIRING_CHANGE, nullptr, false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeDeviceStatus },
+                { BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, "CONNECTION_CHANGE", &EVT_STATUS_CHANGED, D::SOURCE_PAIRED_DEVICE,
+                  &STATUS_CONNECTION_CHANGE, nullptr, true, true, Q::LANE_STREAMING, &Bluetooth::debounceConnectionHook, &Bluetooth::encodeConnectionStatus },
+                { BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE, "CONNECTION_CHANGE", &EVT_STATUS_CHANGED, D::SOURCE_PAIRED_DEVICE,
+                  &STATUS_CONNECTION_CHANGE, nullptr, true, true, Q::LANE_STREAMING, &Bluetooth::debounceConnectionHook, &Bluetooth::encodeConnectionStatus },
+                { BTRMGR_EVENT_DEVICE_PAIRING_FAILED, "PAIRING_FAILED", &EVT_REQUEST_FAILED, D::SOURCE_DISCOVERED_DEVICE,
+                  &STATUS_PAIRING_FAILED, nullptr, false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeDeviceStatus },
+                { BTRMGR_EVENT_DEVICE_UNPAIRING_FAILED, "PAIRING_FAILED", &EVT_REQUEST_FAILED, D::SOURCE_PAIRED_DEVICE,
+                  &STATUS_PAIRING_FAILED, nullptr, true, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeDeviceStatus },
+                { BTRMGR_EVENT_DEVICE_CONNECTION_FAILED, "CONNECTION_FAILED", &EVT_REQUEST_FAILED, D::SOURCE_PAIRED_DEVICE,
+                  &STATUS_CONNECTION_FAILED, nullptr, true, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeDeviceStatus },
+                { BTRMGR_EVENT_RECEIVED_EXTERNAL_PAIR_REQUEST, "external pairing request", &EVT_PAIRING_REQUEST, D::SOURCE_EXTERNAL_DEVICE,
+                  nullptr, nullptr, false, true, Q::LANE_INTERACTIVE, nullptr, &Bluetooth::encodePairingRequest },
+                { BTRMGR_EVENT_RECEIVED_EXTERNAL_CONNECT_REQUEST, "external connection request", &EVT_CONNECTION_REQUEST, D::SOURCE_EXTERNAL_DEVICE,
+                  nullptr, nullptr, false, true, Q::LANE_INTERACTIVE, &Bluetooth::answerConnectionRequestHook, &Bluetooth::encodeExternalRequest },
+                { BTRMGR_EVENT_RECEIVED_EXTERNAL_PLAYBACK_REQUEST, "external playback request", &EVT_PLAYBACK_REQUEST, D::SOURCE_EXTERNAL_DEVICE,
+                  nullptr, nullptr, false, true, Q::LANE_INTERACTIVE, nullptr, &Bluetooth::encodeExternalRequest },
+                { BTRMGR_EVENT_MEDIA_TRACK_STARTED, "onPlaybackChange(started)", &EVT_PLAYBACK_STARTED, D::SOURCE_MEDIA_INFO,
+                  nullptr, "started", false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodePlaybackChange },
+                { BTRMGR_EVENT_MEDIA_TRACK_PAUSED, "onPlaybackChange(paused)", &EVT_PLAYBACK_PAUSED, D::SOURCE_MEDIA_INFO,
+                  nullptr, "paused", false, true, Q::LANE_STREAMING, &Bluetooth::flushPlaybackProgressHook, &Bluetooth::encodePlaybackChange },
+                { BTRMGR_EVENT_MEDIA_TRACK_STOPPED, "onPlaybackChange(stopped)", &EVT_PLAYBACK_STOPPED, D::SOURCE_MEDIA_INFO,
+                  nullptr, "stopped", false, true, Q::LANE_STREAMING, &Bluetooth::forgetPlaybackProgressHook, &Bluetooth::encodePlaybackChange },
+                { BTRMGR_EVENT_MEDIA_PLAYBACK_ENDED, "onPlaybackChange(ended)", &EVT_PLAYBACK_ENDED, D::SOURCE_MEDIA_INFO,
+                  nullptr, "ended", false, true, Q::LANE_STREAMING, &Bluetooth::forgetPlaybackProgressHook, &Bluetooth::encodePlaybackEnded },
+                // Notified (or deferred) by the coalescing stage.
+                { BTRMGR_EVENT_MEDIA_TRACK_PLAYING, "Playback Position", nullptr, D::SOURCE_MEDIA_INFO,
+                  nullptr, nullptr, false, false, Q::LANE_STREAMING, &Bluetooth::holdPlaybackProgressHook, nullptr },
+                { BTRMGR_EVENT_MEDIA_TRACK_POSITION, "Playback Position", nullptr, D::SOURCE_MEDIA_INFO,
+                  nullptr, nullptr, false, false, Q::LANE_STREAMING, &Bluetooth::holdPlaybackProgressHook, nullptr },
+                { BTRMGR_EVENT_MEDIA_TRACK_CHANGED, "onPlaybackNewTrack", &EVT_PLAYBACK_NEW_TRACK, D::SOURCE_MEDIA_INFO,
+                  nullptr, nullptr, false, true, Q::LANE_STREAMING, &Bluetooth::flushPlaybackProgressHook, &Bluetooth::encodeNewTrack },
+                { BTRMGR_EVENT_DEVICE_FOUND, "onDeviceFound", &EVT_DEVICE_FOUND, D::SOURCE_PAIRED_DEVICE,
+                  nullptr, nullptr, false, false, Q::LANE_STREAMING, &Bluetooth::batchFoundDeviceHook, &Bluetooth::encodeDeviceRange },
+                { BTRMGR_EVENT_DEVICE_OUT_OF_RANGE, "onDeviceLost", &EVT_DEVICE_LOST_OR_OUT_OF_RANGE, D::SOURCE_PAIRED_DEVICE,
+                  nullptr, nullptr, false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeDeviceRange },
+                { BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE, "onDiscoveredDevice", &EVT_DEVICE_DISCOVERY_UPDATE, D::SOURCE_DISCOVERED_DEVICE,
+                  nullptr, nullptr, false, false, Q::LANE_STREAMING, &Bluetooth::batchDiscoveryUpdateHook, &Bluetooth::encodeDiscoveryUpdate },
+                { BTRMGR_EVENT_DEVICE_MEDIA_STATUS, "onDeviceMediaStatus", &EVT_DEVICE_MEDIA_STATUS, D::SOURCE_MEDIA_INFO,
+                  nullptr, nullptr, false, true, Q::LANE_STREAMING, nullptr, &Bluetooth::encodeMediaStatus }
+            };
+            static_assert((sizeof(descriptors) / sizeof(descriptors[0])) < NO_EVENT_DESCRIPTOR, "too many event descriptors");
+
+            static constexpr EventDescriptorIndex index = makeEventDescriptorIndex(descriptors);
+
+            if ((eventType < 0) || (eventType >= BTRMGR_EVENT_MAX)) {
+                return nullptr;
+            }
+            const uint8_t slot = index.slot[eventType];
+            return (NO_EVENT_DESCRIPTOR == slot) ? nullptr : &descriptors[slot];
+        }
+
+        BluetoothEventQueue::Lane Bluetooth::eventLane(BTRMGR_Events_t eventType)
         {
-            JsonObject params;
-            string profileInfo;
-            string eventId;
+            const EventDescriptor* descriptor = eventDescriptor(eventType);
+            return (nullptr != descriptor) ? descriptor->lane : BluetoothEventQueue::LANE_STREAMING;
+        }
+
+        void Bluetooth::notifyEventWrapper (BTRMGR_EventMessage_t &eventMsg, uint64_t ingressUs)
+        {
+            const uint64_t dispatchUs = monotonicTimeUs();
+            if ((0 == ingressUs) || (ingressUs > dispatchUs)) {
+                ingressUs = dispatchUs;
+            }
+
             LOGINFO ("Event notification: event of type %d received", eventMsg.m_eventType);
-            switch (eventMsg.m_eventType) {
-                case BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(STATUS_DISCOVERY_COMPLETED));
-                    params["newStatus"] = STATUS_DISCOVERY_COMPLETED;
-                    eventId = EVT_STATUS_CHANGED;
-
-                    // TODO: Stopping the discovery timer and resetting the flag should not be needed on Discovery completed.
-                    //       But is it logical to expect DISCOVERY_COMPLETED, when Bluetooth Service has not asked BTRMgr to
-                    //       to Stop discovery. Should we change BTRMgr to send an alternate event to indicate DISCOVERY_PAUSED
-                    //       and DISCOVERY_RESUMED.
-                    //       Would it be sufficient to send the Discovery Type as part of DISCOVERY_STARTED and DISCOVERY_COMPLETE
-                    //       events from BTRMgr ??
-                    break;
 
-                case BTRMGR_EVENT_DEVICE_PAIRING_COMPLETE:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(STATUS_PAIRING_CHANGE));
-                    params["newStatus"] = STATUS_PAIRING_CHANGE;
-                    params["deviceID"] = C_STR(std::to_string(eventMsg.m_discoveredDevice.m_deviceHandle));
-                    params["name"] = string(eventMsg.m_discoveredDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_discoveredDevice.m_deviceType);
-                    params["rawDeviceType"] = C_STR(std::to_string(eventMsg.m_discoveredDevice.m_ui32DevClassBtSpec));
-		            params["rawBleDeviceType"] = C_STR(std::to_string(eventMsg.m_discoveredDevice.m_ui16DevAppearanceBleSpec));
-                    params["lastConnectedState"] = eventMsg.m_discoveredDevice.m_isLastConnectedDevice ? true : false;
-                    params["paired"] = eventMsg.m_discoveredDevice.m_isPairedDevice ? true : false;
-                    params["connected"] = eventMsg.m_discoveredDevice.m_isConnected ? true : false;
-
-                    eventId = EVT_STATUS_CHANGED;
-                    break;
+            const EventDescriptor* descriptor = eventDescriptor(eventMsg.m_eventType);
+            if (nullptr == descriptor) {
+                return;
+            }
 
-                case BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(STATUS_PAIRING_CHANGE));
-                    params["newStatus"] = STATUS_PAIRING_CHANGE;
-                    params["deviceID"] = std::to_string(eventMsg.m_pairedDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_pairedDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_pairedDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_pairedDevice.m_isLastConnectedDevice ? true : false;
-                    params["paired"] = false;
-                    params["connected"] = eventMsg.m_pairedDevice.m_isConnected ? true : false;
-
-                    eventId = EVT_STATUS_CHANGED;
-                    break;
+            m_eventStatsLock.Lock();
+            m_eventStats.record(eventMsg.m_eventType, BluetoothEventStats::STAGE_QUEUE, dispatchUs - ingressUs);
+            m_laneWait[descriptor->lane].record(dispatchUs - ingressUs);
+            m_eventStatsLock.Unlock();
 
-                case BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE:
-                case BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE: {
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(STATUS_CONNECTION_CHANGE));
-                    string deviceId = std::to_string(eventMsg.m_pairedDevice.m_deviceHandle);
-                    
-                    params["newStatus"] = STATUS_CONNECTION_CHANGE;
-                    params["deviceID"] = deviceId;
-                    params["name"] = string(eventMsg.m_pairedDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_pairedDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_pairedDevice.m_isLastConnectedDevice ? true : false;
-                    params["paired"] = true;
-                    params["connected"] = eventMsg.m_pairedDevice.m_isConnected ? true : false;
-
-                    AutoConnectStatus autoConnectStatus;
-                    Core::hresult result = m_bluetoothDeviceManager.getAutoConnect(deviceId, autoConnectStatus);
-
-                    if (Core::ERROR_NONE == result) {
-                        if (AUTO_CONNECT_STATUS_UNSET != autoConnectStatus) {
-                            params["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus);
+            // Before the hook, the registry follows BTRMGR even when a notification is held or dropped.
+            if (0 != m_deviceRegistryInterval) {
+                m_deviceRegistryLock.Lock();
+                m_deviceRegistry.apply(eventMsg, monotonicTimeMs());
+                m_deviceRegistryLock.Unlock();
+            }
+
+            if (&EVT_REQUEST_FAILED == descriptor->eventId) {
+                LOGERR("Received %s Event from BTRMgr", descriptor->name);
+            } else {
+                LOGINFO("Received %s Event from BTRMgr", descriptor->name);
+            }
+
+            if ((nullptr != descriptor->hook) && !(this->*(descriptor->hook))(eventMsg)) {
+                return;
+            }
+            notifyDescriptorEvent(*descriptor, eventMsg, ingressUs);
+        }
+
+        void Bluetooth::notifyDescriptorEvent(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs)
+        {
+            if (nullptr == descriptor.eventId) {
+                return;
+            }
+
+            // Replayed events are built without subscribers too, a late subscriber fetches them with getEventsSince.
+            const bool replay = descriptor.replay && m_eventJournal.enabled();
+            if (!replay && !hasSubscribers(*descriptor.eventId)) {
+                return;
+            }
+
+            const uint64_t encodeUs = monotonicTimeUs();
+            JsonObject params;
+            (this->*(descriptor.encode))(descriptor, eventMsg, params);
+            const uint64_t notifyUs = monotonicTimeUs();
+            publishEvent(*descriptor.eventId, params, replay);
+            const uint64_t doneUs = monotonicTimeUs();
+
+            m_eventStatsLock.Lock();
+            m_eventStats.record(eventMsg.m_eventType, BluetoothEventStats::STAGE_ENCODE, notifyUs - encodeUs);
+            m_eventStats.record(eventMsg.m_eventType, BluetoothEventStats::STAGE_NOTIFY, doneUs - notifyUs);
+            m_eventStats.record(eventMsg.m_eventType, BluetoothEventStats::STAGE_TOTAL, doneUs - ingressUs);
+            m_eventStatsLock.Unlock();
+        }
+
+        bool Bluetooth::flushDiscoveryBatchHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            UNUSED(eventMsg);
+            flushDiscoveryBatch();
+            return true;
+        }
+
+        bool Bluetooth::holdPlaybackProgressHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            coalescePlaybackProgress(eventMsg.m_mediaInfo);
+            return false;
+        }
+
+        bool Bluetooth::flushPlaybackProgressHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            flushPlaybackProgress(eventMsg.m_mediaInfo.m_deviceHandle, false);
+            return true;
+        }
+
+        bool Bluetooth::forgetPlaybackProgressHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            flushPlaybackProgress(eventMsg.m_mediaInfo.m_deviceHandle, true);
+            return true;
+        }
+
+        bool Bluetooth::debounceConnectionHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            if (!m_connectionDebouncer.enabled()) {
+                return true;
+            }
+
+            std::vector<BTRMGR_EventMessage_t> due;
+            uint64_t nextDueMs = 0;
+            const uint64_t nowMs = monotonicTimeMs();
+
+            m_connectionSettleTimer.Lock();
+            // A held event whose settle time elapsed goes out before the new one even if the timer is late.
+            m_connectionDebouncer.takeDue(nowMs, due);
+            for (const BTRMGR_EventMessage_t& heldEvent : due) {
+                notifyDescriptorEvent(*eventDescriptor(heldEvent.m_eventType), heldEvent, monotonicTimeUs());
+            }
+
+            const BluetoothConnectionDebouncer::Action action = m_connectionDebouncer.offer(eventMsg, nowMs, nextDueMs);
+            if (BluetoothConnectionDebouncer::ACTION_SUPPRESS == action) {
+                LOGWARN("Connection state of device %llu reverted within %u ms, transition suppressed",
+                    static_cast<unsigned long long>(eventMsg.m_pairedDevice.m_deviceHandle), m_connectionDebouncer.settleTime());
+            } else if (BluetoothConnectionDebouncer::ACTION_HOLD == action) {
+                m_connectionSettleTimer.Schedule(nextDueMs);
+            }
+            m_connectionSettleTimer.Unlock();
+
+            return (BluetoothConnectionDebouncer::ACTION_NOTIFY == action);
+        }
+
+        bool Bluetooth::batchFoundDeviceHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            RegisteredDevice device;
+            device.deviceHandle = eventMsg.m_pairedDevice.m_deviceHandle;
+            device.name = eventMsg.m_pairedDevice.m_name;
+            device.deviceType = eventMsg.m_pairedDevice.m_deviceType;
+            device.paired = true;
+            matchDiscoveredDevice(device, eventMsg.m_pairedDevice.m_deviceAddress);
+
+            DiscoveredDeviceUpdate update;
+            update.deviceHandle = eventMsg.m_pairedDevice.m_deviceHandle;
+            update.updateType = DISCOVERY_UPDATE_FOUND;
+            update.name = string(eventMsg.m_pairedDevice.m_name);
+            update.deviceType = eventMsg.m_pairedDevice.m_deviceType;
+            update.rawDeviceType = eventMsg.m_pairedDevice.m_ui32DevClassBtSpec;
+            update.rawBleDeviceType = eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec;
+            update.lastConnectedState = eventMsg.m_pairedDevice.m_isLastConnectedDevice ? true : false;
+            update.paired = true;
+            indexDiscoveryUpdate(update);
+
+            if (m_discoveryBatcher.enabled() && hasSubscribers(EVT_DISCOVERED_DEVICES)) {
+                batchDiscoveryUpdate(update);
+            }
+            return true;
+        }
+
+        bool Bluetooth::batchDiscoveryUpdateHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            if (eventMsg.m_discoveredDevice.m_isDiscovered) {
+                m_backgroundDiscoveryLock.Lock();
+                if (m_backgroundDiscoveryEnabled) {
+                    (void)m_discoveryDutyCycle.deviceSeen(eventMsg.m_discoveredDevice.m_deviceHandle);
+                }
+                m_backgroundDiscoveryLock.Unlock();
+
+                RegisteredDevice device;
+                device.deviceHandle = eventMsg.m_discoveredDevice.m_deviceHandle;
+                device.name = eventMsg.m_discoveredDevice.m_name;
+                device.deviceType = eventMsg.m_discoveredDevice.m_deviceType;
+                device.paired = eventMsg.m_discoveredDevice.m_isPairedDevice ? true : false;
+                matchDiscoveredDevice(device, eventMsg.m_discoveredDevice.m_deviceAddress);
+            }
+
+            DiscoveredDeviceUpdate update;
+            update.deviceHandle = eventMsg.m_discoveredDevice.m_deviceHandle;
+            update.updateType = eventMsg.m_discoveredDevice.m_isDiscovered ? DISCOVERY_UPDATE_DISCOVERED : DISCOVERY_UPDATE_LOST;
+            update.name = string(eventMsg.m_discoveredDevice.m_name);
+            update.deviceType = eventMsg.m_discoveredDevice.m_deviceType;
+            update.rawDeviceType = eventMsg.m_discoveredDevice.m_ui32DevClassBtSpec;
+            update.rawBleDeviceType = eventMsg.m_discoveredDevice.m_ui16DevAppearanceBleSpec;
+            update.lastConnectedState = eventMsg.m_discoveredDevice.m_isLastConnectedDevice ? true : false;
+            update.paired = eventMsg.m_discoveredDevice.m_isPairedDevice ? true : false;
+            indexDiscoveryUpdate(update);
+
+            if (m_discoveryBatcher.enabled() && hasSubscribers(EVT_DISCOVERED_DEVICES)) {
+                batchDiscoveryUpdate(update);
+            }
+            return true;
+        }
+
+        bool Bluetooth::answerConnectionRequestHook(const BTRMGR_EventMessage_t& eventMsg)
+        {
+            UNUSED(eventMsg);
+            #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
+            if (m_bluetoothDeviceManager.isMigrated()) {
+
+                // Migration is complete, check the autoconnect status and respond to the event accordingly.
+
+                AutoConnectStatus autoConnectStatus;
+                Core::hresult result = m_bluetoothDeviceManager.getAutoConnect(eventMsg.m_externalDevice.m_deviceHandle, autoConnectStatus);
+                if (Core::ERROR_NONE == result) {
+                    bool bAccepted = AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus;
+
+                    (void)setEventResponse(eventMsg.m_externalDevice.m_deviceHandle,
+                        EVT_CONNECTION_REQUEST,
+                        bAccepted ? "ACCEPTED" : "REJECTED");
+
+                    if (bAccepted) {
+                        // Connect device behind the requests already queued for it, off the dispatcher thread.
+                        const BTRMgrDeviceHandle deviceHandle = eventMsg.m_externalDevice.m_deviceHandle;
+                        const BluetoothDeviceCategory category = bluetoothDeviceCategory(bluetoothDeviceTypeFromBtrmgr(eventMsg.m_externalDevice.m_deviceType));
+                        if (0 == m_operationExecutor.submit(METHOD_CONNECT, deviceHandle,
+                                [this, deviceHandle, category]() { return setDeviceConnection(deviceHandle, true, category); })) {
+                            LOGERR("Failed to queue the connection of device %llu", deviceHandle);
                         }
-                    } else {
-                        LOGINFO("Unable to retrieve autoconnect status for device %s: %d", deviceId.c_str(), result);
                     }
 
-                    eventId = EVT_STATUS_CHANGED;
-                    break;
+                    return false; // Response sent, no need to notify client about this event.
+                } else {
+                    LOGERR("Failed to get autoconnect status for device %llu: %d", eventMsg.m_externalDevice.m_deviceHandle, result);
                 }
+            } else {
+                LOGINFO("Device manager not migrated, notifying client about connection request for device %llu", eventMsg.m_externalDevice.m_deviceHandle);
+            }
+            #endif
+            return true;
+        }
 
-                case BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(STATUS_DISCOVERY_STARTED));
-                    params["newStatus"] = STATUS_DISCOVERY_STARTED;
-                    eventId = EVT_STATUS_CHANGED;
-                    break;
+        void Bluetooth::encodeStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(eventMsg);
+            params["newStatus"] = *descriptor.newStatus;
+        }
 
-                case BTRMGR_EVENT_RECEIVED_EXTERNAL_PAIR_REQUEST:
-                    LOGINFO ("Received %s Event from BTRMgr", "external pairing request");
-                    params["deviceID"] = std::to_string(eventMsg.m_externalDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_externalDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_externalDevice.m_deviceType);
-                    params["manufacturer"] = std::to_string(eventMsg.m_externalDevice.m_vendorID);
-                    params["MAC"] = string(eventMsg.m_externalDevice.m_deviceAddress);
-
-                    for (int i = 0; i < eventMsg.m_externalDevice.m_serviceInfo.m_numOfService; i++) {
-                        profileInfo += string(eventMsg.m_externalDevice.m_serviceInfo.m_profileInfo[i].m_profile);
-                        if ((i + 1) < eventMsg.m_externalDevice.m_serviceInfo.m_numOfService)
-                            profileInfo += string(";");
-                    }
+        void Bluetooth::encodeDeviceStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            params["newStatus"] = *descriptor.newStatus;
+            if (EventDescriptor::SOURCE_DISCOVERED_DEVICE == descriptor.source) {
+                encodeDeviceFields(eventMsg.m_discoveredDevice, params);
+                params["paired"] = eventMsg.m_discoveredDevice.m_isPairedDevice ? true : false;
+                params["connected"] = eventMsg.m_discoveredDevice.m_isConnected ? true : false;
+            } else {
+                encodeDeviceFields(eventMsg.m_pairedDevice, params);
+                params["paired"] = descriptor.paired;
+                params["connected"] = eventMsg.m_pairedDevice.m_isConnected ? true : false;
+            }
+        }
 
-                    params["supportedProfile"] = profileInfo;
+        void Bluetooth::encodeConnectionStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            encodeDeviceStatus(descriptor, eventMsg, params);
 
-                    if (eventMsg.m_externalDevice.m_externalDevicePIN == 0) {
-                        params["pinRequired"] = "false";
-                    }
-                    else {
-                        params["pinRequired"] = "true";
-                        params["pinValue"] = std::to_string(eventMsg.m_externalDevice.m_externalDevicePIN);
-                    }
+            const BTRMgrDeviceHandle deviceHandle = eventMsg.m_pairedDevice.m_deviceHandle;
+            AutoConnectStatus autoConnectStatus;
+            Core::hresult result = m_bluetoothDeviceManager.getAutoConnect(deviceHandle, autoConnectStatus);
 
-                    eventId = EVT_PAIRING_REQUEST;
-                    break;
+            if (Core::ERROR_NONE == result) {
+                if (AUTO_CONNECT_STATUS_UNSET != autoConnectStatus) {
+                    params["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus);
+                }
+            } else {
+                LOGINFO("Unable to retrieve autoconnect status for device %llu: %d", deviceHandle, result);
+            }
+        }
 
-                case BTRMGR_EVENT_DEVICE_PAIRING_FAILED:
-                    LOGERR("Received %s Event from BTRMgr", C_STR(STATUS_PAIRING_FAILED));
-                    params["newStatus"] = STATUS_PAIRING_FAILED;
-                    params["deviceID"] = std::to_string(eventMsg.m_discoveredDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_discoveredDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_discoveredDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_discoveredDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_discoveredDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_discoveredDevice.m_isLastConnectedDevice ? true : false;
-                    params["paired"] = eventMsg.m_discoveredDevice.m_isPairedDevice ? true : false;
-                    params["connected"] = eventMsg.m_discoveredDevice.m_isConnected ? true : false;
-
-                    eventId = EVT_REQUEST_FAILED;
-                    break;
+        void Bluetooth::encodeDeviceRange(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(descriptor);
+            encodeDeviceFields(eventMsg.m_pairedDevice, params);
+        }
 
-                case BTRMGR_EVENT_DEVICE_UNPAIRING_FAILED:
-                    LOGERR("Received %s Event from BTRMgr", C_STR(STATUS_PAIRING_FAILED));
-                    params["newStatus"] = STATUS_PAIRING_FAILED;
-                    params["deviceID"] = std::to_string(eventMsg.m_pairedDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_pairedDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_pairedDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_pairedDevice.m_isLastConnectedDevice ? true : false;
-                    params["paired"] = true;
-                    params["connected"] = eventMsg.m_pairedDevice.m_isConnected ? true : false;
-
-                    eventId = EVT_REQUEST_FAILED;
-                    break;
+        void Bluetooth::encodeDiscoveryUpdate(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(descriptor);
+            params["deviceID"] = std::to_string(eventMsg.m_discoveredDevice.m_deviceHandle);
+            params["discoveryType"] = eventMsg.m_discoveredDevice.m_isDiscovered ? "DISCOVERED":"LOST";
+            params["name"] = string(eventMsg.m_discoveredDevice.m_name);
+            params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_discoveredDevice.m_deviceType);
+            params["rawDeviceType"] = std::to_string(eventMsg.m_discoveredDevice.m_ui32DevClassBtSpec);
+            params["rawBleDeviceType"] = std::to_string(eventMsg.m_discoveredDevice.m_ui16DevAppearanceBleSpec);
+            params["lastConnectedState"] = eventMsg.m_discoveredDevice.m_isLastConnectedDevice? true:false;
+            params["paired"] = eventMsg.m_discoveredDevice.m_isPairedDevice ? true:false;
+        }
 
-                case BTRMGR_EVENT_DEVICE_CONNECTION_FAILED:
-                    LOGERR("Received %s Event from BTRMgr", C_STR(STATUS_CONNECTION_FAILED));
-                    params["newStatus"] = STATUS_CONNECTION_FAILED;
-                    params["deviceID"] = std::to_string(eventMsg.m_pairedDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_pairedDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_pairedDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_pairedDevice.m_isLastConnectedDevice ? true : false;
-                    params["paired"] = true;
-                    params["connected"] = eventMsg.m_pairedDevice.m_isConnected ? true : false;
-
-                    eventId = EVT_REQUEST_FAILED;
-                    break;
+        void Bluetooth::encodeExternalRequest(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(descriptor);
+            encodeExternalDeviceFields(eventMsg.m_externalDevice, params);
+        }
+
+        void Bluetooth::encodePairingRequest(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(descriptor);
+            encodeExternalDeviceFields(eventMsg.m_externalDevice, params);
+
+            if (eventMsg.m_externalDevice.m_externalDevicePIN == 0) {
+                params["pinRequired"] = "false";
+            }
+            else {
+                params["pinRequired"] = "true";
+                params["pinValue"] = std::to_string(eventMsg.m_externalDevice.m_externalDevicePIN);
+            }
+        }
+
+        void Bluetooth::encodePlaybackChange(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            params["action"]   = std::string(descriptor.action);
+            params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
+            params["position"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaPosition);
+            params["Duration"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaDuration);
+        }
+
+        void Bluetooth::encodePlaybackEnded(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            params["action"]   = std::string(descriptor.action);
+            params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
+        }
+
+        void Bluetooth::encodeNewTrack(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(descriptor);
+            params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
+            params["album"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcAlbum);
+            params["genre"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcGenre);
+            params["title"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcTitle);
+            params["artist"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcArtist);
+            params["ui32Duration"] = std::to_string(eventMsg.m_mediaInfo.m_mediaTrackInfo.ui32Duration);
+            params["ui32TrackNumber"] = std::to_string(eventMsg.m_mediaInfo.m_mediaTrackInfo.ui32TrackNumber);
+            params["ui32NumberOfTracks"] = std::to_string(eventMsg.m_mediaInfo.m_mediaTrackInfo.ui32NumberOfTracks);
+        }
+
+        void Bluetooth::encodeMediaStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params)
+        {
+            UNUSED(descriptor);
+            params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
+            params["name"] = string(eventMsg.m_mediaInfo.m_name);
+            params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_mediaInfo.m_deviceType);
+            params["volume"] = std::to_string(eventMsg.m_mediaInfo.m_mediaDevStatus.m_ui8mediaDevVolume);
+            params["mute"] = eventMsg.m_mediaInfo.m_mediaDevStatus.m_ui8mediaDevMute ? true : false;
+
+            if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_VOLUMEUP) {
+                params["command"] = string(CMD_AUDIO_CTRL_VOLUME_UP);
+            }
+            else if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_VOLUMEDOWN) {
+                params["command"] = string(CMD_AUDIO_CTRL_VOLUME_DOWN);
+            }
+            else if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_MUTE) {
+                params["command"] = string(CMD_AUDIO_CTRL_MUTE);
+            }
+            else if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_UNMUTE) {
+                params["command"] = string(CMD_AUDIO_CTRL_UNMUTE);
+            }
+            else {
+                params["command"] = string(CMD_AUDIO_CTRL_UNKNOWN);
+            }
+        }
+
+        void Bluetooth::coalescePlaybackProgress(const BTRMGR_MediaInfo_t& mediaInfo)
+        {
+            if (!hasSubscribers(EVT_PLAYBACK_POSITION)) {
+                return;
+            }
+
+            PlaybackProgress progress;
+            progress.deviceHandle = mediaInfo.m_deviceHandle;
+            progress.position = mediaInfo.m_mediaPositionInfo.m_mediaPosition;
+            progress.duration = mediaInfo.m_mediaPositionInfo.m_mediaDuration;
+
+            m_playbackProgressTimer.Lock();
+            uint64_t nextDueMs = 0;
+            if (m_playbackProgressCoalescer.offer(progress, monotonicTimeMs(), nextDueMs)) {
+                notifyPlaybackProgress(progress);
+            } else {
+                m_playbackProgressTimer.Schedule(nextDueMs);
+            }
+            m_playbackProgressTimer.Unlock();
+        }
+
+        // Notifies the latest held position of a device before a track change, pause or stop
+        // so that clients never see a stale position after the state change.
+        void Bluetooth::flushPlaybackProgress(BTRMgrDeviceHandle deviceHandle, bool forget)
+        {
+            PlaybackProgress progress;
+
+            m_playbackProgressTimer.Lock();
+            if (m_playbackProgressCoalescer.takePending(deviceHandle, monotonicTimeMs(), progress)) {
+                notifyPlaybackProgress(progress);
+            }
+            if (forget) {
+                m_playbackProgressCoalescer.remove(deviceHandle);
+            }
+            m_playbackProgressTimer.Unlock();
+        }
 
-                case BTRMGR_EVENT_RECEIVED_EXTERNAL_CONNECT_REQUEST: {
-                    LOGINFO("Received %s Event from BTRMgr", "external connection request");
+        void Bluetooth::notifyPlaybackProgress(const PlaybackProgress& progress)
+        {
+            if (!hasSubscribers(EVT_PLAYBACK_POSITION)) {
+                return;
+            }
 
-                    #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
-                    if (m_bluetoothDeviceManager.isMigrated()) {
+            JsonObject params;
+            params["deviceID"] = std::to_string(progress.deviceHandle);
+            params["position"] = std::to_string(progress.position);
+            params["Duration"] = std::to_string(progress.duration);
+            publishEvent(EVT_PLAYBACK_POSITION, params, false);
+        }
 
-                        // Migration is complete, check the autoconnect status and respond to the event accordingly.
+        void Bluetooth::batchDiscoveryUpdate(const DiscoveredDeviceUpdate& update)
+        {
+            std::vector<DiscoveredDeviceUpdate> batch;
+            bool windowOpened = false;
 
-                        AutoConnectStatus autoConnectStatus;
-                        Core::hresult result = m_bluetoothDeviceManager.getAutoConnect(std::to_string(eventMsg.m_externalDevice.m_deviceHandle), autoConnectStatus);
-                        if (Core::ERROR_NONE == result) {
-                            bool bAccepted = AUTO_CONNECT_STATUS_ENABLED == autoConnectStatus;
+            m_discoveryBatchTimer.Lock();
+            if (m_discoveryBatcher.add(update, monotonicTimeMs(), windowOpened)) {
+                m_discoveryBatcher.take(batch);
+                notifyDiscoveryBatch(batch);
+            } else if (windowOpened) {
+                m_discoveryBatchTimer.Schedule(m_discoveryBatcher.window());
+            }
+            m_discoveryBatchTimer.Unlock();
+        }
 
-                            (void)setEventResponse(eventMsg.m_externalDevice.m_deviceHandle,
-                                EVT_CONNECTION_REQUEST,
-                                bAccepted ? "ACCEPTED" : "REJECTED");
+        void Bluetooth::flushDiscoveryBatch()
+        {
+            std::vector<DiscoveredDeviceUpdate> batch;
 
-                            if (bAccepted) {
-                                // Connect device
-                                (void)setDeviceConnection(eventMsg.m_externalDevice.m_deviceHandle, true, BTRMGR_GetDeviceTypeAsString(eventMsg.m_externalDevice.m_deviceType));
-                            }
+            m_discoveryBatchTimer.Lock();
+            if (!m_discoveryBatcher.empty()) {
+                m_discoveryBatcher.take(batch);
+                notifyDiscoveryBatch(batch);
+            }
+            m_discoveryBatchTimer.Unlock();
+        }
 
-                            return; // Response sent, no need to notify client about this event.
-                        } else {
-                            LOGERR("Failed to get autoconnect status for device %llu: %d", eventMsg.m_externalDevice.m_deviceHandle, result);
-                        }
-                    } else {
-                        LOGINFO("Device manager not migrated, notifying client about connection request for device %llu", eventMsg.m_externalDevice.m_deviceHandle);
-                    }
-                    #endif
-
-                    params["deviceID"] = std::to_string(eventMsg.m_externalDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_externalDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_externalDevice.m_deviceType);
-                    params["manufacturer"] = std::to_string(eventMsg.m_externalDevice.m_vendorID);
-                    params["MAC"] = string(eventMsg.m_externalDevice.m_deviceAddress);
-
-                    for (int i = 0; i < eventMsg.m_externalDevice.m_serviceInfo.m_numOfService; i++) {
-                        profileInfo += string(eventMsg.m_externalDevice.m_serviceInfo.m_profileInfo[i].m_profile);
-                        if ((i + 1) < eventMsg.m_externalDevice.m_serviceInfo.m_numOfService)
-                            profileInfo += string(";");
-                    }
+        void Bluetooth::notifyDiscoveryBatch(const std::vector<DiscoveredDeviceUpdate>& batch)
+        {
+            if (!hasSubscribers(EVT_DISCOVERED_DEVICES)) {
+                return;
+            }
 
-                    params["supportedProfile"] = profileInfo;
-                    eventId = EVT_CONNECTION_REQUEST;
-                    break;
-                }
+            JsonArray devices;
+            for (const DiscoveredDeviceUpdate& update : batch) {
+                JsonObject device;
+                device["deviceID"] = std::to_string(update.deviceHandle);
+                device["discoveryType"] = (DISCOVERY_UPDATE_FOUND == update.updateType) ? "FOUND" :
+                                          (DISCOVERY_UPDATE_LOST == update.updateType) ? "LOST" : "DISCOVERED";
+                device["name"] = update.name;
+                const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(update.deviceType);
+                device["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                device["rawDeviceType"] = std::to_string(update.rawDeviceType);
+                device["rawBleDeviceType"] = std::to_string(update.rawBleDeviceType);
+                device["lastConnectedState"] = update.lastConnectedState;
+                device["paired"] = update.paired;
+                devices.Add(device);
+            }
 
-                case BTRMGR_EVENT_RECEIVED_EXTERNAL_PLAYBACK_REQUEST:
-                    LOGINFO("Received %s Event from BTRMgr", "external playback request");
-                    params["deviceID"] = std::to_string(eventMsg.m_externalDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_externalDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_externalDevice.m_deviceType);
-                    params["manufacturer"] = std::to_string(eventMsg.m_externalDevice.m_vendorID);
-                    params["MAC"] = string(eventMsg.m_externalDevice.m_deviceAddress);
+            JsonObject params;
+            params["devices"] = devices;
+            publishEvent(EVT_DISCOVERED_DEVICES, params, false);
+        }
 
-                    for (int i = 0; i < eventMsg.m_externalDevice.m_serviceInfo.m_numOfService; i++) {
-                        profileInfo += string(eventMsg.m_externalDevice.m_serviceInfo.m_profileInfo[i].m_profile);
-                        if ((i + 1) < eventMsg.m_externalDevice.m_serviceInfo.m_numOfService)
-                            profileInfo += string(";");
-                    }
+        void Bluetooth::indexDiscoveryUpdate(const DiscoveredDeviceUpdate& update)
+        {
+            if (!m_discoveryIndex.enabled()) {
+                return;
+            }
 
-                    params["supportedProfile"] = profileInfo;
+            std::vector<DiscoveredDeviceUpdate> evicted;
 
-                    eventId = EVT_PLAYBACK_REQUEST;
-                    break;
+            m_discoveryIndexTimer.Lock();
+            if (DISCOVERY_UPDATE_LOST == update.updateType) {
+                (void)m_discoveryIndex.forget(update.deviceHandle);
+            } else {
+                m_discoveryIndex.seen(update, monotonicTimeMs(), evicted);
+                // The timer stays scheduled while the index holds devices.
+                m_discoveryIndexTimer.Schedule(m_discoveryIndex.ttl());
+            }
+            m_discoveryIndexTimer.Unlock();
 
-                case BTRMGR_EVENT_MEDIA_TRACK_STARTED:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(EVT_PLAYBACK_STARTED));
-                    params["action"]   = std::string("started");
-                    params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
-                    params["position"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaPosition);
-                    params["Duration"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaDuration);
+            for (const DiscoveredDeviceUpdate& lost : evicted) {
+                LOGINFO("Device %llu dropped from the full discovery index, reported lost", static_cast<unsigned long long>(lost.deviceHandle));
+            }
+            notifyDiscoveryIndexLost(evicted);
+        }
 
-                    eventId = EVT_PLAYBACK_STARTED;
-                    break;
-                case BTRMGR_EVENT_MEDIA_TRACK_PAUSED:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(EVT_PLAYBACK_PAUSED));
-                    params["action"]   = std::string("paused");
-                    params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
-                    params["position"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaPosition);
-                    params["Duration"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaDuration);
-
-                    eventId =EVT_PLAYBACK_PAUSED;
-                    break;
+        uint64_t Bluetooth::expireDiscoveryIndex()
+        {
+            std::vector<DiscoveredDeviceUpdate> expired;
 
-                case BTRMGR_EVENT_MEDIA_TRACK_STOPPED:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(EVT_PLAYBACK_STOPPED));
-                    params["action"]   = std::string("stopped");
-                    params["deviceID"] = C_STR(std::to_string(eventMsg.m_mediaInfo.m_deviceHandle));
-                    params["position"] = C_STR(std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaPosition));
-                    params["Duration"] = C_STR(std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaDuration));
+            m_discoveryIndexTimer.Lock();
+            const uint64_t result = m_discoveryIndexTimer.Reschedule(m_discoveryIndex.expire(monotonicTimeMs(), expired));
+            m_discoveryIndexTimer.Unlock();
 
-                    eventId = EVT_PLAYBACK_STOPPED;
-                    break;
+            for (const DiscoveredDeviceUpdate& update : expired) {
+                LOGINFO("Device %llu not seen for %u ms, reported lost", static_cast<unsigned long long>(update.deviceHandle), m_discoveryIndex.ttl());
+            }
+            notifyDiscoveryIndexLost(expired);
 
-                case BTRMGR_EVENT_MEDIA_PLAYBACK_ENDED:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(EVT_PLAYBACK_ENDED));
-                    params["action"]   = std::string("ended");
-                    params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
+            return result;
+        }
 
-                    eventId = EVT_PLAYBACK_ENDED;
-                    break;
+        void Bluetooth::notifyDiscoveryIndexLost(const std::vector<DiscoveredDeviceUpdate>& lost)
+        {
+            // Reported as BTRMGR reports a device lost, on onDiscoveredDevice and in onDiscoveredDevices.
+            for (const DiscoveredDeviceUpdate& update : lost) {
+                if (m_discoveryBatcher.enabled() && hasSubscribers(EVT_DISCOVERED_DEVICES)) {
+                    batchDiscoveryUpdate(update);
+                }
+                if (hasSubscribers(EVT_DEVICE_DISCOVERY_UPDATE)) {
+                    JsonObject params;
+                    params["deviceID"] = std::to_string(update.deviceHandle);
+                    params["discoveryType"] = "LOST";
+                    params["name"] = update.name;
+                    const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(update.deviceType);
+                    params["deviceType"] = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                    params["rawDeviceType"] = std::to_string(update.rawDeviceType);
+                    params["rawBleDeviceType"] = std::to_string(update.rawBleDeviceType);
+                    params["lastConnectedState"] = update.lastConnectedState;
+                    params["paired"] = update.paired;
+                    publishEvent(EVT_DEVICE_DISCOVERY_UPDATE, params, false);
+                }
+            }
+        }
 
-                case BTRMGR_EVENT_MEDIA_TRACK_PLAYING:
-                case BTRMGR_EVENT_MEDIA_TRACK_POSITION:
-                    LOGINFO ("Received Playback Position Event from BTRMgr");
-                    params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
-                    params["position"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaPosition);
-                    params["Duration"] = std::to_string(eventMsg.m_mediaInfo.m_mediaPositionInfo.m_mediaDuration);
+        void Bluetooth::filterDiscoveryIndex(std::vector<RegisteredDevice>& devices)
+        {
+            if (!m_discoveryIndex.enabled()) {
+                return;
+            }
 
-                    eventId = EVT_PLAYBACK_POSITION;
-                    break;
+            // Devices the index never saw, e.g. discovered before activation, are kept as BTRMGR lists them.
+            m_discoveryIndexTimer.Lock();
+            devices.erase(std::remove_if(devices.begin(), devices.end(),
+                [this](const RegisteredDevice& device) { return m_discoveryIndex.lost(device.deviceHandle); }), devices.end());
+            for (RegisteredDevice& device : devices) {
+                const uint64_t lastSeenMs = m_discoveryIndex.lastSeen(device.deviceHandle);
+                if (0 != lastSeenMs) {
+                    device.lastSeenMs = lastSeenMs;
+                }
+            }
+            m_discoveryIndexTimer.Unlock();
+        }
 
-                case BTRMGR_EVENT_MEDIA_TRACK_CHANGED:
-                    params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
-                    params["album"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcAlbum);
-                    params["genre"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcGenre);
-                    params["title"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcTitle);
-                    params["artist"] = string(eventMsg.m_mediaInfo.m_mediaTrackInfo.pcArtist);
-                    params["ui32Duration"] = std::to_string(eventMsg.m_mediaInfo.m_mediaTrackInfo.ui32Duration);
-                    params["ui32TrackNumber"] = std::to_string(eventMsg.m_mediaInfo.m_mediaTrackInfo.ui32TrackNumber);
-                    params["ui32NumberOfTracks"] = std::to_string(eventMsg.m_mediaInfo.m_mediaTrackInfo.ui32NumberOfTracks);
-
-                    eventId = EVT_PLAYBACK_NEW_TRACK;
-                    break;
+        uint64_t Bluetooth::runBackgroundDiscovery(uint64_t scheduledTime)
+        {
+            typedef WPEFramework::Exchange::IPowerManager::PowerState PowerState;
 
-                case BTRMGR_EVENT_DEVICE_FOUND:
-                    params["deviceID"] = std::to_string(eventMsg.m_pairedDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_pairedDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_pairedDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_pairedDevice.m_isLastConnectedDevice?true:false;
+            uint64_t result = 0;
+            BluetoothDiscoveryDutyCycle::Conditions conditions;
+            conditions.audioStreaming = isAudioStreaming();
+
+            m_backgroundDiscoveryLock.Lock();
+            // A timer left over from before the last setBackgroundDiscovery ends here.
+            if (m_backgroundDiscoveryEnabled && (scheduledTime == m_backgroundDiscoveryTicks)) {
+                conditions.standby = (PowerState::POWER_STATE_STANDBY == m_powerState) ||
+                                     (PowerState::POWER_STATE_STANDBY_LIGHT_SLEEP == m_powerState);
+                conditions.suspended = (PowerState::POWER_STATE_OFF == m_powerState) ||
+                                       (PowerState::POWER_STATE_STANDBY_DEEP_SLEEP == m_powerState);
+
+                const BluetoothDiscoveryDutyCycle::Window window = m_discoveryDutyCycle.next(conditions);
+                if (0 != window.scanMs) {
+                    // The session ends with its deadline, sessions of startScan callers keep the scan running.
+                    BluetoothDiscoverySessions::SessionId sessionId = 0;
+                    (void)openDiscoverySession(m_backgroundDiscoveryType, window.scanMs, sessionId);
+                }
+                LOGINFO("Background discovery: scan %u ms, idle %u ms%s", window.scanMs, window.idleMs,
+                    conditions.audioStreaming ? " (audio streaming)" : "");
 
-                    eventId = EVT_DEVICE_FOUND;
-                    break;
+                result = Core::Time::Now().Add(window.scanMs + window.idleMs).Ticks();
+                m_backgroundDiscoveryTicks = result;
+            }
+            m_backgroundDiscoveryLock.Unlock();
 
-                case BTRMGR_EVENT_DEVICE_OUT_OF_RANGE:
-                    params["deviceID"] = std::to_string(eventMsg.m_pairedDevice.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_pairedDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_pairedDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_pairedDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_pairedDevice.m_isLastConnectedDevice?true:false;
-                    eventId = EVT_DEVICE_LOST_OR_OUT_OF_RANGE;
-                    break;
+            return result;
+        }
 
-                case BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE:
-                    params["deviceID"] = std::to_string(eventMsg.m_discoveredDevice.m_deviceHandle);
-                    params["discoveryType"] = eventMsg.m_discoveredDevice.m_isDiscovered ? "DISCOVERED":"LOST";
-                    params["name"] = string(eventMsg.m_discoveredDevice.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_discoveredDevice.m_deviceType);
-                    params["rawDeviceType"] = std::to_string(eventMsg.m_discoveredDevice.m_ui32DevClassBtSpec);
-		            params["rawBleDeviceType"] = std::to_string(eventMsg.m_discoveredDevice.m_ui16DevAppearanceBleSpec);
-                    params["lastConnectedState"] = eventMsg.m_discoveredDevice.m_isLastConnectedDevice? true:false;
-                    params["paired"] = eventMsg.m_discoveredDevice.m_isPairedDevice ? true:false;
-
-                    eventId = EVT_DEVICE_DISCOVERY_UPDATE;
-                    break;
+        uint64_t Bluetooth::onEventTimer(EventTimer::Type type, uint64_t scheduledTime)
+        {
+            uint64_t result = 0;
 
-                case BTRMGR_EVENT_DEVICE_MEDIA_STATUS:
-                    LOGINFO ("Received %s Event from BTRMgr", C_STR(EVT_DEVICE_MEDIA_STATUS));
-                    params["deviceID"] = std::to_string(eventMsg.m_mediaInfo.m_deviceHandle);
-                    params["name"] = string(eventMsg.m_mediaInfo.m_name);
-                    params["deviceType"] = BTRMGR_GetDeviceTypeAsString(eventMsg.m_mediaInfo.m_deviceType);
-                    params["volume"] = std::to_string(eventMsg.m_mediaInfo.m_mediaDevStatus.m_ui8mediaDevVolume);
-                    params["mute"] = eventMsg.m_mediaInfo.m_mediaDevStatus.m_ui8mediaDevMute ? true : false;
+            switch (type) {
+                case EventTimer::PLAYBACK_PROGRESS: {
+                    std::vector<PlaybackProgress> due;
 
-                    if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_VOLUMEUP) {
-                        params["command"] = string(CMD_AUDIO_CTRL_VOLUME_UP);
+                    m_playbackProgressTimer.Lock();
+                    const uint64_t nextDueMs = m_playbackProgressCoalescer.takeDue(monotonicTimeMs(), due);
+                    for (const PlaybackProgress& progress : due) {
+                        notifyPlaybackProgress(progress);
                     }
-                    else if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_VOLUMEDOWN) {
-                        params["command"] = string(CMD_AUDIO_CTRL_VOLUME_DOWN);
-                    }
-                    else if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_MUTE) {
-                        params["command"] = string(CMD_AUDIO_CTRL_MUTE);
-                    }
-                    else if (eventMsg.m_mediaInfo.m_mediaDevStatus.m_enmediaCtrlCmd == BTRMGR_MEDIA_CTRL_UNMUTE) {
-                        params["command"] = string(CMD_AUDIO_CTRL_UNMUTE);
-                    }
-                    else {
-                        params["command"] = string(CMD_AUDIO_CTRL_UNKNOWN);
+                    result = m_playbackProgressTimer.Reschedule(nextDueMs);
+                    m_playbackProgressTimer.Unlock();
+                    break;
+                }
+                case EventTimer::DISCOVERY_BATCH: {
+                    std::vector<DiscoveredDeviceUpdate> batch;
+
+                    m_discoveryBatchTimer.Lock();
+                    // A batch filled up to the size limit is flushed early, the timer may then
+                    // find the window of a newer batch still open and waits for it.
+                    const uint64_t remainingMs = m_discoveryBatcher.remaining(monotonicTimeMs());
+                    if ((0 == remainingMs) && !m_discoveryBatcher.empty()) {
+                        m_discoveryBatcher.take(batch);
+                        notifyDiscoveryBatch(batch);
                     }
-
-                    eventId = EVT_DEVICE_MEDIA_STATUS;
+                    result = m_discoveryBatchTimer.Reschedule(remainingMs);
+                    m_discoveryBatchTimer.Unlock();
                     break;
+                }
+                case EventTimer::CONNECTION_SETTLE: {
+                    std::vector<BTRMGR_EventMessage_t> due;
 
-                // TODO: implement or delete these values from enum
-                case BTRMGR_EVENT_MAX:
-                    break;
-                case BTRMGR_EVENT_DEVICE_OP_READY:
-                    break;
-                case BTRMGR_EVENT_DEVICE_OP_INFORMATION:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_NAME:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_VOLUME:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_EQUALIZER_OFF:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_EQUALIZER_ON:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_SHUFFLE_OFF:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_SHUFFLE_ALLTRACKS:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_SHUFFLE_GROUP:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_REPEAT_OFF:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_REPEAT_SINGLETRACK:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_REPEAT_ALLTRACKS:
-                    break;
-                case BTRMGR_EVENT_MEDIA_PLAYER_REPEAT_GROUP:
-                    break;
-                case BTRMGR_EVENT_MEDIA_ALBUM_INFO:
-                    break;
-                case BTRMGR_EVENT_MEDIA_ARTIST_INFO:
-                    break;
-                case BTRMGR_EVENT_MEDIA_GENRE_INFO:
+                    m_connectionSettleTimer.Lock();
+                    const uint64_t nextDueMs = m_connectionDebouncer.takeDue(monotonicTimeMs(), due);
+                    for (const BTRMGR_EventMessage_t& heldEvent : due) {
+                        notifyDescriptorEvent(*eventDescriptor(heldEvent.m_eventType), heldEvent, monotonicTimeUs());
+                    }
+                    result = m_connectionSettleTimer.Reschedule(nextDueMs);
+                    m_connectionSettleTimer.Unlock();
                     break;
-                case BTRMGR_EVENT_MEDIA_COMPILATION_INFO:
+                }
+                case EventTimer::DEVICE_REGISTRY: {
+                    uint32_t mismatches = 0;
+                    (void)reconcileDeviceRegistry(mismatches);
+                    result = Core::Time::Now().Add(m_deviceRegistryInterval).Ticks();
                     break;
-                case BTRMGR_EVENT_MEDIA_PLAYLIST_INFO:
+                }
+                case EventTimer::BACKGROUND_DISCOVERY: {
+                    result = runBackgroundDiscovery(scheduledTime);
                     break;
-                case BTRMGR_EVENT_MEDIA_TRACKLIST_INFO:
+                }
+                case EventTimer::DISCOVERY_INDEX: {
+                    result = expireDiscoveryIndex();
                     break;
+                }
                 default:
                     break;
             }
 
-            if (!eventId.empty())
-            {
-                sendNotify(C_STR(eventId), params);
-            }
+            return result;
         }
         //
         /// Internal methods end
@@ -1445,29 +2483,60 @@ namespace WPEFramework
             {
                 getStringParameter("profile", profile);
                 profileDefined = true;
+                if (!checkProfiles(profile, response))
+                {
+                    LOGERR("Unknown profile in '%s', no scan started", profile.c_str());
+                    returnResponse(false);
+                }
+            }
+            BluetoothDiscoveryMatcher::Target target;
+            const BluetoothDiscoveryMatcher::Target* targetPtr = nullptr;
+            if (parameters.HasLabel("match"))
+            {
+                // A targeted scan needs a session to end, so it needs a timeout.
+                if (!timeoutDefined || (timeout <= 0) || !parseDiscoveryTarget(parameters["match"].Object(), target))
+                {
+                    LOGERR("Please specify a timeout and match criteria. Example: \"params\": {\"timeout\": 10, \"match\": {\"name\": \"speaker\"}}");
+                    returnResponse(false);
+                }
+                targetPtr = &target;
             }
+            BluetoothDiscoverySessions::SessionId sessionId = 0;
             if (timeoutDefined && profileDefined)
             {
                 LOGINFO("Making a call with timeout=%d sec profile=%s", timeout, profile.c_str());
-                response["status"] = startDeviceDiscovery(timeout, profile);
-                successFlag = true;
+                const string status = startDeviceDiscovery(timeout, sessionId, profile, targetPtr);
+                response["status"] = status;
+                successFlag = (STATUS_DISCOVERY_FAILED != status);
             } else if (timeoutDefined) {
                 LOGINFO("Making a call with timeout=%d sec", timeout);
-                response["status"] = startDeviceDiscovery(timeout);
-                successFlag = true;
+                const string status = startDeviceDiscovery(timeout, sessionId, BLUETOOTH_DEFAULT_DISCOVERY_PROFILE, targetPtr);
+                response["status"] = status;
+                successFlag = (STATUS_DISCOVERY_FAILED != status);
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"timeout\": \"5\", \"profile\": \"SMARTPHONE\"}");
                 successFlag = false;
             }
+            if (0 != sessionId)
+            {
+                response["sessionID"] = sessionId;
+            }
             returnResponse(successFlag);
         }
 
         uint32_t Bluetooth::stopScanWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
-            UNUSED(parameters);
-            stopDeviceDiscovery();
-            returnResponse(true);
+            bool successFlag = true;
+            if (parameters.HasLabel("sessionID"))
+            {
+                BluetoothDiscoverySessions::SessionId sessionId = 0;
+                getNumberParameter("sessionID", sessionId);
+                successFlag = releaseDiscoverySession(sessionId);
+            } else {
+                stopDeviceDiscovery();
+            }
+            returnResponse(successFlag);
         }
 
         uint32_t Bluetooth::isDiscoverableWrapper(const JsonObject& parameters, JsonObject& response)
@@ -1507,25 +2576,127 @@ namespace WPEFramework
         uint32_t Bluetooth::getDiscoveredDevicesWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
-            UNUSED(parameters);
-            response["discoveredDevices"] = getDiscoveredDevices();
+            BluetoothDeviceQuery query;
+            if (!parseDeviceQuery(parameters, query)) {
+                returnResponse(false);
+            }
+
+            uint32_t total = 0;
+            response["discoveredDevices"] = getDiscoveredDevices(query, &total);
+            if (!query.empty()) {
+                response["total"] = total;
+            }
             returnResponse(true);
         }
 
+        bool Bluetooth::respondDeviceList(BluetoothDeviceRegistry::List list, const char* label, const JsonObject& parameters, JsonObject& response)
+        {
+            const bool wantsDelta = parameters.HasLabel("since");
+            uint64_t since = 0;
+            if (wantsDelta) {
+                getNumberParameter("since", since);
+            }
+
+            std::vector<RegisteredDevice> devices;
+            std::vector<RegisteredDevice> addedDevices;
+            std::vector<RegisteredDevice> changedDevices;
+            std::vector<BTRMgrDeviceHandle> added;
+            std::vector<BTRMgrDeviceHandle> changed;
+            std::vector<BTRMgrDeviceHandle> removed;
+            uint64_t generation = 0;
+            bool listed = false;
+            bool delta = false;
+
+            // The registry advances the generation as events change the list, a poll needs no BTRMGR query
+            // and a delta copies only the devices that changed.
+            if (0 != m_deviceRegistryInterval) {
+                m_deviceRegistryLock.Lock();
+                listed = m_deviceRegistry.seeded(list);
+                if (listed) {
+                    const BluetoothDeviceListTracker& tracker = m_deviceRegistry.tracker(list);
+                    generation = tracker.generation();
+                    delta = wantsDelta && tracker.delta(since, added, changed, removed);
+                    if (delta) {
+                        m_deviceRegistry.devices(list, added, addedDevices);
+                        m_deviceRegistry.devices(list, changed, changedDevices);
+                    } else {
+                        m_deviceRegistry.devices(list, devices);
+                    }
+                }
+                m_deviceRegistryLock.Unlock();
+            }
+
+            // Without the registry the list read from BTRMGR is compared with the previous read.
+            if (!listed) {
+                BluetoothDeviceListTracker& tracker = (BluetoothDeviceRegistry::LIST_PAIRED == list) ? m_pairedDeviceList : m_connectedDeviceList;
+                listed = readDeviceList(list, devices);
+
+                std::vector<BluetoothDeviceListTracker::Device> fingerprints;
+                fingerprints.reserve(devices.size());
+                for (const RegisteredDevice& device : devices) {
+                    fingerprints.emplace_back(device.deviceHandle, BluetoothDeviceRegistry::fingerprint(device, list));
+                }
+
+                m_deviceListLock.Lock();
+                if (listed) {
+                    tracker.sync(fingerprints);
+                }
+                generation = tracker.generation();
+                delta = listed && wantsDelta && tracker.delta(since, added, changed, removed);
+                m_deviceListLock.Unlock();
+
+                if (delta) {
+                    BluetoothHandleMap<bool /* added */> changes;
+                    changes.reserve(added.size() + changed.size());
+                    for (const BTRMgrDeviceHandle deviceHandle : added) {
+                        changes[deviceHandle] = true;
+                    }
+                    for (const BTRMgrDeviceHandle deviceHandle : changed) {
+                        changes[deviceHandle] = false;
+                    }
+                    for (RegisteredDevice& device : devices) {
+                        auto it = changes.find(device.deviceHandle);
+                        if (it != changes.end()) {
+                            (it->second ? addedDevices : changedDevices).push_back(std::move(device));
+                        }
+                    }
+                }
+            }
+
+            if (wantsDelta && !listed) {
+                LOGERR("No device list to compute a delta from");
+                return false;
+            }
+
+            response["generation"] = generation;
+            if (wantsDelta) {
+                response["delta"] = delta;
+            }
+            if (!delta) {
+                response[label] = encodeListedDevices(list, devices);
+                return true;
+            }
+
+            JsonArray removedDevices;
+            for (const BTRMgrDeviceHandle deviceHandle : removed) {
+                removedDevices.Add(std::to_string(deviceHandle));
+            }
+            response["added"] = encodeListedDevices(list, addedDevices);
+            response["changed"] = encodeListedDevices(list, changedDevices);
+            response["removed"] = removedDevices;
+            return true;
+        }
+
         uint32_t Bluetooth::getPairedDevicesWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
-            UNUSED(parameters);
-            response["pairedDevices"] = getPairedDevices();
-            returnResponse(true);
+            returnResponse(respondDeviceList(BluetoothDeviceRegistry::LIST_PAIRED, "pairedDevices", parameters, response));
         }
 
         uint32_t Bluetooth::getConnectedDevicesWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
-            UNUSED(parameters);
-            response["connectedDevices"] = getConnectedDevices();
-            returnResponse(true);
+            returnResponse(respondDeviceList(BluetoothDeviceRegistry::LIST_CONNECTED, "connectedDevices", parameters, response));
         }
 
         uint32_t Bluetooth::connectWrapper(const JsonObject& parameters, JsonObject& response)
@@ -1556,10 +2727,13 @@ namespace WPEFramework
             if (deviceIDDefined && deviceTypeDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu enable=%s deviceType=%s", deviceID, "CONNECT", deviceType.c_str());
-                successFlag = setDeviceConnection(deviceID, true, deviceType);
+                const BluetoothDeviceCategory category = bluetoothDeviceCategoryFromString(deviceType);
+                successFlag = runDeviceOperation(parameters, METHOD_CONNECT, deviceID,
+                    [this, deviceID, category]() { return setDeviceConnection(deviceID, true, category); }, response);
             } else if (deviceIDDefined) {
                 LOGINFO("Making a call with deviceID=%llu enable=%s", deviceID, "CONNECT");
-                successFlag = setDeviceConnection(deviceID, true);
+                successFlag = runDeviceOperation(parameters, METHOD_CONNECT, deviceID,
+                    [this, deviceID]() { return setDeviceConnection(deviceID, true); }, response);
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\"}");
                 successFlag = false;
@@ -1595,10 +2769,13 @@ namespace WPEFramework
             if (deviceIDDefined && deviceTypeDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu enable=%s deviceType=%s", deviceID, "DISCONNECT", deviceType.c_str());
-                successFlag = setDeviceConnection(deviceID, false, deviceType);
+                const BluetoothDeviceCategory category = bluetoothDeviceCategoryFromString(deviceType);
+                successFlag = runDeviceOperation(parameters, METHOD_DISCONNECT, deviceID,
+                    [this, deviceID, category]() { return setDeviceConnection(deviceID, false, category); }, response);
             } else if (deviceIDDefined) {
                 LOGINFO("Making a call with deviceID=%llu enable=%s", deviceID, "DISCONNECT");
-                successFlag = setDeviceConnection(deviceID, false);
+                successFlag = runDeviceOperation(parameters, METHOD_DISCONNECT, deviceID,
+                    [this, deviceID]() { return setDeviceConnection(deviceID, false); }, response);
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\"}");
                 successFlag = false;
@@ -1631,7 +2808,8 @@ namespace WPEFramework
             if (deviceIDDefined && audioStreamNameDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu audioStreamName=%s", deviceID, audioStreamName.c_str());
-                successFlag = setAudioStream(deviceID, audioStreamName);
+                successFlag = m_operationExecutor.execute(METHOD_SET_AUDIO_STREAM, (BTRMgrDeviceHandle) deviceID,
+                    [this, deviceID, &audioStreamName]() { return setAudioStream(deviceID, audioStreamName); });
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\", \"audioStreamName\": \"PRIMARY\"}");
                 successFlag = false;
@@ -1657,7 +2835,8 @@ namespace WPEFramework
             if(deviceIDDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu pair=%s", deviceID, pair?"true":"false");
-                successFlag = setDevicePairing(deviceID, pair);
+                successFlag = runDeviceOperation(parameters, METHOD_PAIR, deviceID,
+                    [this, deviceID, pair]() { return setDevicePairing(deviceID, pair); }, response);
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\"}");
                 successFlag = false;
@@ -1683,7 +2862,8 @@ namespace WPEFramework
             if(deviceIDDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu pair=%s", deviceID, pair?"true":"false");
-                successFlag = setDevicePairing(deviceID, pair);
+                successFlag = runDeviceOperation(parameters, METHOD_UNPAIR, deviceID,
+                    [this, deviceID, pair]() { return setDevicePairing(deviceID, pair); }, response);
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\"}");
                 successFlag = false;
@@ -1751,7 +2931,8 @@ namespace WPEFramework
             if (deviceIDDefined && audioCtrlCmdDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu audioCtrlCmd=%s", deviceID, audioCtrlCmd.c_str());
-                successFlag = setAudioControlCommand(deviceID, audioCtrlCmd);
+                successFlag = m_operationExecutor.execute(METHOD_SET_AUDIO_PLAYBACK_COMMAND, (BTRMgrDeviceHandle) deviceID,
+                    [this, deviceID, &audioCtrlCmd]() { return setAudioControlCommand(deviceID, audioCtrlCmd); });
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\", \"command\": \"PLAY\"}");
                 successFlag = false;
@@ -1780,12 +2961,22 @@ namespace WPEFramework
             {
                 getStringParameter("deviceType", deviceTypeStr);
                 deviceTypeDefined = true;
+                // Device type names the profile table does not know keep the audio output volume.
+                (void)checkProfiles(deviceTypeStr, response);
             }
             if (deviceIDDefined && deviceTypeDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu ", deviceID);
                 response ["volumeinfo"] = getDeviceVolumeMuteProperties(deviceID, deviceTypeStr);
                 successFlag = true;
+            } else if (parameters.HasLabel("deviceIDs") && deviceTypeDefined) {
+                JsonObject volumeInfos;
+                successFlag = lookupDevices(parameters, [this, &deviceTypeStr](long long int id, JsonObject& volumeInfo) {
+                    return readDeviceVolumeMuteProperties(id, deviceTypeStr, volumeInfo);
+                }, volumeInfos);
+                if (successFlag) {
+                    response["volumeinfos"] = volumeInfos;
+                }
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\", \"deviceType\": \"HEADPHONES\"}");
                 successFlag = false;
@@ -1820,6 +3011,8 @@ namespace WPEFramework
             {
                 getStringParameter("deviceType", deviceTypeStr);
                 deviceTypeDefined = true;
+                // Device type names the profile table does not know keep the audio output volume.
+                (void)checkProfiles(deviceTypeStr, response);
             }
             if (parameters.HasLabel("volume"))
             {
@@ -1837,10 +3030,14 @@ namespace WPEFramework
             if (deviceIDDefined && deviceTypeDefined && volumeDefined && muteDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu ", deviceID);
-                successFlag = setDeviceVolumeMuteProperties(deviceID, deviceTypeStr, ui8volume, mute);
-                if (successFlag) {
-                    m_bluetoothDeviceManager.setLastVolumeSetting(deviceIDStr, static_cast<long long>(ui8volume));
-                }
+                successFlag = m_operationExecutor.execute(METHOD_SET_DEVICE_VOLUME_MUTE_INFO, (BTRMgrDeviceHandle) deviceID,
+                    [this, deviceID, &deviceTypeStr, ui8volume, mute]() {
+                        if (!setDeviceVolumeMuteProperties(deviceID, deviceTypeStr, ui8volume, mute)) {
+                            return false;
+                        }
+                        m_bluetoothDeviceManager.setLastVolumeSetting(static_cast<BTRMgrDeviceHandle>(deviceID), static_cast<long long>(ui8volume));
+                        return true;
+                    });
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\", \"deviceType\": \"HEADPHONES\", \"volume\": \"0-255\", \"mute\": \"0-1\"}");
                 successFlag = false;
@@ -1882,6 +3079,7 @@ namespace WPEFramework
             if(deviceIDDefined && responseValueDefined && eventTypeDefined)
             {
                 LOGINFO("Making a call with deviceID=%llu eventType=%s responseValue=%s", deviceID, C_STR(eventType), C_STR(responseValue));
+                // Not queued behind the device: a pairing request is answered while its pair job runs.
                 successFlag = setEventResponse(deviceID, eventType, responseValue);
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\", \"eventType\": \"pairingRequest\", \"responseValue\": \"ACCEPTED\"}");
@@ -1903,6 +3101,14 @@ namespace WPEFramework
                 deviceID = stoll(deviceIDStr);
                 response["deviceInfo"] = getDeviceInfo(deviceID);
                 successFlag = true;
+            } else if (parameters.HasLabel("deviceIDs")) {
+                JsonObject deviceInfos;
+                successFlag = lookupDevices(parameters, [this](long long int id, JsonObject& deviceDetails) {
+                    return readDeviceInfo(id, deviceDetails);
+                }, deviceInfos);
+                if (successFlag) {
+                    response["deviceInfos"] = deviceInfos;
+                }
             } else {
                 LOGERR("Please specify parameters. Example: \"params\": {\"deviceID\": \"271731989589742\"}");
                 successFlag = false;
@@ -1939,11 +3145,16 @@ namespace WPEFramework
             {
                 getStringParameter("deviceID", deviceID);
                 getBoolParameter("enable", enable);
-                Core::hresult result = m_bluetoothDeviceManager.setAutoConnect(deviceID, enable);
+                BTRMgrDeviceHandle deviceHandle = 0;
+                Core::hresult result = Core::ERROR_INVALID_PARAMETER;
+                if (parseDeviceHandle(deviceID, deviceHandle)) {
+                    result = m_bluetoothDeviceManager.setAutoConnect(deviceHandle, enable);
+                }
                 if (Core::ERROR_NONE != result) {
                     LOGERR("Failed to set autoConnect status for deviceID=%s, result=0x%08X", deviceID.c_str(), result);
                     successFlag = false;
                 } else {
+                    touchListedDevice(deviceHandle);
                     notifyAutoConnectStatusChanged(deviceID, enable);
                 }
             } else {
@@ -1963,7 +3174,11 @@ namespace WPEFramework
             {
                 getStringParameter("deviceID", deviceID);
                 AutoConnectStatus status;
-                Core::hresult result = m_bluetoothDeviceManager.getAutoConnect(deviceID, status);
+                BTRMgrDeviceHandle deviceHandle = 0;
+                Core::hresult result = Core::ERROR_INVALID_PARAMETER;
+                if (parseDeviceHandle(deviceID, deviceHandle)) {
+                    result = m_bluetoothDeviceManager.getAutoConnect(deviceHandle, status);
+                }
 
                 if (Core::ERROR_NONE == result) {
                     response["autoconnect"] = (AUTO_CONNECT_STATUS_ENABLED == status);
@@ -1978,6 +3193,348 @@ namespace WPEFramework
             returnResponse(successFlag);
         }
 
+        static JsonObject latencySummary(const BluetoothLatencyHistogram& histogram)
+        {
+            JsonObject latency;
+            latency["count"] = histogram.count();
+            latency["p50"] = histogram.percentile(50);
+            latency["p95"] = histogram.percentile(95);
+            latency["p99"] = histogram.percentile(99);
+            latency["max"] = histogram.max();
+            return latency;
+        }
+
+        uint32_t Bluetooth::getEventStatsWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            bool reset = false;
+            if (parameters.HasLabel("reset")) {
+                getBoolParameter("reset", reset);
+            }
+
+            JsonArray events;
+
+            m_eventStatsLock.Lock();
+            for (int type = 0; type < BTRMGR_EVENT_MAX; ++type) {
+                const BTRMGR_Events_t eventType = static_cast<BTRMGR_Events_t>(type);
+                const EventDescriptor* descriptor = eventDescriptor(eventType);
+                if ((nullptr == descriptor) || (nullptr == m_eventStats.histogram(eventType, BluetoothEventStats::STAGE_QUEUE))) {
+                    continue;
+                }
+
+                JsonObject event;
+                event["eventType"] = type;
+                event["name"] = string(descriptor->name);
+                if (nullptr != descriptor->eventId) {
+                    event["event"] = *descriptor->eventId;
+                }
+                for (int stage = 0; stage < BluetoothEventStats::STAGE_COUNT; ++stage) {
+                    const BluetoothLatencyHistogram* histogram = m_eventStats.histogram(eventType, static_cast<BluetoothEventStats::Stage>(stage));
+                    event[BluetoothEventStats::stageName(static_cast<BluetoothEventStats::Stage>(stage))] = latencySummary(*histogram);
+                }
+                events.Add(event);
+            }
+
+            JsonArray lanes;
+            for (int index = 0; index < BluetoothEventQueue::LANE_COUNT; ++index) {
+                const BluetoothEventQueue::Lane lane = static_cast<BluetoothEventQueue::Lane>(index);
+                JsonObject laneStats;
+                laneStats["lane"] = string(BluetoothEventQueue::laneName(lane));
+                laneStats["size"] = m_eventQueue.size(lane);
+                laneStats["highWatermark"] = m_eventQueue.highWatermark(lane);
+                laneStats["enqueued"] = m_eventQueue.enqueued(lane);
+                laneStats["dropped"] = m_eventQueue.dropped(lane);
+                laneStats["overflows"] = m_eventQueue.overflows(lane);
+                laneStats["wait"] = latencySummary(m_laneWait[lane]);
+                lanes.Add(laneStats);
+            }
+
+            if (reset) {
+                m_eventStats.reset();
+                for (BluetoothLatencyHistogram& histogram : m_laneWait) {
+                    histogram.reset();
+                }
+            }
+            m_eventStatsLock.Unlock();
+
+            JsonObject queue;
+            queue["depth"] = m_eventQueue.depth();
+            queue["size"] = m_eventQueue.size();
+            queue["highWatermark"] = m_eventQueue.highWatermark();
+            queue["enqueued"] = m_eventQueue.enqueued();
+            queue["dropped"] = m_eventQueue.dropped();
+            queue["overflows"] = m_eventQueue.overflows();
+            queue["lanes"] = lanes;
+
+            std::map<BTRMgrDeviceHandle, uint32_t> flaps;
+            m_connectionSettleTimer.Lock();
+            m_connectionDebouncer.flaps(flaps);
+            m_connectionSettleTimer.Unlock();
+
+            JsonArray connectionFlaps;
+            for (const auto& entry : flaps) {
+                JsonObject device;
+                device["deviceID"] = std::to_string(entry.first);
+                device["flaps"] = entry.second;
+                connectionFlaps.Add(device);
+            }
+
+            std::vector<BluetoothOperationExecutor::DeviceStats> queueStats;
+            m_operationExecutor.deviceStats(queueStats);
+            if (reset) {
+                m_operationExecutor.resetStats();
+            }
+
+            JsonArray operationQueues;
+            for (const BluetoothOperationExecutor::DeviceStats& entry : queueStats) {
+                JsonObject device;
+                device["deviceID"] = std::to_string(entry.deviceHandle);
+                device["depth"] = entry.depth;
+                device["running"] = entry.running;
+                device["started"] = entry.started;
+                device["averageWaitMs"] = (0 != entry.started) ? (entry.totalWaitMs / entry.started) : 0;
+                device["maxWaitMs"] = entry.maxWaitMs;
+                operationQueues.Add(device);
+            }
+
+            response["events"] = events;
+            response["queue"] = queue;
+            response["connectionFlaps"] = connectionFlaps;
+            response["operationQueues"] = operationQueues;
+            response["listBuffers"] = listBufferStats();
+            if (0 != m_deviceRegistryInterval) {
+                response["deviceRegistry"] = deviceRegistryStatus();
+            }
+            if (m_discoveryIndex.enabled()) {
+                JsonObject discoveryIndex;
+                m_discoveryIndexTimer.Lock();
+                discoveryIndex["size"] = static_cast<uint32_t>(m_discoveryIndex.size());
+                discoveryIndex["expired"] = m_discoveryIndex.expired();
+                discoveryIndex["evicted"] = m_discoveryIndex.evicted();
+                m_discoveryIndexTimer.Unlock();
+                response["discoveryIndex"] = discoveryIndex;
+            }
+            returnResponse(true);
+        }
+
+        uint32_t Bluetooth::getEventsSinceWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            uint64_t since = 0;
+            if (parameters.HasLabel("sequence")) {
+                getNumberParameter("sequence", since);
+            }
+
+            std::vector<BluetoothEventJournal::Entry> entries;
+
+            m_eventJournalLock.Lock();
+            const bool complete = m_eventJournal.since(since, entries);
+            const uint64_t sequence = m_eventJournal.sequence();
+            const uint64_t oldest = m_eventJournal.oldest();
+            m_eventJournalLock.Unlock();
+
+            JsonArray events;
+            for (const BluetoothEventJournal::Entry& entry : entries) {
+                JsonObject event;
+                event["sequence"] = entry.sequence;
+                event["event"] = entry.event;
+                event["params"] = entry.params;
+                events.Add(event);
+            }
+
+            response["events"] = events;
+            response["sequence"] = sequence;
+            response["oldestSequence"] = oldest;
+            response["truncated"] = !complete;
+            returnResponse(true);
+        }
+
+        JsonArray Bluetooth::listBufferStats()
+        {
+            JsonArray pools;
+            auto addPool = [&pools](const char* list, uint64_t hits, uint64_t misses, uint32_t pooled) {
+                JsonObject pool;
+                pool["list"] = string(list);
+                pool["hits"] = hits;
+                pool["misses"] = misses;
+                pool["pooled"] = pooled;
+                pools.Add(pool);
+            };
+            addPool("discovered", BluetoothListBuffers::discovered().hits(), BluetoothListBuffers::discovered().misses(),
+                BluetoothListBuffers::discovered().pooled());
+            addPool("paired", BluetoothListBuffers::paired().hits(), BluetoothListBuffers::paired().misses(),
+                BluetoothListBuffers::paired().pooled());
+            addPool("connected", BluetoothListBuffers::connected().hits(), BluetoothListBuffers::connected().misses(),
+                BluetoothListBuffers::connected().pooled());
+            return pools;
+        }
+
+        JsonObject Bluetooth::deviceRegistryStatus()
+        {
+            JsonArray lists;
+
+            m_deviceRegistryLock.Lock();
+            for (int index = 0; index < BluetoothDeviceRegistry::LIST_COUNT; ++index) {
+                const BluetoothDeviceRegistry::List list = static_cast<BluetoothDeviceRegistry::List>(index);
+                JsonObject listStatus;
+                listStatus["list"] = string(BluetoothDeviceRegistry::listName(list));
+                listStatus["seeded"] = m_deviceRegistry.seeded(list);
+                listStatus["devices"] = m_deviceRegistry.size(list);
+                listStatus["mismatches"] = m_deviceRegistry.mismatches(list);
+                lists.Add(listStatus);
+            }
+            JsonObject status;
+            status["interval"] = m_deviceRegistryInterval;
+            status["reconciliations"] = m_deviceRegistry.reconciliations();
+            status["mismatches"] = m_deviceRegistry.mismatches();
+            m_deviceRegistryLock.Unlock();
+
+            status["lists"] = lists;
+            return status;
+        }
+
+        uint32_t Bluetooth::reconcileDevicesWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            UNUSED(parameters);
+            if (0 == m_deviceRegistryInterval) {
+                LOGERR("Device registry is disabled");
+                returnResponse(false);
+            }
+
+            uint32_t mismatches = 0;
+            const bool result = reconcileDeviceRegistry(mismatches);
+            response["corrected"] = mismatches;
+            response["deviceRegistry"] = deviceRegistryStatus();
+            returnResponse(result);
+        }
+
+        uint32_t Bluetooth::getDeviceSnapshotWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            UNUSED(parameters);
+            JsonArray devices;
+            const bool result = getDeviceSnapshot(devices);
+            if (result) {
+                response["devices"] = devices;
+            }
+            returnResponse(result);
+        }
+
+        uint32_t Bluetooth::setBackgroundDiscoveryWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            bool enable = false;
+            string profile = BLUETOOTH_DEFAULT_DISCOVERY_PROFILE;
+            uint32_t scanWindowMs = 0;
+            uint32_t minIdleMs = 0;
+            uint32_t maxIdleMs = 0;
+
+            if (!parameters.HasLabel("enable")) {
+                LOGERR("Please specify parameters. Example (the others are optional): \"params\": {\"enable\": true, \"profile\": \"HEADPHONES\", \"scanWindowMs\": 4000, \"minIdleMs\": 8000, \"maxIdleMs\": 120000}");
+                returnResponse(false);
+            }
+            getBoolParameter("enable", enable);
+            if (parameters.HasLabel("profile")) {
+                getStringParameter("profile", profile);
+                if (!checkProfiles(profile, response)) {
+                    LOGERR("Unknown profile in '%s', background discovery unchanged", profile.c_str());
+                    returnResponse(false);
+                }
+            }
+            if (parameters.HasLabel("scanWindowMs")) {
+                getNumberParameter("scanWindowMs", scanWindowMs);
+            }
+            if (parameters.HasLabel("minIdleMs")) {
+                getNumberParameter("minIdleMs", minIdleMs);
+            }
+            if (parameters.HasLabel("maxIdleMs")) {
+                getNumberParameter("maxIdleMs", maxIdleMs);
+            }
+
+            m_backgroundDiscoveryLock.Lock();
+            m_backgroundDiscoveryEnabled = enable;
+            m_backgroundDiscoveryTicks = 0;
+            if (enable) {
+                m_discoveryDutyCycle.setLimits(scanWindowMs, minIdleMs, maxIdleMs);
+                m_discoveryDutyCycle.reset();
+                m_backgroundDiscoveryType = bluetoothDiscoveryOperationType(bluetoothDiscoveryProfiles(profile));
+
+                // The first window opens right away; the timer of an earlier setting ends when it fires.
+                const Core::Time due = Core::Time::Now();
+                m_backgroundDiscoveryTicks = due.Ticks();
+                _eventTimer.Schedule(due, m_backgroundDiscoveryTimer);
+            }
+            m_backgroundDiscoveryLock.Unlock();
+
+            returnResponse(true);
+        }
+
+        uint32_t Bluetooth::getBackgroundDiscoveryWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            UNUSED(parameters);
+
+            m_backgroundDiscoveryLock.Lock();
+            response["enabled"] = m_backgroundDiscoveryEnabled;
+            response["scanWindowMs"] = m_discoveryDutyCycle.current().scanMs;
+            response["idleWindowMs"] = m_discoveryDutyCycle.current().idleMs;
+            response["cycles"] = m_discoveryDutyCycle.cycles();
+            response["backgroundScanningMs"] = m_discoveryDutyCycle.scanningMs();
+            m_backgroundDiscoveryLock.Unlock();
+
+            m_discoveryLock.Lock();
+            response["scanningMs"] = m_discoveryScanningMs + (m_discoveryRunning ? (monotonicTimeMs() - m_discoveryStartedMs) : 0);
+            m_discoveryLock.Unlock();
+
+            returnResponse(true);
+        }
+
+        uint32_t Bluetooth::getOperationStatusWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            if (!parameters.HasLabel("jobID")) {
+                LOGERR("Please specify parameters. Example: \"params\": {\"jobID\": 1}");
+                returnResponse(false);
+            }
+            BluetoothOperationExecutor::JobId jobId = 0;
+            getNumberParameter("jobID", jobId);
+
+            BluetoothOperationExecutor::Job job;
+            if (!m_operationExecutor.status(jobId, job)) {
+                LOGERR("Operation %u is unknown or no longer kept", jobId);
+                returnResponse(false);
+            }
+
+            response["jobID"] = job.id;
+            response["operation"] = job.operation;
+            response["deviceID"] = std::to_string(job.deviceHandle);
+            response["state"] = BluetoothOperationExecutor::stateName(job.state);
+            if (0 != job.finishedMs) {
+                response["durationMs"] = (0 != job.startedMs) ? (job.finishedMs - job.startedMs) : 0;
+            }
+            returnResponse(true);
+        }
+
+        uint32_t Bluetooth::cancelOperationWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            if (!parameters.HasLabel("jobID")) {
+                LOGERR("Please specify parameters. Example: \"params\": {\"jobID\": 1}");
+                returnResponse(false);
+            }
+            BluetoothOperationExecutor::JobId jobId = 0;
+            getNumberParameter("jobID", jobId);
+
+            const Core::hresult result = m_operationExecutor.cancel(jobId);
+            if (Core::ERROR_ILLEGAL_STATE == result) {
+                LOGERR("Operation %u already started, it cannot be cancelled", jobId);
+            } else if (Core::ERROR_NONE != result) {
+                LOGERR("Operation %u is unknown or no longer kept", jobId);
+            }
+            returnResponse(Core::ERROR_NONE == result);
+        }
+
         //
         /// Registered methods end
 
@@ -2007,6 +3564,10 @@ namespace WPEFramework
 
         void Bluetooth::onPowerModeChanged(const WPEFramework::Exchange::IPowerManager::PowerState currentState, const WPEFramework::Exchange::IPowerManager::PowerState newState)
         {
+            m_backgroundDiscoveryLock.Lock();
+            m_powerState = newState;
+            m_backgroundDiscoveryLock.Unlock();
+
             #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
                 if (!m_bluetoothDeviceManager.isMigrated()) {
                     return;
@@ -2042,46 +3603,43 @@ namespace WPEFramework
                     WPEFramework::Exchange::IPowerManager::PowerState::POWER_STATE_STANDBY == newState ||
                     WPEFramework::Exchange::IPowerManager::PowerState::POWER_STATE_STANDBY_LIGHT_SLEEP == newState)) {
 
-                std::unordered_map<std::string, BluetoothDeviceInfo> pairedDeviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
+                const BluetoothDeviceInfoMap pairedDeviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
 
                 for (const auto& entry : pairedDeviceInfos) {
-                    const std::string& deviceIdStr = entry.first;
+                    const BTRMgrDeviceHandle deviceHandle = entry.first;
                     const BluetoothDeviceInfo& deviceInfo = entry.second;
-                    LOGINFO("pairedDeviceInfos[%s] = { deviceType=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s }\n",
-                            deviceIdStr.c_str(), deviceInfo.deviceType.c_str(), static_cast<int>(deviceInfo.autoConnectStatus), deviceInfo.lastConnectTimeUtc.c_str());
+                    LOGINFO("pairedDeviceInfos[%llu] = { deviceType=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s }\n",
+                            deviceHandle, bluetoothDeviceTypeName(deviceInfo.deviceType), static_cast<int>(deviceInfo.autoConnectStatus), deviceInfo.lastConnectTimeUtc.c_str());
 
-                    if (deviceInfo.deviceType == "HUMAN INTERFACE DEVICE") {
+                    if (isHumanInterfaceDevice(deviceInfo.deviceType)) {
                         // Don't disconnect RCU devices on power off/standby, as they are needed to wake up the device.
                         continue;
                     }
 
                     if (deviceInfo.autoConnectStatus == AutoConnectStatus::AUTO_CONNECT_STATUS_DISABLED) {
                         // Only disconnect if autoConnect was explicitly set false to preserve backward compatibility.
-                        try {
-                            long long int deviceId = stoll(deviceIdStr);
-                            bool bSuccess = setDeviceConnection(deviceId, false, deviceInfo.deviceType);
-                            LOGINFO("POWER OFF/STANDBY: Disconnecting deviceID=%lld, success=%s\n", deviceId, bSuccess ? "true" : "false");
-                        } catch (const std::exception& e) {
-                            LOGERR("Failed to parse deviceId: %s\n", e.what());
-                        }
+                        const BluetoothDeviceCategory category = bluetoothDeviceCategory(deviceInfo.deviceType);
+                        bool bSuccess = m_operationExecutor.execute(METHOD_DISCONNECT, deviceHandle,
+                            [this, deviceHandle, category]() { return setDeviceConnection(deviceHandle, false, category); });
+                        LOGINFO("POWER OFF/STANDBY: Disconnecting deviceID=%llu, success=%s\n", deviceHandle, bSuccess ? "true" : "false");
                     }
                 }
             }
             // X --> ON
             else if (WPEFramework::Exchange::IPowerManager::PowerState::POWER_STATE_ON == newState ) {
-                std::unordered_map<std::string, BluetoothDeviceInfo> pairedDeviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
+                const BluetoothDeviceInfoMap pairedDeviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
 
                 LOGINFO("pairedDeviceInfos.size()=%zu\n", pairedDeviceInfos.size());
 
                 uint16_t pairedDevicesCount = 0;
 
                 for (const auto& entry : pairedDeviceInfos) {
-                    const std::string& deviceIdStr = entry.first;
+                    const BTRMgrDeviceHandle deviceHandle = entry.first;
                     const BluetoothDeviceInfo& deviceInfo = entry.second;
-                    LOGINFO("pairedDeviceInfos[%s] = { deviceType=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s }\n",
-                            deviceIdStr.c_str(), deviceInfo.deviceType.c_str(), static_cast<int>(deviceInfo.autoConnectStatus), deviceInfo.lastConnectTimeUtc.c_str());
+                    LOGINFO("pairedDeviceInfos[%llu] = { deviceType=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s }\n",
+                            deviceHandle, bluetoothDeviceTypeName(deviceInfo.deviceType), static_cast<int>(deviceInfo.autoConnectStatus), deviceInfo.lastConnectTimeUtc.c_str());
                     
-                    if (deviceInfo.deviceType != "HUMAN INTERFACE DEVICE") {
+                    if (!isHumanInterfaceDevice(deviceInfo.deviceType)) {
                         ++pairedDevicesCount;
                     }
                 }
@@ -2093,28 +3651,25 @@ namespace WPEFramework
             // X --> DEEP_SLEEP
             else if (WPEFramework::Exchange::IPowerManager::PowerState::POWER_STATE_STANDBY_DEEP_SLEEP == newState ) {
 
-                std::unordered_map<std::string, BluetoothDeviceInfo> pairedDeviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
+                const BluetoothDeviceInfoMap pairedDeviceInfos = m_bluetoothDeviceManager.getPairedDeviceInfos();
 
                 LOGINFO("pairedDeviceInfos.size()=%zu\n", pairedDeviceInfos.size());
 
                 for (const auto& entry : pairedDeviceInfos) {
-                    const std::string& deviceIdStr = entry.first;
+                    const BTRMgrDeviceHandle deviceHandle = entry.first;
                     const BluetoothDeviceInfo& deviceInfo = entry.second;
-                    LOGINFO("pairedDeviceInfos[%s] = { deviceType=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s }\n",
-                            deviceIdStr.c_str(), deviceInfo.deviceType.c_str(), static_cast<int>(deviceInfo.autoConnectStatus), deviceInfo.lastConnectTimeUtc.c_str());
+                    LOGINFO("pairedDeviceInfos[%llu] = { deviceType=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s }\n",
+                            deviceHandle, bluetoothDeviceTypeName(deviceInfo.deviceType), static_cast<int>(deviceInfo.autoConnectStatus), deviceInfo.lastConnectTimeUtc.c_str());
 
-                    if (deviceInfo.deviceType == "HUMAN INTERFACE DEVICE") {
+                    if (isHumanInterfaceDevice(deviceInfo.deviceType)) {
                         // Don't disconnect RCU devices when entering DEEP_SLEEP, as they are needed to wake up the device.
                         continue;
                     }
 
-                    try {
-                        long long int deviceId = std::stoll(deviceIdStr);
-                        bool bSuccess = setDeviceConnection(deviceId, false, deviceInfo.deviceType);
-                        LOGINFO("POWER_STATE_STANDBY_DEEP_SLEEP: Disconnecting deviceId=%lld, success=%s\n", deviceId, bSuccess ? "true" : "false");
-                    } catch (const std::exception& e) {
-                        LOGERR("Failed to parse deviceId: %s\n", e.what());
-                    }
+                    const BluetoothDeviceCategory category = bluetoothDeviceCategory(deviceInfo.deviceType);
+                    bool bSuccess = m_operationExecutor.execute(METHOD_DISCONNECT, deviceHandle,
+                        [this, deviceHandle, category]() { return setDeviceConnection(deviceHandle, false, category); });
+                    LOGINFO("POWER_STATE_STANDBY_DEEP_SLEEP: Disconnecting deviceId=%llu, success=%s\n", deviceHandle, bSuccess ? "true" : "false");
                 }
             } else {
                 LOGWARN("Unhandled transition\n");
@@ -2123,18 +3678,43 @@ namespace WPEFramework
 
         void Bluetooth::notifyAutoConnectStatusChanged(const string& deviceID, const bool enable)
         {
+            const bool replay = m_eventJournal.enabled();
+            if (!replay && !hasSubscribers(EVT_STATUS_CHANGED)) {
+                return;
+            }
+
             JsonObject params;
             params["deviceID"] = deviceID;
             params["autoconnect"] = enable;
             params["newStatus"] = STATUS_AUTOCONNECT_STATUS_CHANGE;
-            sendNotify(C_STR(EVT_STATUS_CHANGED), params);
+            publishEvent(EVT_STATUS_CHANGED, params, replay);
+        }
+
+        void Bluetooth::publishEvent(const string& eventId, JsonObject& params, bool replay)
+        {
+            // Only numbering and journaling are serialized, so notifiers on other threads do not wait for
+            // the sendNotify fan-out of this one. Their notifications may interleave out of sequence order.
+            m_eventJournalLock.Lock();
+            const uint64_t sequence = m_eventJournal.next();
+            params["sequence"] = sequence;
+            if (replay) {
+                m_eventJournal.append(sequence, eventId, params);
+            }
+            m_eventJournalLock.Unlock();
+
+            if (hasSubscribers(eventId)) {
+                sendNotify(C_STR(eventId), params);
+            }
         }
 
         uint64_t DiscoveryTimer::Timed(const uint64_t scheduledTime)
         {
-            uint64_t result = 0;
-            m_bt->onDiscoveryTimer();
-            return(result);
+            return(m_bt->onDiscoveryTimer(scheduledTime));
+        }
+
+        uint64_t EventTimer::Timed(const uint64_t scheduledTime)
+        {
+            return(m_bt->onEventTimer(m_type, scheduledTime));
         }
     } // Plugin
 } // WPEFramework
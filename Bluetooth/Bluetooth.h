@@ -24,12 +24,31 @@
 #include "Module.h"
 #include <interfaces/IPowerManager.h>
 #include "PowerManagerInterface.h"
-#include "UtilsThreadRAII.h"
 #include "BluetoothDeviceManager.h"
+#include "BluetoothDeviceListTracker.h"
+#include "BluetoothDeviceQuery.h"
+#include "BluetoothListBufferPool.h"
+#include "BluetoothBatchExecutor.h"
+#include "BluetoothOperationExecutor.h"
+#include "BluetoothDeviceRegistry.h"
+#include "BluetoothConnectionDebouncer.h"
+#include "BluetoothEventJournal.h"
+#include "BluetoothEventQueue.h"
+#include "BluetoothEventStats.h"
+#include "BluetoothEventSubscribers.h"
+#include "BluetoothPlaybackProgressCoalescer.h"
+#include "BluetoothDiscoveryBatcher.h"
+#include "BluetoothDiscoveryIndex.h"
+#include "BluetoothDiscoverySessions.h"
+#include "BluetoothDiscoveryMatcher.h"
+#include "BluetoothDiscoveryDutyCycle.h"
 #include <type_traits>
 
 #include "btmgr.h" //TODO: can we move it to the module? Required by notifyEventWrapper()
 
+//default behaviour is to scan audio devices and gamepads
+#define BLUETOOTH_DEFAULT_DISCOVERY_PROFILE "LOUDSPEAKER, HEADPHONES, WEARABLE HEADSET, HIFI AUDIO DEVICE, KEYBOARD, MOUSE, JOYSTICK"
+
 namespace WPEFramework {
     namespace Plugin {
 
@@ -69,9 +88,124 @@ namespace WPEFramework {
             Bluetooth* m_bt;
         };
 
-        class Bluetooth : public PluginHost::IPlugin, public PluginHost::JSONRPC {
+        // Timer content for the deferred work of the event path, one instance per Type.
+        class EventTimer
+        {
+        private:
+            EventTimer() = delete;
+            EventTimer& operator=(const EventTimer& RHS) = delete;
+
+        public:
+            enum Type {
+                PLAYBACK_PROGRESS,
+                DISCOVERY_BATCH,
+                CONNECTION_SETTLE,
+                DEVICE_REGISTRY,
+                BACKGROUND_DISCOVERY,
+                DISCOVERY_INDEX
+            };
+
+            EventTimer(Bluetooth* bt, Type type): m_bt(bt), m_type(type){}
+            EventTimer(const EventTimer& copy): m_bt(copy.m_bt), m_type(copy.m_type){}
+            ~EventTimer() {}
+
+            inline bool operator==(const EventTimer& RHS) const
+            {
+                return((m_bt == RHS.m_bt) && (m_type == RHS.m_type));
+            }
+
+        public:
+            uint64_t Timed(const uint64_t scheduledTime);
 
         private:
+            Bluetooth* m_bt;
+            Type m_type;
+        };
+
+        // Lock, timer and pending flag of one kind of deferred work of the event path.
+        // The Bluetooth* helper classes hold no lock and no timer: the plugin calls each of them with
+        // the lock that guards it held, from the event dispatcher, the request threads and the timer
+        // thread alike, and runs any timer from the delays the helper returns. For the coalescer, the
+        // discovery batcher, the discovery index and the connection debouncer that lock is the one of
+        // their DeferredEventTimer.
+        class DeferredEventTimer
+        {
+        private:
+            DeferredEventTimer() = delete;
+            DeferredEventTimer(const DeferredEventTimer&) = delete;
+            DeferredEventTimer& operator=(const DeferredEventTimer& RHS) = delete;
+
+        public:
+            DeferredEventTimer(Bluetooth* bt, EventTimer::Type type): m_timer(bt, type), m_scheduled(false){}
+            ~DeferredEventTimer() {}
+
+            void Lock() { m_lock.Lock(); }
+            void Unlock() { m_lock.Unlock(); }
+
+            // With the lock held: runs the timer after delayMs unless it is pending already.
+            void Schedule(uint64_t delayMs);
+            // With the lock held, from the timer: the time to run it again after delayMs, 0 when it is done.
+            uint64_t Reschedule(uint64_t delayMs);
+            // Without the lock: revokes the timer, waiting for a run in progress.
+            void Revoke();
+
+        private:
+            Core::CriticalSection m_lock;
+            EventTimer m_timer;
+            bool m_scheduled;
+        };
+
+        class Bluetooth : public PluginHost::IPlugin, public PluginHost::JSONRPCSupportsEventStatus {
+
+        private:
+
+            class Config : public Core::JSON::Container {
+            private:
+                Config(const Config&) = delete;
+                Config& operator=(const Config&) = delete;
+
+            public:
+                Config()
+                    : Core::JSON::Container()
+                    , EventQueueDepth(BLUETOOTH_EVENT_QUEUE_DEFAULT_DEPTH)
+                    , PlaybackProgressInterval(BLUETOOTH_PLAYBACK_PROGRESS_DEFAULT_INTERVAL_MS)
+                    , DiscoveryBatchWindow(BLUETOOTH_DISCOVERY_BATCH_DEFAULT_WINDOW_MS)
+                    , DiscoveryBatchSize(BLUETOOTH_DISCOVERY_BATCH_DEFAULT_SIZE)
+                    , DiscoveryTtl(BLUETOOTH_DISCOVERY_INDEX_DEFAULT_TTL_MS)
+                    , DiscoveryIndexSize(BLUETOOTH_DISCOVERY_INDEX_DEFAULT_SIZE)
+                    , EventReplaySize(BLUETOOTH_EVENT_JOURNAL_DEFAULT_SIZE)
+                    , ConnectionSettleTime(BLUETOOTH_CONNECTION_SETTLE_DEFAULT_MS)
+                    , DeviceRegistryInterval(BLUETOOTH_DEVICE_REGISTRY_DEFAULT_INTERVAL_MS)
+                    , BatchWorkers(BLUETOOTH_BATCH_DEFAULT_WORKERS)
+                    , OperationWorkers(BLUETOOTH_OPERATION_DEFAULT_WORKERS)
+                {
+                    Add(_T("eventqueuedepth"), &EventQueueDepth);
+                    Add(_T("playbackprogressinterval"), &PlaybackProgressInterval);
+                    Add(_T("discoverybatchwindow"), &DiscoveryBatchWindow);
+                    Add(_T("discoverybatchsize"), &DiscoveryBatchSize);
+                    Add(_T("discoveryttl"), &DiscoveryTtl);
+                    Add(_T("discoveryindexsize"), &DiscoveryIndexSize);
+                    Add(_T("eventreplaysize"), &EventReplaySize);
+                    Add(_T("connectionsettletime"), &ConnectionSettleTime);
+                    Add(_T("deviceregistryinterval"), &DeviceRegistryInterval);
+                    Add(_T("batchworkers"), &BatchWorkers);
+                    Add(_T("operationworkers"), &OperationWorkers);
+                }
+                ~Config() = default;
+
+            public:
+                Core::JSON::DecUInt32 EventQueueDepth;
+                Core::JSON::DecUInt32 PlaybackProgressInterval;
+                Core::JSON::DecUInt32 DiscoveryBatchWindow;
+                Core::JSON::DecUInt32 DiscoveryBatchSize;
+                Core::JSON::DecUInt32 DiscoveryTtl;
+                Core::JSON::DecUInt32 DiscoveryIndexSize;
+                Core::JSON::DecUInt32 EventReplaySize;
+                Core::JSON::DecUInt32 ConnectionSettleTime;
+                Core::JSON::DecUInt32 DeviceRegistryInterval;
+                Core::JSON::DecUInt32 BatchWorkers;
+                Core::JSON::DecUInt32 OperationWorkers;
+            };
 
             class PowerManagerNotification : public WPEFramework::Exchange::IPowerManager::IModeChangedNotification {
 
@@ -139,6 +273,14 @@ namespace WPEFramework {
             uint32_t setDeviceVolumeMuteInfoWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t setAutoConnectWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t getAutoConnectWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t getEventStatsWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t getEventsSinceWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t reconcileDevicesWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t getDeviceSnapshotWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t setBackgroundDiscoveryWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t getBackgroundDiscoveryWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t getOperationStatusWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t cancelOperationWrapper(const JsonObject& parameters, JsonObject& response);
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             uint32_t performMigrationWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t clearMigrationWrapper(const JsonObject& parameters, JsonObject& response);
@@ -148,19 +290,62 @@ namespace WPEFramework {
         private: /*internal methods*/
             void getStatusSupport(string& status);
             bool isAdapterDiscoverable();
-            string startDeviceDiscovery(int timeout, const string &discProfile = "LOUDSPEAKER, HEADPHONES, WEARABLE HEADSET, HIFI AUDIO DEVICE, KEYBOARD, MOUSE, JOYSTICK");  //default behaviour is to scan audio devices and gamepads
+            // sessionId is set to the discovery session opened for the caller, 0 if none is left open.
+            // With a target the session ends early, as soon as a device matching it was found.
+            string startDeviceDiscovery(int timeout, BluetoothDiscoverySessions::SessionId& sessionId, const string &discProfile = BLUETOOTH_DEFAULT_DISCOVERY_PROFILE,
+                                        const BluetoothDiscoveryMatcher::Target* target = nullptr);
+            // Opens a session scanning for type, a timeoutMs of 0 releases it right away.
+            string openDiscoverySession(BTRMGR_DeviceOperationType_t type, uint64_t timeoutMs, BluetoothDiscoverySessions::SessionId& sessionId,
+                                        const BluetoothDiscoveryMatcher::Target* target = nullptr);
+            // Ends every discovery session and the BTRMGR discovery.
             bool stopDeviceDiscovery();
-            void startDiscoveryTimer(int msec);
-            void stopDiscoveryTimer();
-            void onDiscoveryTimer();
-            JsonArray getDiscoveredDevices();
-            JsonArray getPairedDevices();
-            JsonArray getConnectedDevices();
+            // Ends one discovery session, the BTRMGR discovery stops with the last one.
+            bool releaseDiscoverySession(BluetoothDiscoverySessions::SessionId sessionId);
+            // Ends the targeted sessions device matches and notifies onDeviceMatched for each.
+            void matchDiscoveredDevice(const RegisteredDevice& device, const char* address);
+            // The following expect m_discoveryLock to be held.
+            bool endDeviceDiscovery();
+            void scheduleDiscoveryTimer();
+            uint64_t onDiscoveryTimer(uint64_t scheduledTime);
+            // Only the devices selected by query are encoded; total is set to the number that matched its filter.
+            JsonArray getDiscoveredDevices(const BluetoothDeviceQuery& query = BluetoothDeviceQuery(), uint32_t* total = nullptr);
+            bool parseDeviceQuery(const JsonObject& parameters, BluetoothDeviceQuery& query);
+            bool parseDiscoveryTarget(const JsonObject& parameters, BluetoothDiscoveryMatcher::Target& target);
+            // False if profileList names a profile that is not known; those are listed in response["unknownProfiles"].
+            bool checkProfiles(const string& profileList, JsonObject& response);
+            // Reads the paired or connected list from BTRMGR.
+            bool readDeviceList(BluetoothDeviceRegistry::List list, std::vector<RegisteredDevice>& devices);
+            JsonArray encodeListedDevices(BluetoothDeviceRegistry::List list, const std::vector<RegisteredDevice>& devices);
+            // Adds the full list, or with "since" in parameters the changes after that generation, to response.
+            bool respondDeviceList(BluetoothDeviceRegistry::List list, const char* label, const JsonObject& parameters, JsonObject& response);
+            // Reports a change of the fields encodeStoredDeviceFields adds to the device list generations.
+            void touchListedDevice(BTRMgrDeviceHandle deviceHandle);
+            void encodeStoredDeviceFields(BTRMgrDeviceHandle deviceHandle, JsonObject& deviceDetails);
+            // Copies a list of the device registry, false when the list is not served from it.
+            bool registeredDevices(BluetoothDeviceRegistry::List list, std::vector<RegisteredDevice>& devices);
+            // Connected devices from the registry, or from BTRMGR when the registry does not serve them.
+            bool connectedDevices(std::vector<RegisteredDevice>& devices);
+            // True while an audio device is connected, audio then streams to or from it.
+            bool isAudioStreaming();
+            // Opens the next scan window of background discovery, returns the time of the one after.
+            uint64_t runBackgroundDiscovery(uint64_t scheduledTime);
+            // Reads the device lists from BTRMGR into the registry, the first pass seeds it.
+            bool reconcileDeviceRegistry(uint32_t& mismatches);
+            JsonObject deviceRegistryStatus();
+            // One record per discovered, paired or connected device, merged with the stored device info.
+            bool getDeviceSnapshot(JsonArray& deviceArray);
+            JsonArray listBufferStats();
             void disconnectExternallyConnectedDevices();
 
-            bool setDeviceConnection(long long int deviceID, bool connect, const string &deviceType = "UNKNOWN DEVICE");
+            bool setDeviceConnection(long long int deviceID, bool connect, BluetoothDeviceCategory category = BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT);
             bool setAudioStream(long long int deviceID, const string &audioStreamName);
             bool setDevicePairing(long long int deviceID, bool pair);
+            // Runs an operation on deviceID behind the ones already queued for it. With "async": true in
+            // parameters, adds the "jobID" to response and returns false only if it could not be queued;
+            // otherwise waits for it and returns its result.
+            bool runDeviceOperation(const JsonObject& parameters, const string& operation, long long int deviceID,
+                                    const BluetoothOperationExecutor::Operation& run, JsonObject& response);
+            void notifyOperationComplete(const BluetoothOperationExecutor::Job& job);
             bool setBluetoothEnabled(const string &enabled);
             bool setBluetoothDiscoverable(bool enabled, int timeout);
             bool getBluetoothProperties(JsonObject* rp);
@@ -168,11 +353,60 @@ namespace WPEFramework {
             bool setAudioControlCommand(long long int  deviceID, const string &audioCtrlCmd);
             bool setEventResponse(long long int  deviceID, const string &eventType, const string &respValue);
             JsonObject getDeviceInfo(long long int deviceID);
+            BTRMGR_Result_t readDeviceInfo(long long int deviceID, JsonObject& deviceDetails);
             JsonObject getMediaTrackInfo(long long int deviceID);
             bool setDeviceVolumeMuteProperties(long long int  deviceID, const string &deviceProfile, unsigned char ui8volume, unsigned char mute);
             JsonObject getDeviceVolumeMuteProperties(long long int  deviceID, const string &deviceProfile);
-            BTRMGR_DeviceOperationType_t btmgrDeviceOperationTypeFromString(const string &deviceProfile);
+            BTRMGR_Result_t readDeviceVolumeMuteProperties(long long int deviceID, const string &deviceProfile, JsonObject& volumeInfo);
+            typedef std::function<BTRMGR_Result_t(long long int deviceID, JsonObject& result)> DeviceLookup;
+            // Runs lookup for every entry of the "deviceIDs" parameter on the batch executor and adds the
+            // results keyed by deviceID to results; a failed lookup is reported as an "error" entry.
+            bool lookupDevices(const JsonObject& parameters, const DeviceLookup& lookup, JsonObject& results);
             void notifyAutoConnectStatusChanged(const string& deviceID, const bool enable);
+            void coalescePlaybackProgress(const BTRMGR_MediaInfo_t& mediaInfo);
+            void flushPlaybackProgress(BTRMgrDeviceHandle deviceHandle, bool forget);
+            void notifyPlaybackProgress(const PlaybackProgress& progress);
+            void batchDiscoveryUpdate(const DiscoveredDeviceUpdate& update);
+            void flushDiscoveryBatch();
+            void notifyDiscoveryBatch(const std::vector<DiscoveredDeviceUpdate>& batch);
+            void indexDiscoveryUpdate(const DiscoveredDeviceUpdate& update);
+            uint64_t expireDiscoveryIndex();
+            void notifyDiscoveryIndexLost(const std::vector<DiscoveredDeviceUpdate>& lost);
+            // Drops devices the discovery index reported lost and stamps the indexed ones with their last-seen time.
+            void filterDiscoveryIndex(std::vector<RegisteredDevice>& devices);
+            uint64_t onEventTimer(EventTimer::Type type, uint64_t scheduledTime);
+            bool hasSubscribers(const string& eventId) const { return m_eventSubscribers.hasSubscribers(eventId); }
+            // Every notification goes through here to get its sequence number, replay=true also journals it.
+            void publishEvent(const string& eventId, JsonObject& params, bool replay);
+
+            // Table driven event mapping used by notifyEventWrapper(), see Bluetooth.cpp.
+            struct EventDescriptor;
+            typedef bool (Bluetooth::*EventHook)(const BTRMGR_EventMessage_t& eventMsg);
+            typedef void (Bluetooth::*EventEncoder)(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            static const EventDescriptor* eventDescriptor(BTRMGR_Events_t eventType);
+            static BluetoothEventQueue::Lane eventLane(BTRMGR_Events_t eventType);
+            // Encodes and publishes an event whose hook already ran.
+            void notifyDescriptorEvent(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs);
+            // Hooks run before the subscriber check, returning false ends the dispatch of the event.
+            bool flushDiscoveryBatchHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool holdPlaybackProgressHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool flushPlaybackProgressHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool forgetPlaybackProgressHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool batchFoundDeviceHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool batchDiscoveryUpdateHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool answerConnectionRequestHook(const BTRMGR_EventMessage_t& eventMsg);
+            bool debounceConnectionHook(const BTRMGR_EventMessage_t& eventMsg);
+            void encodeStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeDeviceStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeConnectionStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeDeviceRange(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeDiscoveryUpdate(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeExternalRequest(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodePairingRequest(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodePlaybackChange(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodePlaybackEnded(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeNewTrack(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
+            void encodeMediaStatus(const EventDescriptor& descriptor, const BTRMGR_EventMessage_t& eventMsg, JsonObject& params);
 
         public:
             static const string SERVICE_NAME;
@@ -202,6 +436,14 @@ namespace WPEFramework {
             static const string METHOD_SET_DEVICE_VOLUME_MUTE_INFO;
             static const string METHOD_SET_AUTO_CONNECT;
             static const string METHOD_GET_AUTO_CONNECT_STATUS;
+            static const string METHOD_GET_EVENT_STATS;
+            static const string METHOD_GET_EVENTS_SINCE;
+            static const string METHOD_RECONCILE_DEVICES;
+            static const string METHOD_GET_DEVICE_SNAPSHOT;
+            static const string METHOD_SET_BACKGROUND_DISCOVERY;
+            static const string METHOD_GET_BACKGROUND_DISCOVERY;
+            static const string METHOD_GET_OPERATION_STATUS;
+            static const string METHOD_CANCEL_OPERATION;
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             static const string METHOD_PERFORM_MIGRATION;
             static const string METHOD_CLEAR_MIGRATION;
@@ -224,7 +466,10 @@ namespace WPEFramework {
             static const string EVT_DEVICE_FOUND;
             static const string EVT_DEVICE_LOST_OR_OUT_OF_RANGE;
             static const string EVT_DEVICE_DISCOVERY_UPDATE;
+            static const string EVT_DISCOVERED_DEVICES;
             static const string EVT_DEVICE_MEDIA_STATUS;
+            static const string EVT_DEVICE_MATCHED;
+            static const string EVT_OPERATION_COMPLETE;
 
             Bluetooth();
             virtual ~Bluetooth();
@@ -239,13 +484,16 @@ namespace WPEFramework {
 
         public:
             static Bluetooth* _instance;
-            void notifyEventWrapper (BTRMGR_EventMessage_t &eventMsg);
+            void queueEvent(const BTRMGR_EventMessage_t &eventMsg, uint64_t ingressUs);
+            // ingressUs is the monotonic time the event arrived from BTRMGR, 0 for now.
+            void notifyEventWrapper (BTRMGR_EventMessage_t &eventMsg, uint64_t ingressUs = 0);
             void onPowerModeChanged(const WPEFramework::Exchange::IPowerManager::PowerState currentState, const WPEFramework::Exchange::IPowerManager::PowerState newState);
 
         private:
             static const string STATUS_NO_BLUETOOTH_HARDWARE;
             static const string STATUS_SOFTWARE_DISABLED;
             static const string STATUS_AVAILABLE;
+            static const string STATUS_DISCOVERY_FAILED;
             static const string ENABLE_CONNECT;
             static const string ENABLE_DISCONNECT;
             static const string ENABLE_BLUETOOTH_ENABLED;
@@ -280,15 +528,69 @@ namespace WPEFramework {
             static const string CMD_AUDIO_CTRL_UNKNOWN;
 
             uint32_t m_apiVersionNumber;
-            // Assuming that there will be only one threaded call at a time (which is the case for Bluetooth)
-            // Otherwise we might need a thread for each async command for better performance
-            Utils::ThreadRAII m_executionThread;
+            // Per-device queues for every request that changes a device: pair, unpair, connect, disconnect,
+            // setAudioStream, sendAudioPlaybackCommand and setDeviceVolumeMuteInfo, synchronous or made with
+            // "async": true, and the disconnects and auto connects the plugin issues itself.
+            BluetoothOperationExecutor m_operationExecutor;
+            // Guards the discovery sessions and serializes BTRMGR discovery start/stop between
+            // the request threads and the timer thread.
+            Core::CriticalSection m_discoveryLock;
+            BluetoothDiscoverySessions m_discoverySessions;
+            // Match criteria of the targeted sessions, see startScan "match".
+            BluetoothDiscoveryMatcher m_discoveryMatcher;
             bool m_discoveryRunning;
+            BTRMGR_DeviceOperationType_t m_discoveryType;
             DiscoveryTimer m_discoveryTimer;
+            // Time the pending discovery timer was scheduled for, 0 if none. Timers superseded by
+            // an earlier deadline still fire, they are recognized by their scheduled time.
+            uint64_t m_discoveryTimerTicks;
+            // BTRMGR discovery time of the discoveries that ended, and start of the running one.
+            uint64_t m_discoveryScanningMs;
+            uint64_t m_discoveryStartedMs;
             friend class DiscoveryTimer;
             PowerManagerInterfaceRef m_powerManagerPlugin;
             Core::Sink<PowerManagerNotification> m_powerManagerNotification;
             BluetoothDeviceManager m_bluetoothDeviceManager;
+            BluetoothEventQueue m_eventQueue;
+            BluetoothEventSubscribers m_eventSubscribers;
+            Core::CriticalSection m_eventStatsLock;
+            BluetoothEventStats m_eventStats;
+            // Time events waited in each lane of m_eventQueue, guarded by m_eventStatsLock.
+            BluetoothLatencyHistogram m_laneWait[BluetoothEventQueue::LANE_COUNT];
+            // Held over sendNotify so that subscribers receive sequence numbers in increasing order.
+            Core::CriticalSection m_eventJournalLock;
+            BluetoothEventJournal m_eventJournal;
+            friend class EventTimer;
+            // Serializes progress notifications between the event dispatcher and the timer thread.
+            BluetoothPlaybackProgressCoalescer m_playbackProgressCoalescer;
+            DeferredEventTimer m_playbackProgressTimer;
+            BluetoothDiscoveryBatcher m_discoveryBatcher;
+            DeferredEventTimer m_discoveryBatchTimer;
+            // Updated by the dispatcher and expired by the timer thread.
+            BluetoothDiscoveryIndex m_discoveryIndex;
+            DeferredEventTimer m_discoveryIndexTimer;
+            // Serializes connection notifications between the event dispatcher and the timer thread.
+            BluetoothConnectionDebouncer m_connectionDebouncer;
+            DeferredEventTimer m_connectionSettleTimer;
+            // Guards the registry, updated by the dispatcher and the reconciliation timer.
+            Core::CriticalSection m_deviceRegistryLock;
+            BluetoothDeviceRegistry m_deviceRegistry;
+            EventTimer m_deviceRegistryTimer;
+            uint32_t m_deviceRegistryInterval;
+            BluetoothBatchExecutor m_batchExecutor;
+            // Guards background discovery and the power state; taken before m_discoveryLock.
+            Core::CriticalSection m_backgroundDiscoveryLock;
+            BluetoothDiscoveryDutyCycle m_discoveryDutyCycle;
+            EventTimer m_backgroundDiscoveryTimer;
+            bool m_backgroundDiscoveryEnabled;
+            BTRMGR_DeviceOperationType_t m_backgroundDiscoveryType;
+            // Time the live background discovery timer was scheduled for, as m_discoveryTimerTicks.
+            uint64_t m_backgroundDiscoveryTicks;
+            WPEFramework::Exchange::IPowerManager::PowerState m_powerState;
+            // Generations of the getPairedDevices / getConnectedDevices responses while the lists are read from BTRMGR.
+            Core::CriticalSection m_deviceListLock;
+            BluetoothDeviceListTracker m_pairedDeviceList;
+            BluetoothDeviceListTracker m_connectedDeviceList;
         };
 
     } // Plugin
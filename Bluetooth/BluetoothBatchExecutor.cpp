@@ -0,0 +1,133 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothBatchExecutor.h"
+
+#include "UtilsJsonRpc.h"
+
+#define BLUETOOTH_BATCH_MAX_WORKERS 8
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        BluetoothBatchExecutor::~BluetoothBatchExecutor()
+        {
+            stop();
+        }
+
+        Core::hresult BluetoothBatchExecutor::start(uint32_t workers)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_running) {
+                LOGWARN("Bluetooth batch executor is already running");
+                return Core::ERROR_ILLEGAL_STATE;
+            }
+
+            if (workers > BLUETOOTH_BATCH_MAX_WORKERS) {
+                LOGWARN("Bluetooth batch workers %u capped to %u", workers, BLUETOOTH_BATCH_MAX_WORKERS);
+                workers = BLUETOOTH_BATCH_MAX_WORKERS;
+            }
+
+            _running = true;
+            for (uint32_t i = 0; i < workers; ++i) {
+                _workers.emplace_back(&BluetoothBatchExecutor::workerLoop, this);
+            }
+            return Core::ERROR_NONE;
+        }
+
+        void BluetoothBatchExecutor::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (!_running) {
+                    return;
+                }
+                _running = false;
+                _wakeup.notify_all();
+            }
+            for (std::thread& worker : _workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+            _workers.clear();
+            _batches.clear();
+        }
+
+        void BluetoothBatchExecutor::drain(Batch& batch)
+        {
+            for (size_t index = batch.next.fetch_add(1); index < batch.count; index = batch.next.fetch_add(1)) {
+                (*batch.tasks)[index]();
+                if (batch.done.fetch_add(1) + 1 == batch.count) {
+                    std::lock_guard<std::mutex> lock(batch.lock);
+                    batch.finished.notify_all();
+                }
+            }
+        }
+
+        void BluetoothBatchExecutor::run(const std::vector<Task>& tasks)
+        {
+            if (tasks.empty()) {
+                return;
+            }
+
+            std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+            batch->tasks = &tasks;
+            batch->count = tasks.size();
+
+            if (tasks.size() > 1) {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (_running && !_workers.empty()) {
+                    _batches.push_back(batch);
+                    _wakeup.notify_all();
+                }
+            }
+
+            drain(*batch);
+
+            // Workers may still be running the last tasks they claimed.
+            std::unique_lock<std::mutex> lock(batch->lock);
+            batch->finished.wait(lock, [&batch]() { return batch->done.load() == batch->count; });
+        }
+
+        void BluetoothBatchExecutor::workerLoop()
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            while (_running) {
+                if (_batches.empty()) {
+                    _wakeup.wait(lock);
+                    continue;
+                }
+
+                // A batch stays queued until all of its tasks were claimed. Holding a reference
+                // keeps it alive after run() returned, tasks is not touched once all were claimed.
+                std::shared_ptr<Batch> batch = _batches.front();
+                if (batch->next.load() >= batch->count) {
+                    _batches.pop_front();
+                    continue;
+                }
+
+                lock.unlock();
+                drain(*batch);
+                lock.lock();
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,84 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <core/core.h>
+
+#define BLUETOOTH_BATCH_DEFAULT_WORKERS 2
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Small fixed pool of worker threads that runs the per-device lookups of a batched request
+        // concurrently. run() blocks until every task of the batch has finished; the calling thread
+        // takes tasks too, so a batch always makes progress and runs inline when no worker was started.
+        // Tasks of one batch are claimed with an atomic index, batches of concurrent callers queue up.
+        class BluetoothBatchExecutor {
+
+            public:
+
+                typedef std::function<void()> Task;
+
+                BluetoothBatchExecutor() = default;
+                ~BluetoothBatchExecutor();
+
+                BluetoothBatchExecutor(const BluetoothBatchExecutor&) = delete;
+                BluetoothBatchExecutor& operator=(const BluetoothBatchExecutor&) = delete;
+
+                // 0 workers runs every batch on the calling thread.
+                Core::hresult start(uint32_t workers);
+                void stop();
+
+                uint32_t workers() const { return static_cast<uint32_t>(_workers.size()); }
+
+                void run(const std::vector<Task>& tasks);
+
+            private:
+
+                typedef struct _Batch {
+                    const std::vector<Task>*    tasks       = nullptr;
+                    size_t                      count       = 0;
+                    std::atomic<size_t>         next{0};
+                    std::atomic<size_t>         done{0};
+                    std::mutex                  lock;
+                    std::condition_variable     finished;
+                } Batch;
+
+                static void drain(Batch& batch);
+                void workerLoop();
+
+                std::vector<std::thread> _workers;
+                std::mutex _lock;
+                std::condition_variable _wakeup;
+                std::deque<std::shared_ptr<Batch>> _batches;
+                bool _running = false;
+        };
+
+    } // Plugin
+} // WPEFramework
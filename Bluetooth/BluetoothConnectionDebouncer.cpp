@@ -0,0 +1,101 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothConnectionDebouncer.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        BluetoothConnectionDebouncer::Action BluetoothConnectionDebouncer::offer(const BTRMGR_EventMessage_t& eventMsg, uint64_t nowMs, uint64_t& nextDueMs)
+        {
+            nextDueMs = 0;
+            if (0 == _settleMs) {
+                return ACTION_NOTIFY;
+            }
+
+            const bool connected = (BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE == eventMsg.m_eventType);
+            auto it = _devices.find(eventMsg.m_pairedDevice.m_deviceHandle);
+            if (it == _devices.end()) {
+                DeviceState& state = _devices[eventMsg.m_pairedDevice.m_deviceHandle];
+                state.lastChangeMs = nowMs;
+                state.connected = connected;
+                return ACTION_NOTIFY;
+            }
+
+            DeviceState& state = it->second;
+            if (!state.held && (connected == state.connected)) {
+                // Not a transition, e.g. a repeated CONNECTION_COMPLETE.
+                return ACTION_NOTIFY;
+            }
+            if (!state.held && (nowMs >= state.lastChangeMs + _settleMs)) {
+                state.lastChangeMs = nowMs;
+                state.connected = connected;
+                return ACTION_NOTIFY;
+            }
+
+            state.lastChangeMs = nowMs;
+            if (connected == state.connected) {
+                state.held = false;
+                ++state.flaps;
+                return ACTION_SUPPRESS;
+            }
+
+            state.held = true;
+            state.heldEvent = eventMsg;
+            nextDueMs = _settleMs;
+            return ACTION_HOLD;
+        }
+
+        uint64_t BluetoothConnectionDebouncer::takeDue(uint64_t nowMs, std::vector<BTRMGR_EventMessage_t>& due)
+        {
+            uint64_t nextDueMs = 0;
+            for (auto& entry : _devices) {
+                DeviceState& state = entry.second;
+                if (!state.held) {
+                    continue;
+                }
+
+                const uint64_t dueMs = state.lastChangeMs + _settleMs;
+                if (nowMs >= dueMs) {
+                    due.push_back(state.heldEvent);
+                    state.held = false;
+                    state.connected = !state.connected;
+                } else if ((0 == nextDueMs) || ((dueMs - nowMs) < nextDueMs)) {
+                    nextDueMs = dueMs - nowMs;
+                }
+            }
+            return nextDueMs;
+        }
+
+        void BluetoothConnectionDebouncer::clear()
+        {
+            _devices.clear();
+        }
+
+        void BluetoothConnectionDebouncer::flaps(std::map<BTRMgrDeviceHandle, uint32_t>& flaps) const
+        {
+            for (const auto& entry : _devices) {
+                if (0 != entry.second.flaps) {
+                    flaps[entry.first] = entry.second.flaps;
+                }
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,80 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <map>
+#include <vector>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_CONNECTION_SETTLE_DEFAULT_MS 0
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Debounces BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE / BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE per device.
+        // The first transition after the device was stable for the settle time is notified right away.
+        // A transition that follows within the settle time is held until the device stays in that state
+        // for the settle time; if the device reverts first, both events are dropped and counted as a flap.
+        class BluetoothConnectionDebouncer {
+
+            public:
+
+                enum Action {
+                    ACTION_NOTIFY = 0,      // notify the event now
+                    ACTION_HOLD,            // held, flush it with takeDue()
+                    ACTION_SUPPRESS         // reverted a held event, notify nothing
+                };
+
+                BluetoothConnectionDebouncer() = default;
+                ~BluetoothConnectionDebouncer() = default;
+
+                // 0 disables debouncing, every event is notified.
+                void setSettleTime(uint32_t settleMs) { _settleMs = settleMs; }
+                uint32_t settleTime() const { return _settleMs; }
+                bool enabled() const { return (0 != _settleMs); }
+
+                // nextDueMs is set to the delay until a held event is due.
+                Action offer(const BTRMGR_EventMessage_t& eventMsg, uint64_t nowMs, uint64_t& nextDueMs);
+                // Collects held events whose settle time elapsed. Returns the delay until the
+                // next held event is due, 0 if nothing is held anymore.
+                uint64_t takeDue(uint64_t nowMs, std::vector<BTRMGR_EventMessage_t>& due);
+                void clear();
+
+                // Flaps per device since the plugin was activated, devices without flaps are left out.
+                void flaps(std::map<BTRMgrDeviceHandle, uint32_t>& flaps) const;
+
+            private:
+
+                typedef struct _DeviceState {
+                    uint64_t                lastChangeMs    = 0;
+                    bool                    connected       = false;    // last state notified
+                    bool                    held            = false;
+                    uint32_t                flaps           = 0;
+                    BTRMGR_EventMessage_t   heldEvent;
+                } DeviceState;
+
+                uint32_t _settleMs = BLUETOOTH_CONNECTION_SETTLE_DEFAULT_MS;
+                std::map<BTRMgrDeviceHandle, DeviceState> _devices;
+        };
+
+    } // Plugin
+} // WPEFramework
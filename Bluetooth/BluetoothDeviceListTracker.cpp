@@ -0,0 +1,155 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <atomic>
+#include <chrono>
+
+#include "BluetoothDeviceListTracker.h"
+
+#define BLUETOOTH_DEVICE_LIST_EPOCH_MASK ((1ULL << (53 - BLUETOOTH_DEVICE_LIST_EPOCH_SHIFT)) - 1)
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        namespace {
+            uint64_t nextEpoch()
+            {
+                // Seeded from the clock so that a restarted process does not start over at the epochs of the previous one.
+                static std::atomic<uint64_t> epoch { static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count()) };
+                const uint64_t next = epoch.fetch_add(1) & BLUETOOTH_DEVICE_LIST_EPOCH_MASK;
+                return (0 != next) ? next : 1;
+            }
+        } // namespace
+
+        BluetoothDeviceListTracker::BluetoothDeviceListTracker()
+            : _epoch(nextEpoch())
+        {
+        }
+
+        uint64_t BluetoothDeviceListTracker::generation() const
+        {
+            return (_epoch << BLUETOOTH_DEVICE_LIST_EPOCH_SHIFT) | _generation;
+        }
+
+        void BluetoothDeviceListTracker::set(BTRMgrDeviceHandle deviceHandle, uint64_t fingerprint)
+        {
+            auto found = _devices.find(deviceHandle);
+            if (found == _devices.end()) {
+                Entry& entry = _devices[deviceHandle];
+                entry.fingerprint = fingerprint;
+                entry.addedGeneration = ++_generation;
+                entry.changedGeneration = _generation;
+                _removed.erase(deviceHandle);
+            } else if (found->second.fingerprint != fingerprint) {
+                found->second.fingerprint = fingerprint;
+                found->second.changedGeneration = ++_generation;
+            }
+        }
+
+        void BluetoothDeviceListTracker::remove(BTRMgrDeviceHandle deviceHandle)
+        {
+            if (0 == _devices.erase(deviceHandle)) {
+                return;
+            }
+            _removed[deviceHandle] = ++_generation;
+            prune();
+        }
+
+        void BluetoothDeviceListTracker::touch(BTRMgrDeviceHandle deviceHandle)
+        {
+            auto found = _devices.find(deviceHandle);
+            if (found != _devices.end()) {
+                found->second.changedGeneration = ++_generation;
+            }
+        }
+
+        void BluetoothDeviceListTracker::sync(const std::vector<Device>& devices)
+        {
+            BluetoothHandleMap<bool> listed;
+            listed.reserve(devices.size());
+            for (const Device& device : devices) {
+                set(device.first, device.second);
+                listed[device.first] = true;
+            }
+
+            std::vector<BTRMgrDeviceHandle> missing;
+            for (const auto& entry : _devices) {
+                if (0 == listed.count(entry.first)) {
+                    missing.push_back(entry.first);
+                }
+            }
+            for (const BTRMgrDeviceHandle deviceHandle : missing) {
+                remove(deviceHandle);
+            }
+        }
+
+        void BluetoothDeviceListTracker::prune()
+        {
+            while (_removed.size() > BLUETOOTH_DEVICE_LIST_MAX_TOMBSTONES) {
+                auto oldest = _removed.begin();
+                for (auto it = _removed.begin(); it != _removed.end(); ++it) {
+                    if (it->second < oldest->second) {
+                        oldest = it;
+                    }
+                }
+                if (oldest->second > _prunedGeneration) {
+                    _prunedGeneration = oldest->second;
+                }
+                _removed.erase(oldest->first);
+            }
+        }
+
+        bool BluetoothDeviceListTracker::delta(uint64_t since, std::vector<BTRMgrDeviceHandle>& added, std::vector<BTRMgrDeviceHandle>& changed,
+            std::vector<BTRMgrDeviceHandle>& removed) const
+        {
+            if ((since >> BLUETOOTH_DEVICE_LIST_EPOCH_SHIFT) != _epoch) {
+                return false;
+            }
+            const uint64_t generation = since & ((1ULL << BLUETOOTH_DEVICE_LIST_EPOCH_SHIFT) - 1);
+            if ((generation > _generation) || (generation < _prunedGeneration)) {
+                return false;
+            }
+
+            for (const auto& entry : _devices) {
+                if (entry.second.addedGeneration > generation) {
+                    added.push_back(entry.first);
+                } else if (entry.second.changedGeneration > generation) {
+                    changed.push_back(entry.first);
+                }
+            }
+            for (const auto& entry : _removed) {
+                if (entry.second > generation) {
+                    removed.push_back(entry.first);
+                }
+            }
+            return true;
+        }
+
+        void BluetoothDeviceListTracker::clear()
+        {
+            _devices.clear();
+            _removed.clear();
+            _generation = 0;
+            _prunedGeneration = 0;
+            _epoch = nextEpoch();
+        }
+
+    } // Plugin
+} // WPEFramework
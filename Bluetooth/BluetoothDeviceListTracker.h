@@ -0,0 +1,88 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <utility>
+#include <vector>
+
+#include "btmgr.h"
+#include "BluetoothHandleMap.h"
+
+#define BLUETOOTH_DEVICE_LIST_MAX_TOMBSTONES 64
+#define BLUETOOTH_DEVICE_LIST_EPOCH_SHIFT 32
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Generation counter and change log of one device list (paired or connected devices).
+        // The owner reports each change where it happens: set() for a device added to the list or
+        // whose fingerprint changed, remove() for a device that left it, sync() for a whole list
+        // read from BTRMGR. Every change advances the generation; delta() lists what changed after
+        // a generation, removed devices are kept as tombstones for that.
+        // A generation carries the epoch of the tracker above BLUETOOTH_DEVICE_LIST_EPOCH_SHIFT.
+        // Every tracker, and every clear(), takes a new epoch, so a generation issued by an earlier
+        // plugin instance is rejected instead of matching an unrelated change log. Generations stay
+        // below 2^53 so JSON clients can hold them as numbers.
+        class BluetoothDeviceListTracker {
+
+            public:
+
+                typedef std::pair<BTRMgrDeviceHandle, uint64_t /* fingerprint */> Device;
+
+                BluetoothDeviceListTracker();
+                ~BluetoothDeviceListTracker() = default;
+
+                uint64_t generation() const;
+
+                void set(BTRMgrDeviceHandle deviceHandle, uint64_t fingerprint);
+                void remove(BTRMgrDeviceHandle deviceHandle);
+                // Marks a listed device changed, for fields the fingerprint does not cover.
+                void touch(BTRMgrDeviceHandle deviceHandle);
+                // Sets every device of devices and removes the listed devices that are not in it.
+                void sync(const std::vector<Device>& devices);
+
+                // Returns false when the changes after since are no longer known, either because the
+                // tombstones were pruned or because since was not issued by this tracker.
+                bool delta(uint64_t since, std::vector<BTRMgrDeviceHandle>& added, std::vector<BTRMgrDeviceHandle>& changed,
+                    std::vector<BTRMgrDeviceHandle>& removed) const;
+                // Drops the list and its change log and takes a new epoch.
+                void clear();
+
+            private:
+
+                typedef struct _Entry {
+                    uint64_t        fingerprint         = 0;
+                    uint32_t        addedGeneration     = 0;
+                    uint32_t        changedGeneration   = 0;
+                } Entry;
+
+                void prune();
+
+                uint64_t _epoch = 0;
+                uint32_t _generation = 0;
+                // Generation of the newest tombstone dropped, deltas from before it are incomplete.
+                uint32_t _prunedGeneration = 0;
+                BluetoothHandleMap<Entry> _devices;
+                BluetoothHandleMap<uint32_t /* generation */> _removed;
+        };
+
+    } // Plugin
+} // WPEFramework
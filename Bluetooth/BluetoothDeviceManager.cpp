@@ -19,12 +19,14 @@
 
 #include <vector>
 #include <algorithm>
-#include <exception>
+#include <cerrno>
+#include <cstdlib>
 #include <functional>
 #include <unordered_set>
 
 #include "BluetoothDeviceManager.h"
 #include "btmgr.h"
+#include "BluetoothListBufferPool.h"
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
 #include "BluetoothPersistenceAdapter.h"
@@ -41,6 +43,22 @@ namespace WPEFramework {
             }
         } // namespace
 
+        bool parseDeviceHandle(const std::string& deviceID, BTRMgrDeviceHandle& deviceHandle)
+        {
+            if (deviceID.empty() || (deviceID.find_first_not_of("0123456789") != std::string::npos)) {
+                return false;
+            }
+
+            errno = 0;
+            const unsigned long long value = strtoull(deviceID.c_str(), nullptr, 10);
+            if (ERANGE == errno) {
+                return false;
+            }
+
+            deviceHandle = static_cast<BTRMgrDeviceHandle>(value);
+            return true;
+        }
+
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
 
         Core::hresult BluetoothDeviceManager::writeCacheFromFilesystemPersistence(const std::string& rawContent)
@@ -48,6 +66,7 @@ namespace WPEFramework {
             if (rawContent.empty()) {
                 _adminLock.Lock();
                 _pairedDeviceCache.clear();
+                publishSnapshot();
                 _adminLock.Unlock();
                 return Core::ERROR_NONE;
             }
@@ -60,26 +79,31 @@ namespace WPEFramework {
             }
 
             // Build a mapping from device address to device handle using BTRMGR.
-            BTRMGR_PairedDevicesList_t pairedDevices{};
+            auto pairedDevicesBuffer = BluetoothListBuffers::paired().acquire();
+            if (!pairedDevicesBuffer) {
+                LOGERR("Failed to allocate memory");
+                return Core::ERROR_GENERAL;
+            }
+            BTRMGR_PairedDevicesList_t& pairedDevices = *pairedDevicesBuffer;
             if (BTRMGR_GetPairedDevices(0, &pairedDevices) != BTRMGR_RESULT_SUCCESS) {
                 LOGERR("Failed to get paired devices from BTRMGR during filesystem persistence import");
                 return Core::ERROR_GENERAL;
             }
 
-            std::unordered_map<std::string, std::string> addrToDeviceId;
-            addrToDeviceId.reserve(static_cast<size_t>(pairedDevices.m_numOfDevices));
+            std::unordered_map<std::string, BTRMgrDeviceHandle> addrToDeviceHandle;
+            addrToDeviceHandle.reserve(static_cast<size_t>(pairedDevices.m_numOfDevices));
             for (int i = 0; i < pairedDevices.m_numOfDevices; ++i) {
                 if (pairedDevices.m_deviceProperty[i].m_deviceAddress[0] != '\0') {
                     const std::string deviceAddr(pairedDevices.m_deviceProperty[i].m_deviceAddress);
-                    const std::string deviceId = std::to_string(pairedDevices.m_deviceProperty[i].m_deviceHandle);
-                    addrToDeviceId[deviceAddr] = std::move(deviceId);
+                    addrToDeviceHandle[deviceAddr] = pairedDevices.m_deviceProperty[i].m_deviceHandle;
                 }
             }
 
-            std::unordered_map<std::string, BluetoothDeviceInfo> importedCache;
+            BluetoothDeviceInfoMap importedCache;
+            importedCache.reserve(importedDevices.size());
             for (BluetoothDeviceInfo& info : importedDevices) {
-                auto it = addrToDeviceId.find(info.deviceAddr);
-                if (it != addrToDeviceId.end()) {
+                auto it = addrToDeviceHandle.find(info.deviceAddr);
+                if (it != addrToDeviceHandle.end()) {
                     importedCache[it->second] = std::move(info);
                 } else {
                     LOGWARN("No paired device handle found for addr=%s during filesystem persistence import, skipping", info.deviceAddr.c_str());
@@ -88,6 +112,7 @@ namespace WPEFramework {
 
             _adminLock.Lock();
             _pairedDeviceCache = std::move(importedCache);
+            publishSnapshot();
             _adminLock.Unlock();
 
             return Core::ERROR_NONE;
@@ -96,14 +121,14 @@ namespace WPEFramework {
         void BluetoothDeviceManager::writeFilesystemPersistenceFromCache()
         {
             BluetoothPersistenceAdapter adapter;
-            std::unordered_map<std::string, BluetoothDeviceInfo> cacheSnapshot = getPairedDeviceInfos();
+            const std::shared_ptr<const BluetoothDeviceInfoMap> devices = snapshot();
 
             // Filter out Human Interface Devices — The legacy behavior doesn't persist them to the filesystem.
-            for (auto it = cacheSnapshot.begin(); it != cacheSnapshot.end(); ) {
-                if (it->second.deviceType == "HUMAN INTERFACE DEVICE") {
-                    it = cacheSnapshot.erase(it);
-                } else {
-                    ++it;
+            BluetoothDeviceInfoMap cacheSnapshot;
+            cacheSnapshot.reserve(devices->size());
+            for (const auto& entry : *devices) {
+                if (!isHumanInterfaceDevice(entry.second.deviceType)) {
+                    cacheSnapshot[entry.first] = entry.second;
                 }
             }
 
@@ -273,6 +298,7 @@ namespace WPEFramework {
 
             _adminLock.Lock();
             _pairedDeviceCache.clear();
+            publishSnapshot();
             _adminLock.Unlock();
 
             _isMigrated.store(false);
@@ -310,8 +336,13 @@ namespace WPEFramework {
 
                 for (uint16_t i = 0; i < deviceInfoArray.Length(); i++) {
                     JsonObject deviceInfoObj = deviceInfoArray[i].Object();
-                    std::string deviceID = deviceInfoObj["deviceID"].String();
-                    std::string deviceType = deviceInfoObj["deviceType"].String();
+                    const std::string deviceID = deviceInfoObj["deviceID"].String();
+                    BTRMgrDeviceHandle deviceHandle = 0;
+                    if (!parseDeviceHandle(deviceID, deviceHandle)) {
+                        LOGWARN("Skipping stored device info with invalid deviceID=%s\n", deviceID.c_str());
+                        continue;
+                    }
+                    const BluetoothDeviceType deviceType = bluetoothDeviceTypeFromString(deviceInfoObj["deviceType"].String());
 
                     AutoConnectStatus autoConnectStatus = AUTO_CONNECT_STATUS_UNSET;
                     if (deviceInfoObj.HasLabel("autoconnect")) {
@@ -326,20 +357,21 @@ namespace WPEFramework {
                     }
 
                     BluetoothDeviceInfo deviceInfo;
-                    deviceInfo.deviceType = std::move(deviceType);
+                    deviceInfo.deviceType = deviceType;
                     deviceInfo.autoConnectStatus = autoConnectStatus;
                     deviceInfo.lastConnectTimeUtc = std::move(lastConnectTimeUtc);
                     deviceInfo.lastVolumeSetting = lastVolumeSetting;
 
-                    _pairedDeviceCache[deviceID] = std::move(deviceInfo);
-
                     LOGINFO("Loaded device info for deviceID=%s, autoConnectStatus=%d, lastConnectTimeUtc=%s, lastVolumeSetting=%lld\n",
                             deviceID.c_str(),
-                            static_cast<int>(_pairedDeviceCache[deviceID].autoConnectStatus),
-                            _pairedDeviceCache[deviceID].lastConnectTimeUtc.c_str(),
-                            _pairedDeviceCache[deviceID].lastVolumeSetting);
+                            static_cast<int>(deviceInfo.autoConnectStatus),
+                            deviceInfo.lastConnectTimeUtc.c_str(),
+                            deviceInfo.lastVolumeSetting);
+
+                    _pairedDeviceCache[deviceHandle] = std::move(deviceInfo);
                 }
 
+                publishSnapshot();
                 _adminLock.Unlock();
                 
             } else if (!missingFromPersistentStore(result)) {
@@ -351,7 +383,12 @@ namespace WPEFramework {
 
         Core::hresult BluetoothDeviceManager::updateCacheFromDevice(bool backfillOnly)
         {
-            BTRMGR_PairedDevicesList_t pairedDevices{};
+            auto pairedDevicesBuffer = BluetoothListBuffers::paired().acquire();
+            if (!pairedDevicesBuffer) {
+                LOGERR("Failed to allocate memory");
+                return Core::ERROR_GENERAL;
+            }
+            BTRMGR_PairedDevicesList_t& pairedDevices = *pairedDevicesBuffer;
 
             BTRMGR_Result_t result = BTRMGR_GetPairedDevices(0, &pairedDevices);
             if (BTRMGR_RESULT_SUCCESS != result)
@@ -364,64 +401,64 @@ namespace WPEFramework {
 
             for (int i=0; i<pairedDevices.m_numOfDevices; i++)
             {
-                string deviceId = std::to_string(pairedDevices.m_deviceProperty[i].m_deviceHandle);
-                const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(pairedDevices.m_deviceProperty[i].m_deviceType);
-                string deviceType = string(deviceTypeStr ? deviceTypeStr : "UNKNOWN");
+                const BTRMgrDeviceHandle deviceHandle = pairedDevices.m_deviceProperty[i].m_deviceHandle;
+                const BluetoothDeviceType deviceType = bluetoothDeviceTypeFromBtrmgr(pairedDevices.m_deviceProperty[i].m_deviceType);
                 const std::string deviceAddr = (pairedDevices.m_deviceProperty[i].m_deviceAddress[0] != '\0')
                     ? std::string(pairedDevices.m_deviceProperty[i].m_deviceAddress)
                     : std::string();
 
-                if (_pairedDeviceCache.find(deviceId) != _pairedDeviceCache.end()) {
+                auto cached = _pairedDeviceCache.find(deviceHandle);
+                if (cached != _pairedDeviceCache.end()) {
                     // Device already exists in cache; backfill any fields that are missing.
-                    BluetoothDeviceInfo& existing = _pairedDeviceCache[deviceId];
+                    BluetoothDeviceInfo& existing = cached->second;
                     if (existing.friendlyName.empty()) {
-                        existing.friendlyName = (pairedDevices.m_deviceProperty[i].m_name[0] != '\0') ? std::string(pairedDevices.m_deviceProperty[i].m_name) : deviceId;
-                        LOGINFO("Backfilled friendlyName for deviceID=%s\n", deviceId.c_str());
+                        existing.friendlyName = (pairedDevices.m_deviceProperty[i].m_name[0] != '\0') ? std::string(pairedDevices.m_deviceProperty[i].m_name) : std::to_string(deviceHandle);
+                        LOGINFO("Backfilled friendlyName for deviceID=%llu\n", deviceHandle);
                     }
                     if (existing.deviceAddr.empty()) {
                         existing.deviceAddr = deviceAddr;
-                        LOGINFO("Backfilled deviceAddr for deviceID=%s from BTRMGR: %s\n", deviceId.c_str(), deviceAddr.c_str());
+                        LOGINFO("Backfilled deviceAddr for deviceID=%llu from BTRMGR: %s\n", deviceHandle, deviceAddr.c_str());
                     }
-                    if (existing.deviceType.empty() || existing.deviceType == "UNKNOWN") {
+                    if (BLUETOOTH_DEVICE_TYPE_UNKNOWN == existing.deviceType) {
                         existing.deviceType = deviceType;
-                        LOGINFO("Backfilled deviceType for deviceID=%s from BTRMGR: %s\n", deviceId.c_str(), deviceType.c_str());
+                        LOGINFO("Backfilled deviceType for deviceID=%llu from BTRMGR: %s\n", deviceHandle, bluetoothDeviceTypeName(deviceType));
                     }
                 } else if (!backfillOnly) {
                     // Device found that's not yet cached; add only when not in backfill-only mode.
-                    LOGINFO("Adding device to cache: deviceID=%s, deviceType=%s\n", deviceId.c_str(), deviceType.c_str());
+                    LOGINFO("Adding device to cache: deviceID=%llu, deviceType=%s\n", deviceHandle, bluetoothDeviceTypeName(deviceType));
                     BluetoothDeviceInfo deviceInfo;
                     deviceInfo.deviceAddr = std::move(deviceAddr);
-                    deviceInfo.deviceType = std::move(deviceType);
-                    deviceInfo.friendlyName = (pairedDevices.m_deviceProperty[i].m_name[0] != '\0') ? std::string(pairedDevices.m_deviceProperty[i].m_name) : deviceId;
-                    _pairedDeviceCache[deviceId] = std::move(deviceInfo);
+                    deviceInfo.deviceType = deviceType;
+                    deviceInfo.friendlyName = (pairedDevices.m_deviceProperty[i].m_name[0] != '\0') ? std::string(pairedDevices.m_deviceProperty[i].m_name) : std::to_string(deviceHandle);
+                    _pairedDeviceCache[deviceHandle] = std::move(deviceInfo);
                 } else {
-                    LOGINFO("Skipping device not in imported cache (backfill-only mode): deviceID=%s\n", deviceId.c_str());
+                    LOGINFO("Skipping device not in imported cache (backfill-only mode): deviceID=%llu\n", deviceHandle);
                 }
             }
 
             if (!backfillOnly) {
                 // Scrub cache of any devices that are no longer paired with the platform.
 
-                std::unordered_set<std::string> pairedDeviceIds;
-                pairedDeviceIds.reserve(static_cast<size_t>(pairedDevices.m_numOfDevices));
+                std::unordered_set<BTRMgrDeviceHandle> pairedDeviceHandles;
+                pairedDeviceHandles.reserve(static_cast<size_t>(pairedDevices.m_numOfDevices));
                 for (int i = 0; i < pairedDevices.m_numOfDevices; ++i) {
-                    pairedDeviceIds.emplace(std::to_string(pairedDevices.m_deviceProperty[i].m_deviceHandle));
+                    pairedDeviceHandles.emplace(pairedDevices.m_deviceProperty[i].m_deviceHandle);
                 }
 
-                std::vector<std::string> deviceIdsToRemove;
+                std::vector<BTRMgrDeviceHandle> deviceHandlesToRemove;
                 for (const auto& entry : _pairedDeviceCache) {
-                    const std::string& cachedDeviceId = entry.first;
-                    if (pairedDeviceIds.find(cachedDeviceId) == pairedDeviceIds.end()) {
-                        LOGINFO("Marking device for removal from cache: deviceID=%s\n", cachedDeviceId.c_str());
-                        deviceIdsToRemove.push_back(cachedDeviceId);
+                    if (pairedDeviceHandles.find(entry.first) == pairedDeviceHandles.end()) {
+                        LOGINFO("Marking device for removal from cache: deviceID=%llu\n", static_cast<unsigned long long>(entry.first));
+                        deviceHandlesToRemove.push_back(entry.first);
                     }
                 }
 
-                for (const auto& deviceId : deviceIdsToRemove) {
-                    _pairedDeviceCache.erase(deviceId);
+                for (const BTRMgrDeviceHandle deviceHandle : deviceHandlesToRemove) {
+                    _pairedDeviceCache.erase(deviceHandle);
                 }
             }
 
+            publishSnapshot();
             _adminLock.Unlock();
             return Core::ERROR_NONE;
         }
@@ -442,15 +479,15 @@ namespace WPEFramework {
 
             JsonArray deviceInfoArray;
 
-            _adminLock.Lock();
+            // Serialized from the snapshot so that _adminLock is not held while the JSON is built.
+            const std::shared_ptr<const BluetoothDeviceInfoMap> devices = snapshot();
 
-            for (const auto& entry : _pairedDeviceCache) {
-                const std::string& deviceID = entry.first;
+            for (const auto& entry : *devices) {
                 const BluetoothDeviceInfo& deviceInfo = entry.second;
 
                 JsonObject deviceInfoObj;
-                deviceInfoObj["deviceID"] = deviceID;
-                deviceInfoObj["deviceType"] = deviceInfo.deviceType;
+                deviceInfoObj["deviceID"] = std::to_string(entry.first);
+                deviceInfoObj["deviceType"] = string(bluetoothDeviceTypeName(deviceInfo.deviceType));
                 deviceInfoObj["autoconnect"] = static_cast<int>(deviceInfo.autoConnectStatus);
                 deviceInfoObj["lastConnectTimeUtc"] = deviceInfo.lastConnectTimeUtc;
                 deviceInfoObj["lastVolumeSetting"] = deviceInfo.lastVolumeSetting;
@@ -461,8 +498,6 @@ namespace WPEFramework {
             string bluetoothDeviceInfoStr;
             deviceInfoArray.ToString(bluetoothDeviceInfoStr);
 
-            _adminLock.Unlock();
-            
             LOGINFO("Saving device info JSON: %s", bluetoothDeviceInfoStr.c_str());
 
             Core::hresult result = pPersistentStore->SetValue(PERSISTENT_STORE_NAMESPACE, PERSISTENT_STORE_KEY_DEVICE_INFO, bluetoothDeviceInfoStr);
@@ -575,9 +610,14 @@ namespace WPEFramework {
             }
         }
 
-        Core::hresult BluetoothDeviceManager::getPairedDeviceInfo(const std::string& deviceID, BluetoothDeviceInfo& deviceInfo)
+        void BluetoothDeviceManager::publishSnapshot()
+        {
+            std::atomic_store(&_snapshot, std::shared_ptr<const BluetoothDeviceInfoMap>(std::make_shared<const BluetoothDeviceInfoMap>(_pairedDeviceCache)));
+        }
+
+        Core::hresult BluetoothDeviceManager::getPairedDeviceInfo(BTRMgrDeviceHandle deviceHandle, BluetoothDeviceInfo& deviceInfo)
         {
-            auto it = _pairedDeviceCache.find(deviceID);
+            auto it = _pairedDeviceCache.find(deviceHandle);
             const bool bFound = (it != _pairedDeviceCache.end());
 
             if (bFound) {
@@ -587,13 +627,13 @@ namespace WPEFramework {
             return bFound ? Core::ERROR_NONE : Core::ERROR_NOT_EXIST;
         }
 
-        Core::hresult BluetoothDeviceManager::setAutoConnect(const std::string& deviceID, bool enable)
+        Core::hresult BluetoothDeviceManager::setAutoConnect(BTRMgrDeviceHandle deviceHandle, bool enable)
         {
-            LOGINFO("deviceID=%s, enable=%s\n", deviceID.c_str(), enable ? "true" : "false");
+            LOGINFO("deviceID=%llu, enable=%s\n", deviceHandle, enable ? "true" : "false");
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             if (!_isMigrated.load()) {
-                LOGWARN("setAutoConnect rejected: migration has not been performed yet for deviceID=%s", deviceID.c_str());
+                LOGWARN("setAutoConnect rejected: migration has not been performed yet for deviceID=%llu", deviceHandle);
                 return Core::ERROR_GENERAL;
             }
 #endif
@@ -602,63 +642,71 @@ namespace WPEFramework {
 
             _adminLock.Lock();
 
-            Core::hresult result = getPairedDeviceInfo(deviceID, deviceInfo);
+            Core::hresult result = getPairedDeviceInfo(deviceHandle, deviceInfo);
 
             if (Core::ERROR_NONE != result) {
-                LOGERR("Device info is not found in cache for deviceID: %s", deviceID.c_str());
+                LOGERR("Device info is not found in cache for deviceID: %llu", deviceHandle);
                 _adminLock.Unlock();
                 return Core::ERROR_NOT_EXIST;
             }
 
             deviceInfo.autoConnectStatus = enable ? AUTO_CONNECT_STATUS_ENABLED : AUTO_CONNECT_STATUS_DISABLED;
-            _pairedDeviceCache[deviceID] = std::move(deviceInfo);
+            _pairedDeviceCache[deviceHandle] = std::move(deviceInfo);
+            publishSnapshot();
             _adminLock.Unlock();
                 
             result = writeStorageFromCache();
             if (Core::ERROR_NONE != result) {
-                LOGERR("Failed to update storage from cache after setting autoConnect for deviceID=%s", deviceID.c_str());
+                LOGERR("Failed to update storage from cache after setting autoConnect for deviceID=%llu", deviceHandle);
             }
 
             return result;
         }
 
-        Core::hresult BluetoothDeviceManager::getAutoConnect(const std::string& deviceID, AutoConnectStatus& status)
+        Core::hresult BluetoothDeviceManager::getAutoConnect(BTRMgrDeviceHandle deviceHandle, AutoConnectStatus& status)
         {
-            LOGINFO("deviceID=%s\n", deviceID.c_str());
+            LOGINFO("deviceID=%llu\n", deviceHandle);
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             if (!_isMigrated.load()) {
-                LOGINFO("migration not complete, returning disabled for deviceID=%s", deviceID.c_str());
+                LOGINFO("migration not complete, returning disabled for deviceID=%llu", deviceHandle);
                 status = AUTO_CONNECT_STATUS_DISABLED;
                 return Core::ERROR_NONE;
             }
 #endif
 
-            BluetoothDeviceInfo deviceInfo;
-
-            _adminLock.Lock();
-
-            Core::hresult result = getPairedDeviceInfo(deviceID, deviceInfo);
+            const std::shared_ptr<const BluetoothDeviceInfoMap> devices = snapshot();
+            auto it = devices->find(deviceHandle);
+            if (it == devices->end()) {
+                return Core::ERROR_NOT_EXIST;
+            }
 
-            _adminLock.Unlock();
+            // Consider AUTO_CONNECT_STATUS_UNSET --> AUTO_CONNECT_STATUS_DISABLED
+            status = (AUTO_CONNECT_STATUS_UNSET == it->second.autoConnectStatus) ? AUTO_CONNECT_STATUS_DISABLED : it->second.autoConnectStatus;
+            return Core::ERROR_NONE;
+        }
 
-            if (Core::ERROR_NONE == result) {
-                // Consider AUTO_CONNECT_STATUS_UNSET --> AUTO_CONNECT_STATUS_DISABLED
-                status = (AUTO_CONNECT_STATUS_UNSET == deviceInfo.autoConnectStatus) ? AUTO_CONNECT_STATUS_DISABLED : deviceInfo.autoConnectStatus;
+        Core::hresult BluetoothDeviceManager::getDeviceType(BTRMgrDeviceHandle deviceHandle, BluetoothDeviceType& deviceType)
+        {
+            const std::shared_ptr<const BluetoothDeviceInfoMap> devices = snapshot();
+            auto it = devices->find(deviceHandle);
+            if (it == devices->end()) {
+                return Core::ERROR_NOT_EXIST;
             }
-            
-            return result;
+
+            deviceType = it->second.deviceType;
+            return Core::ERROR_NONE;
         }
 
-        void BluetoothDeviceManager::setLastConnectTimeUtc(const std::string& deviceID)
+        void BluetoothDeviceManager::setLastConnectTimeUtc(BTRMgrDeviceHandle deviceHandle)
         {
             BluetoothDeviceInfo deviceInfo;
             _adminLock.Lock();
-            Core::hresult result = getPairedDeviceInfo(deviceID, deviceInfo);
+            Core::hresult result = getPairedDeviceInfo(deviceHandle, deviceInfo);
             _adminLock.Unlock();
 
             if (Core::ERROR_NONE != result) {
-                LOGERR("Device info is not found in cache for deviceID: %s", deviceID.c_str());
+                LOGERR("Device info is not found in cache for deviceID: %llu", deviceHandle);
                 return;
             }
 
@@ -666,97 +714,86 @@ namespace WPEFramework {
             std::time_t now_c = std::chrono::system_clock::to_time_t(now);
             const std::string currentUtcTime = std::to_string(static_cast<long long>(now_c));
 
-            LOGINFO("deviceID=%s, time=%s\n", deviceID.c_str(), currentUtcTime.c_str());
+            LOGINFO("deviceID=%llu, time=%s\n", deviceHandle, currentUtcTime.c_str());
 
             deviceInfo.lastConnectTimeUtc = std::move(currentUtcTime);
 
             _adminLock.Lock();
-            _pairedDeviceCache[deviceID] = std::move(deviceInfo);
+            _pairedDeviceCache[deviceHandle] = std::move(deviceInfo);
+            publishSnapshot();
             _adminLock.Unlock();
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             if (!_isMigrated.load()) {
-                LOGINFO("migration not complete, skipping persistence write for deviceID=%s", deviceID.c_str());
+                LOGINFO("migration not complete, skipping persistence write for deviceID=%llu", deviceHandle);
                 return;
             }
 #endif
             result = writeStorageFromCache();
             if (Core::ERROR_NONE != result) {
-                LOGERR("Failed to update storage from cache after setting lastConnectTimeUtc for deviceID=%s", deviceID.c_str());
+                LOGERR("Failed to update storage from cache after setting lastConnectTimeUtc for deviceID=%llu", deviceHandle);
             }
         }
 
-        Core::hresult BluetoothDeviceManager::setLastVolumeSetting(const std::string& deviceID, long long volumeSetting)
+        Core::hresult BluetoothDeviceManager::setLastVolumeSetting(BTRMgrDeviceHandle deviceHandle, long long volumeSetting)
         {
-            LOGINFO("deviceID=%s, volumeSetting=%lld", deviceID.c_str(), volumeSetting);
+            LOGINFO("deviceID=%llu, volumeSetting=%lld", deviceHandle, volumeSetting);
 
             BluetoothDeviceInfo deviceInfo;
 
             _adminLock.Lock();
 
-            Core::hresult result = getPairedDeviceInfo(deviceID, deviceInfo);
+            Core::hresult result = getPairedDeviceInfo(deviceHandle, deviceInfo);
 
             if (Core::ERROR_NONE != result) {
-                LOGERR("Device info is not found in cache for deviceID: %s", deviceID.c_str());
+                LOGERR("Device info is not found in cache for deviceID: %llu", deviceHandle);
                 _adminLock.Unlock();
                 return Core::ERROR_NOT_EXIST;
             }
 
             deviceInfo.lastVolumeSetting = volumeSetting;
-            _pairedDeviceCache[deviceID] = std::move(deviceInfo);
+            _pairedDeviceCache[deviceHandle] = std::move(deviceInfo);
+            publishSnapshot();
             _adminLock.Unlock();
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             if (!_isMigrated.load()) {
-                LOGINFO("migration not complete, skipping persistence write for deviceID=%s", deviceID.c_str());
+                LOGINFO("migration not complete, skipping persistence write for deviceID=%llu", deviceHandle);
                 return Core::ERROR_NONE;
             }
 #endif
             result = writeStorageFromCache();
             if (Core::ERROR_NONE != result) {
-                LOGERR("Failed to update storage from cache after setting lastVolumeSetting for deviceID=%s", deviceID.c_str());
+                LOGERR("Failed to update storage from cache after setting lastVolumeSetting for deviceID=%llu", deviceHandle);
             }
 
             return result;
         }
 
-        Core::hresult BluetoothDeviceManager::getLastConnectTimeUtc(const std::string& deviceID, std::string& lastConnectTimeUtc)
+        Core::hresult BluetoothDeviceManager::getLastConnectTimeUtc(BTRMgrDeviceHandle deviceHandle, std::string& lastConnectTimeUtc)
         {
-            LOGINFO("deviceID=%s\n", deviceID.c_str());
-            BluetoothDeviceInfo deviceInfo;
+            LOGINFO("deviceID=%llu\n", deviceHandle);
 
-            _adminLock.Lock();
-        
-            Core::hresult result = getPairedDeviceInfo(deviceID, deviceInfo);
-
-            _adminLock.Unlock();
-
-            if (Core::ERROR_NONE == result) {
-                lastConnectTimeUtc = deviceInfo.lastConnectTimeUtc;
+            const std::shared_ptr<const BluetoothDeviceInfoMap> devices = snapshot();
+            auto it = devices->find(deviceHandle);
+            if (it == devices->end()) {
+                return Core::ERROR_NOT_EXIST;
             }
-            
-            return result;
+
+            lastConnectTimeUtc = it->second.lastConnectTimeUtc;
+            return Core::ERROR_NONE;
         }
 
-        Core::hresult BluetoothDeviceManager::addDevice(const std::string& deviceID)
+        Core::hresult BluetoothDeviceManager::addDevice(BTRMgrDeviceHandle deviceHandle)
         {
-            BTRMgrDeviceHandle deviceHandle;
-
-            LOGINFO("deviceID=%s\n", deviceID.c_str());
-            
-            try {
-                deviceHandle = (BTRMgrDeviceHandle) stoll(deviceID);
-            } catch (const std::exception& e) {
-                LOGERR("Failed to parse deviceId: %s\n", e.what());
-                return Core::ERROR_INVALID_PARAMETER;
-            }
+            LOGINFO("deviceID=%llu\n", deviceHandle);
 
             BTRMGR_DevicesProperty_t deviceProperty{};
 
             BTRMGR_Result_t result = BTRMGR_GetDeviceProperties(0, deviceHandle, &deviceProperty);
             if (BTRMGR_RESULT_SUCCESS != result)
             {
-                LOGERR("Failed to get device properties for deviceID: %s", deviceID.c_str());
+                LOGERR("Failed to get device properties for deviceID: %llu", deviceHandle);
                 return Core::ERROR_NOT_EXIST;
             }
 
@@ -764,33 +801,32 @@ namespace WPEFramework {
 
             BluetoothDeviceInfo deviceInfo;
             deviceInfo.deviceAddr = (deviceProperty.m_deviceAddress[0] != '\0') ? std::string(deviceProperty.m_deviceAddress) : std::string();
-            const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(deviceProperty.m_deviceType);
-            deviceInfo.deviceType = (deviceTypeStr != nullptr) ? deviceTypeStr : "UNKNOWN";
-            deviceInfo.friendlyName = (deviceProperty.m_name[0] != '\0') ? std::string(deviceProperty.m_name) : deviceID;
-            _pairedDeviceCache[deviceID] = std::move(deviceInfo);
+            deviceInfo.deviceType = bluetoothDeviceTypeFromBtrmgr(deviceProperty.m_deviceType);
+            deviceInfo.friendlyName = (deviceProperty.m_name[0] != '\0') ? std::string(deviceProperty.m_name) : std::to_string(deviceHandle);
+            _pairedDeviceCache[deviceHandle] = std::move(deviceInfo);
+            publishSnapshot();
 
             _adminLock.Unlock();
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             if (!_isMigrated.load()) {
-                LOGINFO("migration not complete, skipping persistence write for deviceID=%s", deviceID.c_str());
+                LOGINFO("migration not complete, skipping persistence write for deviceID=%llu", deviceHandle);
                 return Core::ERROR_NONE;
             }
 #endif
             return writeStorageFromCache();
         }
 
-        Core::hresult BluetoothDeviceManager::removeDevice(const std::string& deviceID)
+        Core::hresult BluetoothDeviceManager::removeDevice(BTRMgrDeviceHandle deviceHandle)
         {
-            LOGINFO("deviceID=%s\n", deviceID.c_str());
+            LOGINFO("deviceID=%llu\n", deviceHandle);
 
             _adminLock.Lock();
 
-            auto it = _pairedDeviceCache.find(deviceID);
-            if (it != _pairedDeviceCache.end()) {
-                _pairedDeviceCache.erase(it);
+            if (0 != _pairedDeviceCache.erase(deviceHandle)) {
+                publishSnapshot();
             } else {
-                LOGWARN("Device info is not found in cache for deviceID: %s", deviceID.c_str());
+                LOGWARN("Device info is not found in cache for deviceID: %llu", deviceHandle);
                 _adminLock.Unlock();
                 return Core::ERROR_NOT_EXIST;
             }
@@ -799,26 +835,23 @@ namespace WPEFramework {
 
 #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
             if (!_isMigrated.load()) {
-                LOGINFO("migration not complete, skipping persistence write for deviceID=%s", deviceID.c_str());
+                LOGINFO("migration not complete, skipping persistence write for deviceID=%llu", deviceHandle);
                 return Core::ERROR_NONE;
             }
 #endif
             return writeStorageFromCache();
         }
 
-        std::unordered_map<std::string /* deviceID */, BluetoothDeviceInfo /* deviceInfo */> BluetoothDeviceManager::getPairedDeviceInfos()
+        BluetoothDeviceInfoMap BluetoothDeviceManager::getPairedDeviceInfos()
         {
-            _adminLock.Lock();
-
-            std::unordered_map<std::string /* deviceID */, BluetoothDeviceInfo /* deviceInfo */> deviceInfos;
+            BluetoothDeviceInfoMap deviceInfos;
 
              try {
-                 deviceInfos = _pairedDeviceCache;
+                 deviceInfos = *snapshot();
              } catch (...) {
                  LOGERR("Failed to copy paired device infos\n");
              }
 
-            _adminLock.Unlock();
             return deviceInfos;
         }
 
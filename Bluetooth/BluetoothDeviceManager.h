@@ -21,12 +21,15 @@
 
 #include "Module.h"
 #include <atomic>
-#include <unordered_map>
+#include <memory>
 #include <chrono>
 #include <ctime>
 #include <interfaces/IStore.h>
 #include <core/core.h>
 #include "UtilsJsonRpc.h"
+#include "BluetoothDeviceType.h"
+#include "BluetoothHandleMap.h"
+#include "btmgr.h"
 
 #define PERSISTENT_STORE_CALLSIGN "org.rdk.PersistentStore"
 #define PERSISTENT_STORE_NAMESPACE "Bluetooth"
@@ -47,13 +50,20 @@ namespace WPEFramework {
 
         typedef struct _BluetoothDeviceInfo {
             std::string         deviceAddr          = "";
-            std::string         deviceType          = "UNKNOWN";
+            BluetoothDeviceType deviceType          = BLUETOOTH_DEVICE_TYPE_UNKNOWN;
             std::string         friendlyName        = "";
             long long           lastVolumeSetting   = 0;
             AutoConnectStatus   autoConnectStatus   = AUTO_CONNECT_STATUS_UNSET;
             std::string         lastConnectTimeUtc  = "";
         } BluetoothDeviceInfo;
 
+        // Keyed by the BTRMGR device handle; the decimal deviceID string is only produced when
+        // the cache is written to or read from the persistent store.
+        typedef BluetoothHandleMap<BluetoothDeviceInfo /* deviceInfo */> BluetoothDeviceInfoMap;
+
+        // Parses a decimal deviceID as produced by std::to_string(BTRMgrDeviceHandle).
+        bool parseDeviceHandle(const std::string& deviceID, BTRMgrDeviceHandle& deviceHandle);
+
         class BluetoothDeviceManager {
 
             public:
@@ -64,14 +74,17 @@ namespace WPEFramework {
                 Core::hresult init(PluginHost::IShell* service);
                 void deinit();
 
-                Core::hresult setAutoConnect(const std::string& deviceID, bool enable);
-                Core::hresult getAutoConnect(const std::string& deviceID, AutoConnectStatus& status);
-                void setLastConnectTimeUtc(const std::string& deviceID);
-                Core::hresult getLastConnectTimeUtc(const std::string& deviceID, std::string& lastConnectTimeUtc);
-                Core::hresult setLastVolumeSetting(const std::string& deviceID, long long volumeSetting);
-                Core::hresult addDevice(const std::string& deviceID);
-                Core::hresult removeDevice(const std::string& deviceID);
-                std::unordered_map<std::string /* deviceID */, BluetoothDeviceInfo /* deviceInfo */> getPairedDeviceInfos();
+                Core::hresult setAutoConnect(BTRMgrDeviceHandle deviceHandle, bool enable);
+                // getAutoConnect, getDeviceType, getLastConnectTimeUtc and getPairedDeviceInfos read the
+                // published snapshot and never wait for _adminLock.
+                Core::hresult getAutoConnect(BTRMgrDeviceHandle deviceHandle, AutoConnectStatus& status);
+                Core::hresult getDeviceType(BTRMgrDeviceHandle deviceHandle, BluetoothDeviceType& deviceType);
+                void setLastConnectTimeUtc(BTRMgrDeviceHandle deviceHandle);
+                Core::hresult getLastConnectTimeUtc(BTRMgrDeviceHandle deviceHandle, std::string& lastConnectTimeUtc);
+                Core::hresult setLastVolumeSetting(BTRMgrDeviceHandle deviceHandle, long long volumeSetting);
+                Core::hresult addDevice(BTRMgrDeviceHandle deviceHandle);
+                Core::hresult removeDevice(BTRMgrDeviceHandle deviceHandle);
+                BluetoothDeviceInfoMap getPairedDeviceInfos();
         #ifdef BLUETOOTH_ENABLE_PERSISTENCE_MIGRATION
                 Core::hresult performMigration();
                 Core::hresult clearMigration();
@@ -82,9 +95,15 @@ namespace WPEFramework {
 
                 mutable Core::CriticalSection _adminLock;
                 PluginHost::IShell* _service = nullptr;
-                std::unordered_map<std::string /* deviceID */, BluetoothDeviceInfo /* deviceInfo */> _pairedDeviceCache;
+                BluetoothDeviceInfoMap _pairedDeviceCache;
+                // Immutable copy of _pairedDeviceCache, replaced through std::atomic_store after every
+                // mutation. Readers take a reference with std::atomic_load and look up without a lock.
+                std::shared_ptr<const BluetoothDeviceInfoMap> _snapshot = std::make_shared<const BluetoothDeviceInfoMap>();
 
-                Core::hresult getPairedDeviceInfo(const std::string& deviceID, BluetoothDeviceInfo& deviceInfo);
+                Core::hresult getPairedDeviceInfo(BTRMgrDeviceHandle deviceHandle, BluetoothDeviceInfo& deviceInfo);
+                // Called with _adminLock held, after every change of _pairedDeviceCache.
+                void publishSnapshot();
+                std::shared_ptr<const BluetoothDeviceInfoMap> snapshot() const { return std::atomic_load(&_snapshot); }
                 Core::hresult updateCacheFromStorage();
                 Core::hresult updateCacheFromDevice(bool backfillOnly = false);
                 Core::hresult writeStorageFromCache();
@@ -0,0 +1,94 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+#include <cctype>
+
+#include "BluetoothDeviceQuery.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        namespace {
+            std::string toLower(const std::string& value)
+            {
+                std::string result(value);
+                std::transform(result.begin(), result.end(), result.begin(),
+                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                return result;
+            }
+        } // namespace
+
+        void BluetoothDeviceQuery::addDeviceType(BTRMGR_DeviceType_t deviceType)
+        {
+            _filterDeviceTypes = true;
+            if (std::find(_deviceTypes.begin(), _deviceTypes.end(), deviceType) == _deviceTypes.end()) {
+                _deviceTypes.push_back(deviceType);
+            }
+        }
+
+        void BluetoothDeviceQuery::setName(const std::string& name)
+        {
+            _name = toLower(name);
+        }
+
+        bool BluetoothDeviceQuery::empty() const
+        {
+            return !_filterDeviceTypes && !_filterPaired && _name.empty() && (0 == _offset) && (0 == _limit) && (SORT_NONE == _sort);
+        }
+
+        bool BluetoothDeviceQuery::matches(const RegisteredDevice& device) const
+        {
+            if (_filterDeviceTypes && (std::find(_deviceTypes.begin(), _deviceTypes.end(), device.deviceType) == _deviceTypes.end())) {
+                return false;
+            }
+            if (_filterPaired && (device.paired != _paired)) {
+                return false;
+            }
+            if (!_name.empty() && (toLower(device.name).find(_name) == std::string::npos)) {
+                return false;
+            }
+            return true;
+        }
+
+        uint32_t BluetoothDeviceQuery::apply(std::vector<RegisteredDevice>& devices) const
+        {
+            devices.erase(std::remove_if(devices.begin(), devices.end(),
+                [this](const RegisteredDevice& device) { return !matches(device); }), devices.end());
+            const uint32_t total = static_cast<uint32_t>(devices.size());
+
+            if (SORT_LAST_SEEN == _sort) {
+                // Stable, so devices seen at the same time keep the order of the source list.
+                std::stable_sort(devices.begin(), devices.end(),
+                    [](const RegisteredDevice& a, const RegisteredDevice& b) { return a.lastSeenMs > b.lastSeenMs; });
+            }
+
+            if (_offset >= devices.size()) {
+                devices.clear();
+            } else if (_offset > 0) {
+                devices.erase(devices.begin(), devices.begin() + _offset);
+            }
+            if ((0 != _limit) && (devices.size() > _limit)) {
+                devices.resize(_limit);
+            }
+            return total;
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,80 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <string>
+#include <vector>
+
+#include "btmgr.h"
+#include "BluetoothDeviceRegistry.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Filter, sort order and page of a device list request. apply() narrows a list of devices
+        // down to the requested page so that only those get encoded into the response.
+        // An empty query keeps the list as it is.
+        class BluetoothDeviceQuery {
+
+            public:
+
+                enum Sort {
+                    SORT_NONE = 0,
+                    SORT_LAST_SEEN      // most recently seen first
+                };
+
+                BluetoothDeviceQuery() = default;
+                ~BluetoothDeviceQuery() = default;
+
+                // Every call adds a type to the set matched; once one was added, other types are filtered out.
+                void addDeviceType(BTRMGR_DeviceType_t deviceType);
+                // Restricts the set without adding to it, for a requested type that maps to no BTRMGR type.
+                void restrictDeviceTypes() { _filterDeviceTypes = true; }
+                void setPaired(bool paired) { _filterPaired = true; _paired = paired; }
+                // Case-insensitive substring of the device name.
+                void setName(const std::string& name);
+                void setOffset(uint32_t offset) { _offset = offset; }
+                // 0 for no limit.
+                void setLimit(uint32_t limit) { _limit = limit; }
+                void setSort(Sort sort) { _sort = sort; }
+                Sort sort() const { return _sort; }
+
+                bool empty() const;
+                bool matches(const RegisteredDevice& device) const;
+
+                // Filters, sorts and pages devices in place. Returns the number of devices that
+                // matched the filter, before offset and limit were applied.
+                uint32_t apply(std::vector<RegisteredDevice>& devices) const;
+
+            private:
+
+                bool _filterDeviceTypes = false;
+                std::vector<BTRMGR_DeviceType_t> _deviceTypes;
+                bool _filterPaired = false;
+                bool _paired = false;
+                std::string _name;      // lower case
+                uint32_t _offset = 0;
+                uint32_t _limit = 0;
+                Sort _sort = SORT_NONE;
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,363 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+
+#include "BluetoothDeviceRegistry.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        const char* BluetoothDeviceRegistry::listName(List list)
+        {
+            switch (list) {
+                case LIST_DISCOVERED: return "discovered";
+                case LIST_PAIRED: return "paired";
+                case LIST_CONNECTED: return "connected";
+                default: return "unknown";
+            }
+        }
+
+        template <typename DEVICE>
+        void BluetoothDeviceRegistry::assign(RegisteredDevice& device, const DEVICE& source)
+        {
+            device.deviceHandle = source.m_deviceHandle;
+            device.name = std::string(source.m_name);
+            device.deviceType = source.m_deviceType;
+            device.rawDeviceType = source.m_ui32DevClassBtSpec;
+            device.rawBleDeviceType = source.m_ui16DevAppearanceBleSpec;
+        }
+
+        bool BluetoothDeviceRegistry::member(const RegisteredDevice& device, List list)
+        {
+            switch (list) {
+                case LIST_DISCOVERED: return device.discovered;
+                case LIST_PAIRED: return device.paired;
+                case LIST_CONNECTED: return device.connected;
+                default: return false;
+            }
+        }
+
+        void BluetoothDeviceRegistry::setMember(RegisteredDevice& device, List list, bool value)
+        {
+            switch (list) {
+                case LIST_DISCOVERED: device.discovered = value; break;
+                case LIST_PAIRED: device.paired = value; break;
+                case LIST_CONNECTED: device.connected = value; break;
+                default: break;
+            }
+        }
+
+        namespace {
+
+            template <typename DEVICE>
+            bool differs(const RegisteredDevice& device, const DEVICE& source)
+            {
+                return (device.name != source.m_name) || (device.deviceType != source.m_deviceType);
+            }
+
+            // FNV-1a
+            uint64_t hashBytes(uint64_t hash, const void* data, size_t length)
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < length; ++i) {
+                    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+                }
+                return hash;
+            }
+
+            template <typename VALUE>
+            uint64_t hashValue(uint64_t hash, const VALUE value)
+            {
+                return hashBytes(hash, &value, sizeof(value));
+            }
+
+        } // namespace
+
+        uint64_t BluetoothDeviceRegistry::fingerprint(const RegisteredDevice& device, List list)
+        {
+            uint64_t hash = 14695981039346656037ULL;
+            hash = hashBytes(hash, device.name.data(), device.name.size());
+            hash = hashValue(hash, static_cast<int32_t>(device.deviceType));
+            hash = hashValue(hash, device.rawDeviceType);
+            hash = hashValue(hash, device.rawBleDeviceType);
+            if (LIST_PAIRED == list) {
+                hash = hashValue(hash, device.connected);
+            } else if (LIST_CONNECTED == list) {
+                hash = hashValue(hash, static_cast<int32_t>(device.powerStatus));
+            }
+            return hash;
+        }
+
+        void BluetoothDeviceRegistry::track(const RegisteredDevice& device)
+        {
+            for (const List list : { LIST_PAIRED, LIST_CONNECTED }) {
+                if (member(device, list)) {
+                    _trackers[list].set(device.deviceHandle, fingerprint(device, list));
+                } else {
+                    _trackers[list].remove(device.deviceHandle);
+                }
+            }
+        }
+
+        void BluetoothDeviceRegistry::touch(BTRMgrDeviceHandle deviceHandle)
+        {
+            _trackers[LIST_PAIRED].touch(deviceHandle);
+            _trackers[LIST_CONNECTED].touch(deviceHandle);
+        }
+
+        uint32_t BluetoothDeviceRegistry::syncDiscovered(const BTRMGR_DiscoveredDevicesList_t& list, uint64_t nowMs)
+        {
+            uint32_t mismatches = 0;
+            std::vector<BTRMgrDeviceHandle> handles;
+            handles.reserve(list.m_numOfDevices);
+
+            for (int i = 0; i < list.m_numOfDevices; i++) {
+                const BTRMGR_DiscoveredDevices_t& source = list.m_deviceProperty[i];
+                RegisteredDevice& device = _devices[source.m_deviceHandle];
+                if (!device.discovered || differs(device, source)) {
+                    ++mismatches;
+                }
+                if (!device.discovered) {
+                    device.lastSeenMs = nowMs;
+                }
+                assign(device, source);
+                device.discovered = true;
+                track(device);
+                handles.push_back(source.m_deviceHandle);
+            }
+
+            mismatches += removeMissing(LIST_DISCOVERED, handles);
+            return finishSync(LIST_DISCOVERED, mismatches);
+        }
+
+        uint32_t BluetoothDeviceRegistry::syncPaired(const BTRMGR_PairedDevicesList_t& list)
+        {
+            uint32_t mismatches = 0;
+            std::vector<BTRMgrDeviceHandle> handles;
+            handles.reserve(list.m_numOfDevices);
+
+            for (int i = 0; i < list.m_numOfDevices; i++) {
+                const BTRMGR_PairedDevices_t& source = list.m_deviceProperty[i];
+                RegisteredDevice& device = _devices[source.m_deviceHandle];
+                if (!device.paired || differs(device, source)) {
+                    ++mismatches;
+                }
+                assign(device, source);
+                device.paired = true;
+                track(device);
+                handles.push_back(source.m_deviceHandle);
+            }
+
+            mismatches += removeMissing(LIST_PAIRED, handles);
+            return finishSync(LIST_PAIRED, mismatches);
+        }
+
+        uint32_t BluetoothDeviceRegistry::syncConnected(const BTRMGR_ConnectedDevicesList_t& list)
+        {
+            uint32_t mismatches = 0;
+            std::vector<BTRMgrDeviceHandle> handles;
+            handles.reserve(list.m_numOfDevices);
+
+            for (int i = 0; i < list.m_numOfDevices; i++) {
+                const BTRMGR_ConnectedDevice_t& source = list.m_deviceProperty[i];
+                RegisteredDevice& device = _devices[source.m_deviceHandle];
+                if (!device.connected || differs(device, source)) {
+                    ++mismatches;
+                }
+                assign(device, source);
+                device.powerStatus = source.m_powerStatus;
+                device.connected = true;
+                track(device);
+                handles.push_back(source.m_deviceHandle);
+            }
+
+            mismatches += removeMissing(LIST_CONNECTED, handles);
+            return finishSync(LIST_CONNECTED, mismatches);
+        }
+
+        uint32_t BluetoothDeviceRegistry::removeMissing(List list, const std::vector<BTRMgrDeviceHandle>& handles)
+        {
+            uint32_t removed = 0;
+            for (auto it = _devices.begin(); it != _devices.end(); ) {
+                if (member(it->second, list) && (std::find(handles.begin(), handles.end(), it->first) == handles.end())) {
+                    setMember(it->second, list, false);
+                    track(it->second);
+                    ++removed;
+                }
+                if (!it->second.discovered && !it->second.paired && !it->second.connected) {
+                    it = _devices.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            return removed;
+        }
+
+        uint32_t BluetoothDeviceRegistry::finishSync(List list, uint32_t mismatches)
+        {
+            if (!_seeded[list]) {
+                _seeded[list] = true;
+                return 0;
+            }
+
+            ++_reconciliations;
+            _listMismatches[list] += mismatches;
+            _mismatches += mismatches;
+            return mismatches;
+        }
+
+        void BluetoothDeviceRegistry::eraseUnlisted(BTRMgrDeviceHandle deviceHandle)
+        {
+            auto it = _devices.find(deviceHandle);
+            if ((it != _devices.end()) && !it->second.discovered && !it->second.paired && !it->second.connected) {
+                _devices.erase(it);
+            }
+        }
+
+        bool BluetoothDeviceRegistry::apply(const BTRMGR_EventMessage_t& eventMsg, uint64_t nowMs)
+        {
+            switch (eventMsg.m_eventType) {
+                case BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED: {
+                    // BTRMGR starts every discovery with an empty list.
+                    for (auto it = _devices.begin(); it != _devices.end(); ) {
+                        it->second.discovered = false;
+                        if (!it->second.paired && !it->second.connected) {
+                            it = _devices.erase(it);
+                        } else {
+                            ++it;
+                        }
+                    }
+                    break;
+                }
+                case BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE: {
+                    const BTRMGR_DiscoveredDevices_t& source = eventMsg.m_discoveredDevice;
+                    if (source.m_isDiscovered) {
+                        RegisteredDevice& device = _devices[source.m_deviceHandle];
+                        assign(device, source);
+                        device.lastSeenMs = nowMs;
+                        device.discovered = true;
+                        track(device);
+                    } else {
+                        auto it = _devices.find(source.m_deviceHandle);
+                        if (it != _devices.end()) {
+                            it->second.discovered = false;
+                            eraseUnlisted(source.m_deviceHandle);
+                        }
+                    }
+                    break;
+                }
+                case BTRMGR_EVENT_DEVICE_PAIRING_COMPLETE: {
+                    RegisteredDevice& device = _devices[eventMsg.m_discoveredDevice.m_deviceHandle];
+                    assign(device, eventMsg.m_discoveredDevice);
+                    device.paired = true;
+                    track(device);
+                    break;
+                }
+                case BTRMGR_EVENT_DEVICE_FOUND: {
+                    // Only sent for paired devices coming into range.
+                    RegisteredDevice& device = _devices[eventMsg.m_pairedDevice.m_deviceHandle];
+                    assign(device, eventMsg.m_pairedDevice);
+                    device.lastSeenMs = nowMs;
+                    device.paired = true;
+                    track(device);
+                    break;
+                }
+                case BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE: {
+                    RegisteredDevice& device = _devices[eventMsg.m_pairedDevice.m_deviceHandle];
+                    assign(device, eventMsg.m_pairedDevice);
+                    device.powerStatus = BTRMGR_DEVICE_POWER_ACTIVE;
+                    device.connected = true;
+                    track(device);
+                    break;
+                }
+                case BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE:
+                case BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE:
+                case BTRMGR_EVENT_DEVICE_OUT_OF_RANGE: {
+                    auto it = _devices.find(eventMsg.m_pairedDevice.m_deviceHandle);
+                    if (it != _devices.end()) {
+                        it->second.connected = false;
+                        if (BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE == eventMsg.m_eventType) {
+                            it->second.paired = false;
+                        }
+                        track(it->second);
+                        eraseUnlisted(eventMsg.m_pairedDevice.m_deviceHandle);
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            ++_applied;
+            return true;
+        }
+
+        void BluetoothDeviceRegistry::devices(List list, std::vector<RegisteredDevice>& devices) const
+        {
+            devices.reserve(devices.size() + _devices.size());
+            for (const auto& entry : _devices) {
+                if (member(entry.second, list)) {
+                    devices.push_back(entry.second);
+                }
+            }
+        }
+
+        void BluetoothDeviceRegistry::devices(std::vector<RegisteredDevice>& devices) const
+        {
+            // A device that left every list is erased, so all of _devices is listed somewhere.
+            devices.reserve(devices.size() + _devices.size());
+            for (const auto& entry : _devices) {
+                devices.push_back(entry.second);
+            }
+        }
+
+        void BluetoothDeviceRegistry::devices(List list, const std::vector<BTRMgrDeviceHandle>& handles, std::vector<RegisteredDevice>& devices) const
+        {
+            devices.reserve(devices.size() + handles.size());
+            for (const BTRMgrDeviceHandle deviceHandle : handles) {
+                auto it = _devices.find(deviceHandle);
+                if ((it != _devices.end()) && member(it->second, list)) {
+                    devices.push_back(it->second);
+                }
+            }
+        }
+
+        uint32_t BluetoothDeviceRegistry::size(List list) const
+        {
+            uint32_t count = 0;
+            for (const auto& entry : _devices) {
+                if (member(entry.second, list)) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        void BluetoothDeviceRegistry::clear()
+        {
+            _devices.clear();
+            for (int list = 0; list < LIST_COUNT; ++list) {
+                _seeded[list] = false;
+                _trackers[list].clear();
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
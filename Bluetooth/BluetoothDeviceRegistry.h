@@ -0,0 +1,127 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <map>
+#include <string>
+#include <vector>
+
+#include "btmgr.h"
+#include "BluetoothDeviceListTracker.h"
+
+#define BLUETOOTH_DEVICE_REGISTRY_DEFAULT_INTERVAL_MS 0
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        typedef struct _RegisteredDevice {
+            BTRMgrDeviceHandle      deviceHandle        = 0;
+            std::string             name                = "";
+            BTRMGR_DeviceType_t     deviceType          = BTRMGR_DEVICE_TYPE_UNKNOWN;
+            unsigned int            rawDeviceType       = 0;
+            unsigned short          rawBleDeviceType    = 0;
+            BTRMGR_DevicePower_t    powerStatus         = BTRMGR_DEVICE_POWER_ACTIVE;
+            uint64_t                lastSeenMs          = 0;    // last discovery update or found event
+            bool                    discovered          = false;
+            bool                    paired              = false;
+            bool                    connected           = false;
+        } RegisteredDevice;
+
+        // In-plugin copy of the discovered, paired and connected device lists of BTRMGR.
+        // Each list is seeded by a sync*() call with the list read from BTRMGR, then kept current
+        // by apply() with the events of the dispatcher. Later sync*() calls reconcile the list and
+        // count every device whose state had drifted from BTRMGR as a mismatch.
+        // The paired and connected lists each advance a BluetoothDeviceListTracker as they change,
+        // which gives getPairedDevices and getConnectedDevices their generation and deltas.
+        class BluetoothDeviceRegistry {
+
+            public:
+
+                enum List {
+                    LIST_DISCOVERED = 0,
+                    LIST_PAIRED,
+                    LIST_CONNECTED,
+                    LIST_COUNT
+                };
+
+                BluetoothDeviceRegistry() = default;
+                ~BluetoothDeviceRegistry() = default;
+
+                static const char* listName(List list);
+
+                // Until a list was synced once it is not served, callers query BTRMGR instead.
+                bool seeded(List list) const { return _seeded[list]; }
+
+                // Each returns the number of mismatches found, 0 for the first sync of the list.
+                // Devices new to the discovered list are stamped with nowMs as last seen.
+                uint32_t syncDiscovered(const BTRMGR_DiscoveredDevicesList_t& list, uint64_t nowMs);
+                uint32_t syncPaired(const BTRMGR_PairedDevicesList_t& list);
+                uint32_t syncConnected(const BTRMGR_ConnectedDevicesList_t& list);
+
+                // Returns false for events that do not change any list.
+                bool apply(const BTRMGR_EventMessage_t& eventMsg, uint64_t nowMs);
+                // Number of events applied so far, lets the owner detect events that raced with a BTRMGR query.
+                uint64_t applied() const { return _applied; }
+
+                // Fingerprint of the fields getPairedDevices or getConnectedDevices report for device.
+                static uint64_t fingerprint(const RegisteredDevice& device, List list);
+                // Change log of the paired or connected list.
+                const BluetoothDeviceListTracker& tracker(List list) const { return _trackers[list]; }
+                // Marks the device changed in the tracked lists it is in, for fields kept outside the registry.
+                void touch(BTRMgrDeviceHandle deviceHandle);
+
+                // Devices of a list in handle order.
+                void devices(List list, std::vector<RegisteredDevice>& devices) const;
+                // The devices of handles that are in the list, in the order of handles.
+                void devices(List list, const std::vector<BTRMgrDeviceHandle>& handles, std::vector<RegisteredDevice>& devices) const;
+                // Every device that is in at least one of the lists, in handle order.
+                void devices(std::vector<RegisteredDevice>& devices) const;
+                uint32_t size(List list) const;
+                void clear();
+
+                uint64_t reconciliations() const { return _reconciliations; }
+                uint64_t mismatches() const { return _mismatches; }
+                uint64_t mismatches(List list) const { return _listMismatches[list]; }
+
+            private:
+
+                template <typename DEVICE>
+                static void assign(RegisteredDevice& device, const DEVICE& source);
+                static bool member(const RegisteredDevice& device, List list);
+                static void setMember(RegisteredDevice& device, List list, bool value);
+                // Marks every device of the list that is not in handles as removed, returns how many were.
+                uint32_t removeMissing(List list, const std::vector<BTRMgrDeviceHandle>& handles);
+                uint32_t finishSync(List list, uint32_t mismatches);
+                void eraseUnlisted(BTRMgrDeviceHandle deviceHandle);
+                // Reports the current state of device to the trackers of the paired and connected lists.
+                void track(const RegisteredDevice& device);
+
+                std::map<BTRMgrDeviceHandle, RegisteredDevice> _devices;
+                BluetoothDeviceListTracker _trackers[LIST_COUNT];   // the discovered list is not tracked
+                bool _seeded[LIST_COUNT] = { false, false, false };
+                uint64_t _listMismatches[LIST_COUNT] = { 0, 0, 0 };
+                uint64_t _applied = 0;
+                uint64_t _reconciliations = 0;
+                uint64_t _mismatches = 0;
+        };
+
+    } // Plugin
+} // WPEFramework
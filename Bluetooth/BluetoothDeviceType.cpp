@@ -0,0 +1,173 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <atomic>
+#include <mutex>
+
+#include "BluetoothDeviceType.h"
+
+#include "UtilsJsonRpc.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        static_assert((BLUETOOTH_DEVICE_TYPE_COUNT + BLUETOOTH_DEVICE_TYPE_MAX_INTERNED) <= 256, "device types fit in a uint8_t");
+
+        namespace {
+            typedef struct _BtrmgrDeviceTypeEntry {
+                BTRMGR_DeviceType_t btrmgrType;
+                BluetoothDeviceType type;
+            } BtrmgrDeviceTypeEntry;
+
+            // BTRMGR types whose BTRMGR_GetDeviceTypeAsString name is in kBluetoothDeviceTypes.
+            constexpr BtrmgrDeviceTypeEntry kBtrmgrDeviceTypes[] = {
+                { BTRMGR_DEVICE_TYPE_UNKNOWN,           BLUETOOTH_DEVICE_TYPE_UNKNOWN },
+                { BTRMGR_DEVICE_TYPE_WEARABLE_HEADSET,  BLUETOOTH_DEVICE_TYPE_WEARABLE_HEADSET },
+                { BTRMGR_DEVICE_TYPE_HANDSFREE,         BLUETOOTH_DEVICE_TYPE_HANDSFREE },
+                { BTRMGR_DEVICE_TYPE_LOUDSPEAKER,       BLUETOOTH_DEVICE_TYPE_LOUDSPEAKER },
+                { BTRMGR_DEVICE_TYPE_HEADPHONES,        BLUETOOTH_DEVICE_TYPE_HEADPHONES },
+                { BTRMGR_DEVICE_TYPE_SMARTPHONE,        BLUETOOTH_DEVICE_TYPE_SMARTPHONE },
+                { BTRMGR_DEVICE_TYPE_TABLET,            BLUETOOTH_DEVICE_TYPE_TABLET },
+                { BTRMGR_DEVICE_TYPE_HID,               BLUETOOTH_DEVICE_TYPE_HUMAN_INTERFACE_DEVICE },
+                { BTRMGR_DEVICE_TYPE_TILE,              BLUETOOTH_DEVICE_TYPE_LE_TILE }
+            };
+
+            constexpr uint8_t UNRESOLVED = 0xFF;
+
+            typedef struct _BtrmgrDeviceTypeIndex {
+                uint8_t types[BTRMGR_DEVICE_TYPE_END];
+            } BtrmgrDeviceTypeIndex;
+
+            constexpr BtrmgrDeviceTypeIndex indexBtrmgrDeviceTypes()
+            {
+                BtrmgrDeviceTypeIndex index {};
+                for (uint32_t type = 0; type < BTRMGR_DEVICE_TYPE_END; ++type) {
+                    index.types[type] = UNRESOLVED;
+                }
+                for (const BtrmgrDeviceTypeEntry& entry : kBtrmgrDeviceTypes) {
+                    index.types[entry.btrmgrType] = entry.type;
+                }
+                return index;
+            }
+
+            constexpr BtrmgrDeviceTypeIndex kBtrmgrDeviceTypeIndex = indexBtrmgrDeviceTypes();
+
+            // Other BTRMGR types, resolved by name on first use; UNRESOLVED until then.
+            std::atomic<uint8_t> resolvedTypes[BTRMGR_DEVICE_TYPE_END];
+            std::once_flag resolvedTypesInit;
+
+            BluetoothDeviceCategory categoryOfName(const std::string& name)
+            {
+                return ((name.find("KEYBOARD") != std::string::npos) ||
+                        (name.find("MOUSE") != std::string::npos) ||
+                        (name.find("JOYSTICK") != std::string::npos))
+                    ? BLUETOOTH_DEVICE_CATEGORY_HID : BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT;
+            }
+
+            // Append only. An entry is complete before internedCount covers it, and a value is only
+            // handed out after that, so lookups of interned values do not need internLock.
+            std::mutex internLock;
+            std::string internedNames[BLUETOOTH_DEVICE_TYPE_MAX_INTERNED];
+            BluetoothDeviceTypeEntry internedTypes[BLUETOOTH_DEVICE_TYPE_MAX_INTERNED];
+            std::atomic<uint32_t> internedCount { 0 };
+        } // namespace
+
+        const BluetoothDeviceTypeEntry& bluetoothInternedDeviceType(BluetoothDeviceType type)
+        {
+            const uint32_t index = static_cast<uint32_t>(type) - BLUETOOTH_DEVICE_TYPE_COUNT;
+            if ((type < BLUETOOTH_DEVICE_TYPE_COUNT) || (index >= internedCount.load(std::memory_order_acquire))) {
+                return kBluetoothDeviceTypes[BLUETOOTH_DEVICE_TYPE_UNKNOWN];
+            }
+            return internedTypes[index];
+        }
+
+        BluetoothDeviceType bluetoothDeviceTypeFromString(const std::string& name)
+        {
+            for (uint8_t type = 0; type < BLUETOOTH_DEVICE_TYPE_COUNT; ++type) {
+                if (name == kBluetoothDeviceTypes[type].name) {
+                    return static_cast<BluetoothDeviceType>(type);
+                }
+            }
+            if (name.empty()) {
+                return BLUETOOTH_DEVICE_TYPE_UNKNOWN;
+            }
+
+            std::lock_guard<std::mutex> lock(internLock);
+            const uint32_t count = internedCount.load(std::memory_order_relaxed);
+            for (uint32_t index = 0; index < count; ++index) {
+                if (name == internedNames[index]) {
+                    return static_cast<BluetoothDeviceType>(BLUETOOTH_DEVICE_TYPE_COUNT + index);
+                }
+            }
+            if (count >= BLUETOOTH_DEVICE_TYPE_MAX_INTERNED) {
+                LOGWARN("No room to intern device type '%s', treating it as UNKNOWN", name.c_str());
+                return BLUETOOTH_DEVICE_TYPE_UNKNOWN;
+            }
+
+            internedNames[count] = name;
+            internedTypes[count].name = internedNames[count].c_str();
+            internedTypes[count].category = categoryOfName(name);
+            internedCount.store(count + 1, std::memory_order_release);
+            return static_cast<BluetoothDeviceType>(BLUETOOTH_DEVICE_TYPE_COUNT + count);
+        }
+
+        BluetoothDeviceCategory bluetoothDeviceCategoryFromString(const std::string& name)
+        {
+            for (uint8_t type = 0; type < BLUETOOTH_DEVICE_TYPE_COUNT; ++type) {
+                if (name == kBluetoothDeviceTypes[type].name) {
+                    return kBluetoothDeviceTypes[type].category;
+                }
+            }
+            const uint32_t count = internedCount.load(std::memory_order_acquire);
+            for (uint32_t index = 0; index < count; ++index) {
+                if (name == internedNames[index]) {
+                    return internedTypes[index].category;
+                }
+            }
+            return categoryOfName(name);
+        }
+
+        BluetoothDeviceType bluetoothDeviceTypeFromBtrmgr(BTRMGR_DeviceType_t deviceType)
+        {
+            const uint32_t index = static_cast<uint32_t>(deviceType);
+            if (index < BTRMGR_DEVICE_TYPE_END) {
+                if (UNRESOLVED != kBtrmgrDeviceTypeIndex.types[index]) {
+                    return static_cast<BluetoothDeviceType>(kBtrmgrDeviceTypeIndex.types[index]);
+                }
+                std::call_once(resolvedTypesInit, []() {
+                    for (std::atomic<uint8_t>& resolved : resolvedTypes) {
+                        resolved.store(UNRESOLVED, std::memory_order_relaxed);
+                    }
+                });
+                const uint8_t resolved = resolvedTypes[index].load(std::memory_order_relaxed);
+                if (UNRESOLVED != resolved) {
+                    return static_cast<BluetoothDeviceType>(resolved);
+                }
+            }
+
+            const char* deviceTypeStr = BTRMGR_GetDeviceTypeAsString(deviceType);
+            const BluetoothDeviceType type = (nullptr != deviceTypeStr) ? bluetoothDeviceTypeFromString(deviceTypeStr) : BLUETOOTH_DEVICE_TYPE_UNKNOWN;
+            if (index < BTRMGR_DEVICE_TYPE_END) {
+                resolvedTypes[index].store(type, std::memory_order_relaxed);
+            }
+            return type;
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,128 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_DEVICE_TYPE_MAX_INTERNED 32
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // How the plugin connects to a device, see Bluetooth::setDeviceConnection().
+        typedef enum _BluetoothDeviceCategory : uint8_t {
+            BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT  = 0,
+            BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT,
+            BLUETOOTH_DEVICE_CATEGORY_HID,
+            BLUETOOTH_DEVICE_CATEGORY_LE
+        } BluetoothDeviceCategory;
+
+        // Device type names reported by BTRMGR_GetDeviceTypeAsString, interned once when a device
+        // enters the paired device cache. Values below BLUETOOTH_DEVICE_TYPE_COUNT index the constant
+        // kBluetoothDeviceTypes table, any other name gets one of up to BLUETOOTH_DEVICE_TYPE_MAX_INTERNED
+        // further values on first use, so names this table does not know are kept verbatim.
+        // Values are never persisted; the PersistentStore and the filesystem store keep the name.
+        typedef enum _BluetoothDeviceType : uint8_t {
+            BLUETOOTH_DEVICE_TYPE_UNKNOWN = 0,
+            BLUETOOTH_DEVICE_TYPE_WEARABLE_HEADSET,
+            BLUETOOTH_DEVICE_TYPE_HANDSFREE,
+            BLUETOOTH_DEVICE_TYPE_MICROPHONE,
+            BLUETOOTH_DEVICE_TYPE_LOUDSPEAKER,
+            BLUETOOTH_DEVICE_TYPE_HEADPHONES,
+            BLUETOOTH_DEVICE_TYPE_PORTABLE_AUDIO,
+            BLUETOOTH_DEVICE_TYPE_CAR_AUDIO,
+            BLUETOOTH_DEVICE_TYPE_STB,
+            BLUETOOTH_DEVICE_TYPE_HIFI_AUDIO_DEVICE,
+            BLUETOOTH_DEVICE_TYPE_VCR,
+            BLUETOOTH_DEVICE_TYPE_VIDEO_CAMERA,
+            BLUETOOTH_DEVICE_TYPE_CAMCODER,
+            BLUETOOTH_DEVICE_TYPE_VIDEO_MONITOR,
+            BLUETOOTH_DEVICE_TYPE_TV,
+            BLUETOOTH_DEVICE_TYPE_VIDEO_CONFERENCING,
+            BLUETOOTH_DEVICE_TYPE_SMARTPHONE,
+            BLUETOOTH_DEVICE_TYPE_TABLET,
+            BLUETOOTH_DEVICE_TYPE_HUMAN_INTERFACE_DEVICE,
+            BLUETOOTH_DEVICE_TYPE_LE_TILE,
+            BLUETOOTH_DEVICE_TYPE_COUNT
+        } BluetoothDeviceType;
+
+        typedef struct _BluetoothDeviceTypeEntry {
+            const char*             name;
+            BluetoothDeviceCategory category;
+        } BluetoothDeviceTypeEntry;
+
+        constexpr BluetoothDeviceTypeEntry kBluetoothDeviceTypes[BLUETOOTH_DEVICE_TYPE_COUNT] = {
+            { "UNKNOWN",                BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "WEARABLE HEADSET",       BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "HANDSFREE",              BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "MICROPHONE",             BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "LOUDSPEAKER",            BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "HEADPHONES",             BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "PORTABLE AUDIO",         BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "CAR AUDIO",              BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "STB",                    BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "HIFI AUDIO DEVICE",      BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "VCR",                    BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "VIDEO CAMERA",           BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "CAMCODER",               BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "VIDEO MONITOR",          BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "TV",                     BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "VIDEO CONFERENCING",     BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT },
+            { "SMARTPHONE",             BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT },
+            { "TABLET",                 BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT },
+            { "HUMAN INTERFACE DEVICE", BLUETOOTH_DEVICE_CATEGORY_HID },
+            { "LE TILE",                BLUETOOTH_DEVICE_CATEGORY_LE }
+        };
+
+        // Out of line part of the lookups below, for interned values.
+        const BluetoothDeviceTypeEntry& bluetoothInternedDeviceType(BluetoothDeviceType type);
+
+        inline const char* bluetoothDeviceTypeName(BluetoothDeviceType type)
+        {
+            return (type < BLUETOOTH_DEVICE_TYPE_COUNT) ? kBluetoothDeviceTypes[type].name : bluetoothInternedDeviceType(type).name;
+        }
+
+        inline BluetoothDeviceCategory bluetoothDeviceCategory(BluetoothDeviceType type)
+        {
+            return (type < BLUETOOTH_DEVICE_TYPE_COUNT) ? kBluetoothDeviceTypes[type].category : bluetoothInternedDeviceType(type).category;
+        }
+
+        // RCUs stay connected through power transitions and are not written to the filesystem store.
+        constexpr bool isHumanInterfaceDevice(BluetoothDeviceType type)
+        {
+            return (BLUETOOTH_DEVICE_TYPE_HUMAN_INTERFACE_DEVICE == type);
+        }
+
+        // Interns names the table does not hold; those that mention a keyboard, mouse or joystick
+        // are routed as HID, as setDeviceConnection() always did. An empty name is UNKNOWN, and so
+        // is every new name once the interned values ran out. Only for names BTRMGR or the stores
+        // supply, request input goes through bluetoothDeviceCategoryFromString().
+        BluetoothDeviceType bluetoothDeviceTypeFromString(const std::string& name);
+        // Category of a name as bluetoothDeviceTypeFromString() would route it, without interning it.
+        BluetoothDeviceCategory bluetoothDeviceCategoryFromString(const std::string& name);
+        // Looked up in a table indexed by the BTRMGR enum. Values the table does not map are resolved
+        // through BTRMGR_GetDeviceTypeAsString once and remembered.
+        BluetoothDeviceType bluetoothDeviceTypeFromBtrmgr(BTRMGR_DeviceType_t deviceType);
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,76 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothDiscoveryBatcher.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        void BluetoothDiscoveryBatcher::setLimits(uint32_t windowMs, uint32_t maxDevices)
+        {
+            _windowMs = windowMs;
+            _maxDevices = (0 == maxDevices) ? BLUETOOTH_DISCOVERY_BATCH_DEFAULT_SIZE : maxDevices;
+            _updates.reserve(_maxDevices);
+            _index.reserve(_maxDevices);
+        }
+
+        bool BluetoothDiscoveryBatcher::add(const DiscoveredDeviceUpdate& update, uint64_t nowMs, bool& windowOpened)
+        {
+            windowOpened = _updates.empty();
+            if (windowOpened) {
+                _windowStartMs = nowMs;
+            }
+
+            auto it = _index.find(update.deviceHandle);
+            if (it != _index.end()) {
+                _updates[it->second] = update;
+                ++_deduplicated;
+            } else {
+                _index.emplace(update.deviceHandle, _updates.size());
+                _updates.push_back(update);
+            }
+
+            return (_updates.size() >= _maxDevices);
+        }
+
+        uint64_t BluetoothDiscoveryBatcher::remaining(uint64_t nowMs) const
+        {
+            if (_updates.empty()) {
+                return 0;
+            }
+            const uint64_t closeMs = _windowStartMs + _windowMs;
+            return (nowMs >= closeMs) ? 0 : (closeMs - nowMs);
+        }
+
+        void BluetoothDiscoveryBatcher::take(std::vector<DiscoveredDeviceUpdate>& batch)
+        {
+            batch.swap(_updates);
+            _updates.clear();
+            _updates.reserve(_maxDevices);
+            _index.clear();
+        }
+
+        void BluetoothDiscoveryBatcher::clear()
+        {
+            _updates.clear();
+            _index.clear();
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,90 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_DISCOVERY_BATCH_DEFAULT_WINDOW_MS 500
+#define BLUETOOTH_DISCOVERY_BATCH_DEFAULT_SIZE 32
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        typedef enum _DiscoveryUpdateType {
+            DISCOVERY_UPDATE_DISCOVERED = 0,
+            DISCOVERY_UPDATE_LOST,
+            DISCOVERY_UPDATE_FOUND
+        } DiscoveryUpdateType;
+
+        typedef struct _DiscoveredDeviceUpdate {
+            BTRMgrDeviceHandle      deviceHandle        = 0;
+            DiscoveryUpdateType     updateType          = DISCOVERY_UPDATE_DISCOVERED;
+            std::string             name                = "";
+            BTRMGR_DeviceType_t     deviceType          = BTRMGR_DEVICE_TYPE_UNKNOWN;
+            unsigned int            rawDeviceType       = 0;
+            unsigned short          rawBleDeviceType    = 0;
+            bool                    lastConnectedState  = false;
+            bool                    paired              = false;
+        } DiscoveredDeviceUpdate;
+
+        // Accumulates discovery updates for the batched onDiscoveredDevices event.
+        // A batch is closed when the window that started with its first update elapses or
+        // when it holds the configured number of distinct devices. Repeated updates of a
+        // device inside a batch replace the earlier one in place.
+        class BluetoothDiscoveryBatcher {
+
+            public:
+
+                BluetoothDiscoveryBatcher() = default;
+                ~BluetoothDiscoveryBatcher() = default;
+
+                // A window of 0 disables batching.
+                void setLimits(uint32_t windowMs, uint32_t maxDevices);
+                bool enabled() const { return (0 != _windowMs); }
+                uint32_t window() const { return _windowMs; }
+
+                // Returns true when the batch reached maxDevices and must be flushed now.
+                // windowOpened is set when this update started a new batch.
+                bool add(const DiscoveredDeviceUpdate& update, uint64_t nowMs, bool& windowOpened);
+                // Delay until the window of the current batch elapses, 0 when it already did or no batch is open.
+                uint64_t remaining(uint64_t nowMs) const;
+                bool empty() const { return _updates.empty(); }
+                void take(std::vector<DiscoveredDeviceUpdate>& batch);
+                void clear();
+
+                uint64_t deduplicated() const { return _deduplicated; }
+
+            private:
+
+                uint32_t _windowMs = BLUETOOTH_DISCOVERY_BATCH_DEFAULT_WINDOW_MS;
+                uint32_t _maxDevices = BLUETOOTH_DISCOVERY_BATCH_DEFAULT_SIZE;
+                uint64_t _windowStartMs = 0;
+                uint64_t _deduplicated = 0;
+                std::vector<DiscoveredDeviceUpdate> _updates;
+                std::unordered_map<BTRMgrDeviceHandle, size_t /* index in _updates */> _index;
+        };
+
+    } // Plugin
+} // WPEFramework
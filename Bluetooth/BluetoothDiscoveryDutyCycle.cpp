@@ -0,0 +1,92 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothDiscoveryDutyCycle.h"
+
+#include <algorithm>
+
+// Devices seen are forgotten beyond this, they then count as new once more.
+#define BLUETOOTH_BACKGROUND_DISCOVERY_MAX_SEEN 1024
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        void BluetoothDiscoveryDutyCycle::setLimits(uint32_t scanMs, uint32_t minIdleMs, uint32_t maxIdleMs)
+        {
+            _scanMs = (0 == scanMs) ? BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_SCAN_MS : scanMs;
+            _minIdleMs = (0 == minIdleMs) ? BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_MIN_IDLE_MS : minIdleMs;
+            _maxIdleMs = std::max(_minIdleMs, (0 == maxIdleMs) ? BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_MAX_IDLE_MS : maxIdleMs);
+            _idleMs = 0;
+        }
+
+        bool BluetoothDiscoveryDutyCycle::deviceSeen(BTRMgrDeviceHandle deviceHandle)
+        {
+            if (_seen.size() >= BLUETOOTH_BACKGROUND_DISCOVERY_MAX_SEEN) {
+                _seen.clear();
+            }
+            if (!_seen.insert(deviceHandle).second) {
+                return false;
+            }
+            ++_newDevices;
+            return true;
+        }
+
+        BluetoothDiscoveryDutyCycle::Window BluetoothDiscoveryDutyCycle::next(const Conditions& conditions)
+        {
+            Window window;
+
+            if ((0 == _idleMs) || (0 != _newDevices)) {
+                _idleMs = _minIdleMs;
+            } else {
+                _idleMs = (_idleMs > (_maxIdleMs / 2)) ? _maxIdleMs : (_idleMs * 2);
+            }
+            _newDevices = 0;
+
+            if (conditions.suspended) {
+                window.idleMs = _maxIdleMs;
+            } else {
+                window.scanMs = _scanMs;
+                window.idleMs = _idleMs;
+                if (conditions.standby) {
+                    window.idleMs = _maxIdleMs;
+                }
+                if (conditions.audioStreaming) {
+                    window.scanMs = std::max(1u, _scanMs / 2);
+                    window.idleMs = std::max(window.idleMs, std::min(_maxIdleMs, _minIdleMs * 4));
+                }
+            }
+
+            if (0 != window.scanMs) {
+                _scanningMs += window.scanMs;
+                ++_cycles;
+            }
+            _current = window;
+            return window;
+        }
+
+        void BluetoothDiscoveryDutyCycle::reset()
+        {
+            _idleMs = 0;
+            _newDevices = 0;
+            _seen.clear();
+            _current = Window();
+        }
+
+    } // Plugin
+} // WPEFramework
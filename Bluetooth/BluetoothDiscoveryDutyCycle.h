@@ -0,0 +1,85 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <unordered_set>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_SCAN_MS      4000
+#define BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_MIN_IDLE_MS  8000
+#define BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_MAX_IDLE_MS  120000
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Plans the windows of background discovery: a short scan, then an idle window before the next one.
+        // The idle window is back at its minimum after a scan found a device not seen before and doubles
+        // up to its maximum after every scan that found none. While audio is streaming the scan is halved
+        // and the idle window lasts at least four minimum windows; in standby it lasts the maximum and
+        // when the device is suspended there is no scan at all.
+        class BluetoothDiscoveryDutyCycle {
+
+            public:
+
+                typedef struct _Conditions {
+                    bool    audioStreaming  = false;
+                    bool    standby         = false;
+                    bool    suspended       = false;
+                } Conditions;
+
+                typedef struct _Window {
+                    uint32_t    scanMs  = 0;
+                    uint32_t    idleMs  = 0;
+                } Window;
+
+                BluetoothDiscoveryDutyCycle() = default;
+                ~BluetoothDiscoveryDutyCycle() = default;
+
+                // 0 keeps the default of a limit; maxIdleMs is raised to minIdleMs.
+                void setLimits(uint32_t scanMs, uint32_t minIdleMs, uint32_t maxIdleMs);
+
+                // Counts a device reported by discovery, true if it was not seen before.
+                bool deviceSeen(BTRMgrDeviceHandle deviceHandle);
+                // Window following the scan that ended now, from the devices seen since the previous call.
+                Window next(const Conditions& conditions);
+                // Forgets the devices seen and the back-off, keeps the limits and the totals.
+                void reset();
+
+                const Window& current() const { return _current; }
+                uint64_t scanningMs() const { return _scanningMs; }
+                uint32_t cycles() const { return _cycles; }
+
+            private:
+
+                uint32_t _scanMs = BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_SCAN_MS;
+                uint32_t _minIdleMs = BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_MIN_IDLE_MS;
+                uint32_t _maxIdleMs = BLUETOOTH_BACKGROUND_DISCOVERY_DEFAULT_MAX_IDLE_MS;
+                uint32_t _idleMs = 0;   // back-off, 0 before the first window
+                uint32_t _newDevices = 0;
+                std::unordered_set<BTRMgrDeviceHandle> _seen;
+                Window _current;
+                uint64_t _scanningMs = 0;
+                uint32_t _cycles = 0;
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,127 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothDiscoveryIndex.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        void BluetoothDiscoveryIndex::setLimits(uint32_t ttlMs, uint32_t maxEntries, std::vector<DiscoveredDeviceUpdate>& evicted)
+        {
+            _ttlMs = ttlMs;
+            _maxEntries = (0 != maxEntries) ? maxEntries : 1;
+            while (_entries.size() > _maxEntries) {
+                drop(evicted);
+                ++_evicted;
+            }
+            while (_lostOrder.size() > _maxEntries) {
+                _lost.erase(_lostOrder.back());
+                _lostOrder.pop_back();
+            }
+        }
+
+        void BluetoothDiscoveryIndex::seen(const DiscoveredDeviceUpdate& update, uint64_t nowMs, std::vector<DiscoveredDeviceUpdate>& evicted)
+        {
+            auto found = _index.find(update.deviceHandle);
+            if (found != _index.end()) {
+                _entries.splice(_entries.begin(), _entries, found->second);
+            } else {
+                unmarkLost(update.deviceHandle);
+                if (_entries.size() >= _maxEntries) {
+                    drop(evicted);
+                    ++_evicted;
+                }
+                _entries.emplace_front();
+                _index[update.deviceHandle] = _entries.begin();
+            }
+
+            Entry& entry = _entries.front();
+            entry.update = update;
+            entry.lastSeenMs = nowMs;
+        }
+
+        bool BluetoothDiscoveryIndex::forget(BTRMgrDeviceHandle deviceHandle)
+        {
+            unmarkLost(deviceHandle);
+            auto found = _index.find(deviceHandle);
+            if (found == _index.end()) {
+                return false;
+            }
+            _entries.erase(found->second);
+            _index.erase(deviceHandle);
+            return true;
+        }
+
+        uint64_t BluetoothDiscoveryIndex::lastSeen(BTRMgrDeviceHandle deviceHandle) const
+        {
+            auto found = _index.find(deviceHandle);
+            return (found != _index.end()) ? found->second->lastSeenMs : 0;
+        }
+
+        uint64_t BluetoothDiscoveryIndex::expire(uint64_t nowMs, std::vector<DiscoveredDeviceUpdate>& expired)
+        {
+            while (!_entries.empty()) {
+                Entry& oldest = _entries.back();
+                const uint64_t expiryMs = oldest.lastSeenMs + _ttlMs;
+                if (expiryMs > nowMs) {
+                    return expiryMs - nowMs;
+                }
+
+                drop(expired);
+                ++_expired;
+            }
+            return 0;
+        }
+
+        void BluetoothDiscoveryIndex::clear()
+        {
+            _entries.clear();
+            _index.clear();
+            _lostOrder.clear();
+            _lost.clear();
+        }
+
+        void BluetoothDiscoveryIndex::drop(std::vector<DiscoveredDeviceUpdate>& dropped)
+        {
+            Entry& oldest = _entries.back();
+            const BTRMgrDeviceHandle deviceHandle = oldest.update.deviceHandle;
+            oldest.update.updateType = DISCOVERY_UPDATE_LOST;
+            dropped.push_back(std::move(oldest.update));
+            _index.erase(deviceHandle);
+            _entries.pop_back();
+
+            if (_lostOrder.size() >= _maxEntries) {
+                _lost.erase(_lostOrder.back());
+                _lostOrder.pop_back();
+            }
+            _lostOrder.push_front(deviceHandle);
+            _lost[deviceHandle] = _lostOrder.begin();
+        }
+
+        void BluetoothDiscoveryIndex::unmarkLost(BTRMgrDeviceHandle deviceHandle)
+        {
+            auto found = _lost.find(deviceHandle);
+            if (found != _lost.end()) {
+                _lostOrder.erase(found->second);
+                _lost.erase(deviceHandle);
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
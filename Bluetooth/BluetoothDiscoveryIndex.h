@@ -0,0 +1,99 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <list>
+#include <vector>
+
+#include "BluetoothDiscoveryBatcher.h"
+#include "BluetoothHandleMap.h"
+
+#define BLUETOOTH_DISCOVERY_INDEX_DEFAULT_TTL_MS 0
+#define BLUETOOTH_DISCOVERY_INDEX_DEFAULT_SIZE 256
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Last discovery update of every device seen recently, so that devices BTRMGR still lists
+        // but that were not seen for ttlMs can be reported lost and left out of getDiscoveredDevices.
+        // Devices are kept in one list ordered by the time they were last seen, most recent first,
+        // and indexed by handle. With a single TTL that order is also the order of expiry, so the
+        // tail of the list is both the next device to expire and the least recently seen one to
+        // drop when maxEntries is reached; every operation is O(1) per device.
+        // Expired and dropped devices alike are handed back as DISCOVERY_UPDATE_LOST updates and
+        // remembered as lost until they are seen again, at most maxEntries of them.
+        class BluetoothDiscoveryIndex {
+
+            public:
+
+                BluetoothDiscoveryIndex() = default;
+                ~BluetoothDiscoveryIndex() = default;
+
+                BluetoothDiscoveryIndex(const BluetoothDiscoveryIndex&) = delete;
+                BluetoothDiscoveryIndex& operator=(const BluetoothDiscoveryIndex&) = delete;
+
+                // A ttlMs of 0 disables the index, a maxEntries of 0 is taken as 1. Devices beyond
+                // maxEntries are moved to evicted.
+                void setLimits(uint32_t ttlMs, uint32_t maxEntries, std::vector<DiscoveredDeviceUpdate>& evicted);
+                bool enabled() const { return (0 != _ttlMs); }
+                uint32_t ttl() const { return _ttlMs; }
+
+                // Records update as the latest of its device. When the index is full the least recently
+                // seen device is moved to evicted.
+                void seen(const DiscoveredDeviceUpdate& update, uint64_t nowMs, std::vector<DiscoveredDeviceUpdate>& evicted);
+                // BTRMGR reported the device lost itself.
+                bool forget(BTRMgrDeviceHandle deviceHandle);
+                // Time the device was last seen, 0 if it is not indexed.
+                uint64_t lastSeen(BTRMgrDeviceHandle deviceHandle) const;
+                // The device was handed back by expire() or evicted and not seen since.
+                bool lost(BTRMgrDeviceHandle deviceHandle) const { return (0 != _lost.count(deviceHandle)); }
+
+                // Moves the devices not seen for ttl() to expired, as DISCOVERY_UPDATE_LOST updates.
+                // Returns the delay until the next device expires, 0 if the index is empty.
+                uint64_t expire(uint64_t nowMs, std::vector<DiscoveredDeviceUpdate>& expired);
+                void clear();
+
+                size_t size() const { return _entries.size(); }
+                uint64_t expired() const { return _expired; }
+                uint64_t evicted() const { return _evicted; }
+
+            private:
+
+                typedef struct _Entry {
+                    DiscoveredDeviceUpdate  update;
+                    uint64_t                lastSeenMs  = 0;
+                } Entry;
+
+                void drop(std::vector<DiscoveredDeviceUpdate>& dropped);
+                void unmarkLost(BTRMgrDeviceHandle deviceHandle);
+
+                std::list<Entry> _entries;     // most recently seen first
+                BluetoothHandleMap<std::list<Entry>::iterator> _index;
+                std::list<BTRMgrDeviceHandle> _lostOrder;  // most recently lost first
+                BluetoothHandleMap<std::list<BTRMgrDeviceHandle>::iterator> _lost;
+                uint32_t _ttlMs = BLUETOOTH_DISCOVERY_INDEX_DEFAULT_TTL_MS;
+                uint32_t _maxEntries = BLUETOOTH_DISCOVERY_INDEX_DEFAULT_SIZE;
+                uint64_t _expired = 0;
+                uint64_t _evicted = 0;
+        };
+
+    } // Plugin
+} // WPEFramework
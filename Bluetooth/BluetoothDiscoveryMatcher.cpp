@@ -0,0 +1,78 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <cctype>
+
+#include "BluetoothDiscoveryMatcher.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        std::string BluetoothDiscoveryMatcher::addressDigits(const std::string& address)
+        {
+            std::string digits;
+            digits.reserve(address.size());
+            for (const char c : address) {
+                if (std::isxdigit(static_cast<unsigned char>(c))) {
+                    digits.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+                }
+            }
+            return digits;
+        }
+
+        void BluetoothDiscoveryMatcher::add(BluetoothDiscoverySessions::SessionId sessionId, const Target& target)
+        {
+            _targets.emplace_back(sessionId, target);
+        }
+
+        void BluetoothDiscoveryMatcher::remove(BluetoothDiscoverySessions::SessionId sessionId)
+        {
+            for (auto it = _targets.begin(); it != _targets.end(); ++it) {
+                if (it->first == sessionId) {
+                    _targets.erase(it);
+                    return;
+                }
+            }
+        }
+
+        void BluetoothDiscoveryMatcher::match(const RegisteredDevice& device, const std::string& address, std::vector<BluetoothDiscoverySessions::SessionId>& matched)
+        {
+            std::string digits;
+            auto it = _targets.begin();
+            while (it != _targets.end()) {
+                const Target& target = it->second;
+                bool matches = target.query.matches(device);
+                if (matches && !target.addressPrefix.empty()) {
+                    if (digits.empty()) {
+                        digits = addressDigits(address);
+                    }
+                    matches = (0 == digits.compare(0, target.addressPrefix.size(), target.addressPrefix));
+                }
+
+                if (matches) {
+                    matched.push_back(it->first);
+                    it = _targets.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
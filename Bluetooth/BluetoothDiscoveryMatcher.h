@@ -0,0 +1,65 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BluetoothDeviceQuery.h"
+#include "BluetoothDiscoverySessions.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Match criteria of targeted discovery sessions, see startScan "match". Discovered and found
+        // devices are checked against every target; a target is dropped with its first match so that
+        // the owner can end the session it belongs to.
+        class BluetoothDiscoveryMatcher {
+
+            public:
+
+                typedef struct _Target {
+                    BluetoothDeviceQuery    query;          // device types, name and paired; paging is ignored
+                    std::string             addressPrefix;  // hex digits only, see addressDigits()
+                } Target;
+
+                BluetoothDiscoveryMatcher() = default;
+                ~BluetoothDiscoveryMatcher() = default;
+
+                // Upper case hex digits of a device address, separators left out.
+                static std::string addressDigits(const std::string& address);
+
+                void add(BluetoothDiscoverySessions::SessionId sessionId, const Target& target);
+                void remove(BluetoothDiscoverySessions::SessionId sessionId);
+                void clear() { _targets.clear(); }
+                bool empty() const { return _targets.empty(); }
+
+                // Drops the targets device matches and adds their sessions to matched.
+                void match(const RegisteredDevice& device, const std::string& address, std::vector<BluetoothDiscoverySessions::SessionId>& matched);
+
+            private:
+
+                std::vector<std::pair<BluetoothDiscoverySessions::SessionId, Target>> _targets;
+        };
+
+    } // Plugin
+} // WPEFramework
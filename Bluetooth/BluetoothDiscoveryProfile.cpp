@@ -0,0 +1,123 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <cctype>
+#include <strings.h>
+
+#include "BluetoothDiscoveryProfile.h"
+
+#include "UtilsJsonRpc.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        uint32_t bluetoothDiscoveryProfiles(const std::string& profileList, std::vector<std::string>* unknown)
+        {
+            uint32_t profiles = 0;
+            size_t begin = 0;
+            while (begin <= profileList.size()) {
+                size_t end = profileList.find(',', begin);
+                if (std::string::npos == end) {
+                    end = profileList.size();
+                }
+                size_t first = begin;
+                size_t last = end;
+                while ((first < last) && std::isspace(static_cast<unsigned char>(profileList[first]))) {
+                    ++first;
+                }
+                while ((last > first) && std::isspace(static_cast<unsigned char>(profileList[last - 1]))) {
+                    --last;
+                }
+
+                if (first < last) {
+                    const std::string token = profileList.substr(first, last - first);
+                    bool known = false;
+                    for (const BluetoothDiscoveryProfileEntry& entry : kBluetoothDiscoveryProfiles) {
+                        if (0 == strcasecmp(token.c_str(), entry.name)) {
+                            profiles |= entry.profiles;
+                            known = true;
+                            break;
+                        }
+                    }
+                    if (!known) {
+                        LOGWARN("Unknown profile '%s' ignored", token.c_str());
+                        if (nullptr != unknown) {
+                            unknown->push_back(token);
+                        }
+                    }
+                }
+                begin = end + 1;
+            }
+            return profiles;
+        }
+
+        uint32_t bluetoothDiscoveryProfilesOf(BTRMGR_DeviceOperationType_t type)
+        {
+            switch (type) {
+                case BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT:
+                    return BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT;
+                case BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT:
+                    return BLUETOOTH_DISCOVERY_PROFILE_AUDIO_INPUT;
+                case BTRMGR_DEVICE_OP_TYPE_HID:
+                    return BLUETOOTH_DISCOVERY_PROFILE_HID;
+                case BTRMGR_DEVICE_OP_TYPE_LE:
+                    return BLUETOOTH_DISCOVERY_PROFILE_LE;
+                case BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID:
+                    return BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT | BLUETOOTH_DISCOVERY_PROFILE_HID;
+                default:
+                    return BLUETOOTH_DISCOVERY_PROFILE_ALL;
+            }
+        }
+
+        BTRMGR_DeviceOperationType_t bluetoothDiscoveryOperationType(uint32_t profiles)
+        {
+            switch (profiles) {
+                case BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT:
+                    return BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
+                case BLUETOOTH_DISCOVERY_PROFILE_AUDIO_INPUT:
+                    return BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT;
+                case BLUETOOTH_DISCOVERY_PROFILE_HID:
+                    return BTRMGR_DEVICE_OP_TYPE_HID;
+                case BLUETOOTH_DISCOVERY_PROFILE_LE:
+                    return BTRMGR_DEVICE_OP_TYPE_LE;
+                case (BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT | BLUETOOTH_DISCOVERY_PROFILE_HID):
+                    return BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID;
+                default:
+                    return BTRMGR_DEVICE_OP_TYPE_UNKNOWN;
+            }
+        }
+
+        BTRMGR_DeviceOperationType_t bluetoothDeviceOperationType(uint32_t profiles)
+        {
+            if (BLUETOOTH_DISCOVERY_PROFILE_ALL == profiles) {
+                return BTRMGR_DEVICE_OP_TYPE_UNKNOWN;
+            } else if (profiles & BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT) {
+                return BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
+            } else if (profiles & BLUETOOTH_DISCOVERY_PROFILE_AUDIO_INPUT) {
+                return BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT;
+            } else if (profiles & BLUETOOTH_DISCOVERY_PROFILE_HID) {
+                return BTRMGR_DEVICE_OP_TYPE_HID;
+            } else if (profiles & BLUETOOTH_DISCOVERY_PROFILE_LE) {
+                return BTRMGR_DEVICE_OP_TYPE_LE;
+            }
+            return BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT;
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,73 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT    (1u << 0)
+#define BLUETOOTH_DISCOVERY_PROFILE_AUDIO_INPUT     (1u << 1)
+#define BLUETOOTH_DISCOVERY_PROFILE_HID             (1u << 2)
+#define BLUETOOTH_DISCOVERY_PROFILE_LE              (1u << 3)
+#define BLUETOOTH_DISCOVERY_PROFILE_ALL             (0xFu)
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        typedef struct _BluetoothDiscoveryProfileEntry {
+            const char* name;
+            uint32_t    profiles;
+        } BluetoothDiscoveryProfileEntry;
+
+        // Names accepted in a "profile" list, matched as whole comma separated tokens.
+        constexpr BluetoothDiscoveryProfileEntry kBluetoothDiscoveryProfiles[] = {
+            { "LOUDSPEAKER",        BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT },
+            { "HEADPHONES",         BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT },
+            { "WEARABLE HEADSET",   BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT },
+            { "HIFI AUDIO DEVICE",  BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT },
+            { "SMARTPHONE",         BLUETOOTH_DISCOVERY_PROFILE_AUDIO_INPUT },
+            { "TABLET",             BLUETOOTH_DISCOVERY_PROFILE_AUDIO_INPUT },
+            { "KEYBOARD",           BLUETOOTH_DISCOVERY_PROFILE_HID },
+            { "MOUSE",              BLUETOOTH_DISCOVERY_PROFILE_HID },
+            { "JOYSTICK",           BLUETOOTH_DISCOVERY_PROFILE_HID },
+            { "LE TILE",            BLUETOOTH_DISCOVERY_PROFILE_LE },
+            { "LE",                 BLUETOOTH_DISCOVERY_PROFILE_LE },
+            { "DEFAULT",            BLUETOOTH_DISCOVERY_PROFILE_ALL }
+        };
+
+        // Union of the profiles of a comma separated list, names compared case-insensitively.
+        // Unknown names are logged and appended to unknown, if given, and add nothing.
+        uint32_t bluetoothDiscoveryProfiles(const std::string& profileList, std::vector<std::string>* unknown = nullptr);
+
+        uint32_t bluetoothDiscoveryProfilesOf(BTRMGR_DeviceOperationType_t type);
+
+        // Narrowest operation type a single BTRMGR discovery finds all of profiles with. BTRMGR runs
+        // one discovery at a time, so a union no narrower type covers scans for everything; so do no profiles.
+        BTRMGR_DeviceOperationType_t bluetoothDiscoveryOperationType(uint32_t profiles);
+
+        // Operation type of a device for the volume and mute calls, which take one profile. A list
+        // naming several uses the first of audio output, audio input, HID and LE; none is audio output.
+        BTRMGR_DeviceOperationType_t bluetoothDeviceOperationType(uint32_t profiles);
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,97 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothDiscoverySessions.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        BluetoothDiscoverySessions::SessionId BluetoothDiscoverySessions::open(BTRMGR_DeviceOperationType_t type, uint64_t deadlineMs)
+        {
+            Session session;
+            session.id = ++_lastId;
+            if (0 == session.id) {
+                session.id = ++_lastId;
+            }
+            session.profiles = bluetoothDiscoveryProfilesOf(type);
+            session.deadlineMs = deadlineMs;
+            _sessions.push_back(session);
+            return session.id;
+        }
+
+        bool BluetoothDiscoverySessions::close(SessionId id)
+        {
+            for (auto it = _sessions.begin(); it != _sessions.end(); ++it) {
+                if (it->id == id) {
+                    _sessions.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        size_t BluetoothDiscoverySessions::expire(uint64_t nowMs, std::vector<SessionId>* expired)
+        {
+            const size_t before = _sessions.size();
+            auto it = _sessions.begin();
+            while (it != _sessions.end()) {
+                if (it->deadlineMs <= nowMs) {
+                    if (nullptr != expired) {
+                        expired->push_back(it->id);
+                    }
+                    it = _sessions.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            return before - _sessions.size();
+        }
+
+        void BluetoothDiscoverySessions::clear()
+        {
+            _sessions.clear();
+        }
+
+        uint64_t BluetoothDiscoverySessions::nextDeadline() const
+        {
+            uint64_t deadlineMs = 0;
+            for (const Session& session : _sessions) {
+                if ((0 == deadlineMs) || (session.deadlineMs < deadlineMs)) {
+                    deadlineMs = session.deadlineMs;
+                }
+            }
+            return deadlineMs;
+        }
+
+        BTRMGR_DeviceOperationType_t BluetoothDiscoverySessions::mergedType() const
+        {
+            uint32_t profiles = 0;
+            for (const Session& session : _sessions) {
+                profiles |= session.profiles;
+            }
+            return bluetoothDiscoveryOperationType(profiles);
+        }
+
+        bool BluetoothDiscoverySessions::covers(BTRMGR_DeviceOperationType_t running, BTRMGR_DeviceOperationType_t requested)
+        {
+            return (0 == (bluetoothDiscoveryProfilesOf(requested) & ~bluetoothDiscoveryProfilesOf(running)));
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,78 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <vector>
+
+#include "btmgr.h"
+#include "BluetoothDiscoveryProfile.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Reference counts the startScan callers sharing the single BTRMGR discovery. Every caller gets a
+        // session with its own deadline; the scan runs for the union of the requested operation types
+        // and lasts until the last session was released or timed out. The union only widens while the
+        // scan runs, so a session ending never restarts BTRMGR to narrow it.
+        // The owner starts and stops BTRMGR as told and schedules expire() from nextDeadline().
+        class BluetoothDiscoverySessions {
+
+            public:
+
+                typedef uint32_t SessionId;
+
+                BluetoothDiscoverySessions() = default;
+                ~BluetoothDiscoverySessions() = default;
+
+                // Adds a session scanning for type until deadlineMs. Returns its id, never 0.
+                SessionId open(BTRMGR_DeviceOperationType_t type, uint64_t deadlineMs);
+                // False if the session is unknown, it already ended.
+                bool close(SessionId id);
+                // Drops sessions whose deadline passed, returns how many. Their ids are added to expired if given.
+                size_t expire(uint64_t nowMs, std::vector<SessionId>* expired = nullptr);
+                void clear();
+
+                bool empty() const { return _sessions.empty(); }
+                size_t size() const { return _sessions.size(); }
+
+                // Earliest deadline of the open sessions, 0 if there is none.
+                uint64_t nextDeadline() const;
+                // Operation type covering every open session, BTRMGR_DEVICE_OP_TYPE_UNKNOWN (scan for
+                // everything) when no narrower type does.
+                BTRMGR_DeviceOperationType_t mergedType() const;
+
+                // True if a discovery started for running also finds devices of requested.
+                static bool covers(BTRMGR_DeviceOperationType_t running, BTRMGR_DeviceOperationType_t requested);
+
+            private:
+
+                typedef struct _Session {
+                    SessionId   id          = 0;
+                    uint32_t    profiles    = 0;
+                    uint64_t    deadlineMs  = 0;
+                } Session;
+
+                std::vector<Session> _sessions;
+                SessionId _lastId = 0;
+        };
+
+    } // Plugin
+} // WPEFramework
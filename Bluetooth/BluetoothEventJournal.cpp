@@ -0,0 +1,99 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothEventJournal.h"
+
+#include "UtilsJsonRpc.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        void BluetoothEventJournal::setCapacity(uint32_t capacity)
+        {
+            if (capacity > BLUETOOTH_EVENT_JOURNAL_MAX_SIZE) {
+                LOGWARN("Bluetooth event journal size %u capped to %u", capacity, BLUETOOTH_EVENT_JOURNAL_MAX_SIZE);
+                capacity = BLUETOOTH_EVENT_JOURNAL_MAX_SIZE;
+            }
+
+            clear();
+            _entries.clear();
+            _entries.resize(capacity);
+        }
+
+        uint64_t BluetoothEventJournal::oldest() const
+        {
+            return (0 == _size) ? 0 : _entries[_head].sequence;
+        }
+
+        void BluetoothEventJournal::append(uint64_t sequence, const std::string& event, const JsonObject& params)
+        {
+            if (_entries.empty()) {
+                return;
+            }
+
+            size_t index;
+            if (_size < _entries.size()) {
+                index = (_head + _size) % _entries.size();
+                ++_size;
+            } else {
+                index = _head;
+                _evictedSequence = _entries[_head].sequence;
+                _head = (_head + 1) % _entries.size();
+            }
+
+            Entry& entry = _entries[index];
+            entry.sequence = sequence;
+            entry.event = event;
+            entry.params = params;
+        }
+
+        bool BluetoothEventJournal::since(uint64_t sequence, std::vector<Entry>& entries) const
+        {
+            // A disabled journal holds nothing, so every sequence assigned after the requested one was missed.
+            const bool complete = _entries.empty() ? (sequence == _sequence)
+                                                   : ((sequence >= _evictedSequence) && (sequence <= _sequence));
+            if (sequence > _sequence) {
+                // Not ours, e.g. a sequence number from before a restart: replay everything held.
+                sequence = 0;
+            }
+
+            for (size_t i = 0; i < _size; ++i) {
+                const Entry& entry = _entries[(_head + i) % _entries.size()];
+                if (entry.sequence > sequence) {
+                    entries.push_back(entry);
+                }
+            }
+            return complete;
+        }
+
+        void BluetoothEventJournal::clear()
+        {
+            if (0 != _size) {
+                _evictedSequence = _entries[(_head + _size - 1) % _entries.size()].sequence;
+            }
+            for (Entry& entry : _entries) {
+                entry.event.clear();
+                entry.params.Clear();
+            }
+            _head = 0;
+            _size = 0;
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,77 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <string>
+#include <vector>
+
+#define BLUETOOTH_EVENT_JOURNAL_DEFAULT_SIZE 0
+#define BLUETOOTH_EVENT_JOURNAL_MAX_SIZE 1024
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Numbers every notification and keeps the last N of them for getEventsSince, so that a
+        // client subscribing late can replay what it missed instead of re-querying BTRMGR.
+        // Sequence numbers are assigned to every notification, only the ones appended are kept.
+        class BluetoothEventJournal {
+
+            public:
+
+                typedef struct _Entry {
+                    uint64_t    sequence    = 0;
+                    std::string event;
+                    JsonObject  params;
+                } Entry;
+
+                BluetoothEventJournal() = default;
+                ~BluetoothEventJournal() = default;
+
+                // A capacity of 0 disables the journal, sequence numbers are still assigned.
+                // Changing the capacity drops the held entries.
+                void setCapacity(uint32_t capacity);
+                uint32_t capacity() const { return static_cast<uint32_t>(_entries.size()); }
+                bool enabled() const { return !_entries.empty(); }
+
+                // Sequence numbers start at 1 and never go back, not even on clear().
+                uint64_t next() { return ++_sequence; }
+                uint64_t sequence() const { return _sequence; }
+                // Sequence of the oldest held entry, 0 when the journal is empty.
+                uint64_t oldest() const;
+
+                // Keeps the entry, evicting the oldest one when the journal is full.
+                void append(uint64_t sequence, const std::string& event, const JsonObject& params);
+                // Copies the held entries newer than sequence, oldest first. Returns false when entries
+                // newer than sequence were already evicted or never kept, or sequence was never assigned by this journal.
+                bool since(uint64_t sequence, std::vector<Entry>& entries) const;
+                void clear();
+
+            private:
+
+                std::vector<Entry> _entries;
+                size_t _head = 0;                   // index of the oldest entry
+                size_t _size = 0;
+                uint64_t _sequence = 0;
+                uint64_t _evictedSequence = 0;      // newest sequence no longer held
+        };
+
+    } // Plugin
+} // WPEFramework
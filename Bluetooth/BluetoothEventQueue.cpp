@@ -0,0 +1,259 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+#include <chrono>
+
+#include "BluetoothEventQueue.h"
+
+#include "UtilsJsonRpc.h"
+
+#define BLUETOOTH_EVENT_QUEUE_MAX_DEPTH 4096
+// Upper bound for the dispatcher sleep. Producers wake the dispatcher explicitly,
+// this only bounds the latency if a wakeup races with the dispatcher going idle.
+#define BLUETOOTH_EVENT_QUEUE_IDLE_WAIT_MS 100
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        namespace {
+            uint32_t roundUpToPowerOfTwo(uint32_t value)
+            {
+                uint32_t result = 1;
+                while (result < value) {
+                    result <<= 1;
+                }
+                return result;
+            }
+        } // namespace
+
+        BluetoothEventQueue::~BluetoothEventQueue()
+        {
+            stop();
+        }
+
+        Core::hresult BluetoothEventQueue::start(uint32_t depth, const Handler& handler)
+        {
+            if (_running.load()) {
+                LOGWARN("Bluetooth event queue is already running");
+                return Core::ERROR_ILLEGAL_STATE;
+            }
+            if (!handler) {
+                LOGERR("Bluetooth event queue requires a handler");
+                return Core::ERROR_INVALID_PARAMETER;
+            }
+
+            if (0 == depth) {
+                depth = BLUETOOTH_EVENT_QUEUE_DEFAULT_DEPTH;
+            } else if (depth > BLUETOOTH_EVENT_QUEUE_MAX_DEPTH) {
+                LOGWARN("Bluetooth event queue depth %u capped to %u", depth, BLUETOOTH_EVENT_QUEUE_MAX_DEPTH);
+                depth = BLUETOOTH_EVENT_QUEUE_MAX_DEPTH;
+            }
+
+            _capacity = roundUpToPowerOfTwo(depth);
+            _mask = _capacity - 1;
+            for (Ring& ring : _lanes) {
+                ring.slots.reset(new Slot[_capacity]);
+                for (uint32_t i = 0; i < _capacity; ++i) {
+                    ring.slots[i].sequence.store(i, std::memory_order_relaxed);
+                }
+                ring.enqueuePos.store(0, std::memory_order_relaxed);
+                ring.dequeuePos.store(0, std::memory_order_relaxed);
+                ring.highWatermark.store(0, std::memory_order_relaxed);
+                ring.enqueued.store(0, std::memory_order_relaxed);
+                ring.dropped.store(0, std::memory_order_relaxed);
+                ring.overflows.store(0, std::memory_order_relaxed);
+                ring.overflowing.store(false, std::memory_order_relaxed);
+            }
+
+            _handler = handler;
+            _running.store(true, std::memory_order_release);
+            _dispatcher = std::thread(&BluetoothEventQueue::dispatchLoop, this);
+
+            LOGINFO("Bluetooth event queue started with depth %u per lane", _capacity);
+            return Core::ERROR_NONE;
+        }
+
+        void BluetoothEventQueue::stop()
+        {
+            if (!_running.exchange(false)) {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_waitLock);
+                _wakeup.notify_one();
+            }
+            if (_dispatcher.joinable()) {
+                _dispatcher.join();
+            }
+
+            // A producer that passed the _running check before the exchange above is still copying
+            // into its slot; wait for it so the lanes stay valid until it is done. push() never blocks.
+            while (0 != _producers.load(std::memory_order_seq_cst)) {
+                std::this_thread::yield();
+            }
+
+            const uint32_t pending = size();
+            if (pending > 0) {
+                LOGWARN("Bluetooth event queue stopped, dropping %u undelivered events", pending);
+            }
+            LOGINFO("Bluetooth event queue stopped: enqueued=%llu dropped=%llu overflows=%llu highWatermark=%u",
+                static_cast<unsigned long long>(enqueued()), static_cast<unsigned long long>(dropped()),
+                static_cast<unsigned long long>(overflows()), highWatermark());
+        }
+
+        const char* BluetoothEventQueue::laneName(Lane lane)
+        {
+            return (LANE_INTERACTIVE == lane) ? "interactive" : "streaming";
+        }
+
+        uint32_t BluetoothEventQueue::size(Lane lane) const
+        {
+            const uint64_t enqueuePos = _lanes[lane].enqueuePos.load(std::memory_order_acquire);
+            const uint64_t dequeuePos = _lanes[lane].dequeuePos.load(std::memory_order_acquire);
+            return (enqueuePos > dequeuePos) ? static_cast<uint32_t>(enqueuePos - dequeuePos) : 0;
+        }
+
+        uint32_t BluetoothEventQueue::size() const
+        {
+            return size(LANE_INTERACTIVE) + size(LANE_STREAMING);
+        }
+
+        uint32_t BluetoothEventQueue::highWatermark() const
+        {
+            return std::max(highWatermark(LANE_INTERACTIVE), highWatermark(LANE_STREAMING));
+        }
+
+        uint64_t BluetoothEventQueue::enqueued() const
+        {
+            return enqueued(LANE_INTERACTIVE) + enqueued(LANE_STREAMING);
+        }
+
+        uint64_t BluetoothEventQueue::dropped() const
+        {
+            return dropped(LANE_INTERACTIVE) + dropped(LANE_STREAMING);
+        }
+
+        uint64_t BluetoothEventQueue::overflows() const
+        {
+            return overflows(LANE_INTERACTIVE) + overflows(LANE_STREAMING);
+        }
+
+        Core::hresult BluetoothEventQueue::push(const BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs, Lane lane)
+        {
+            // Reject early without touching the count, so callers retrying against a stopped queue cannot keep stop() waiting.
+            if (!_running.load(std::memory_order_acquire)) {
+                return Core::ERROR_UNAVAILABLE;
+            }
+            // Announce the producer before checking _running again, stop() waits for the count to drop to zero.
+            _producers.fetch_add(1, std::memory_order_seq_cst);
+            const Core::hresult result = _running.load(std::memory_order_seq_cst) ? enqueue(eventMsg, ingressUs, lane) : Core::ERROR_UNAVAILABLE;
+            _producers.fetch_sub(1, std::memory_order_release);
+            return result;
+        }
+
+        Core::hresult BluetoothEventQueue::enqueue(const BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs, Lane lane)
+        {
+            Ring& ring = _lanes[(LANE_INTERACTIVE == lane) ? LANE_INTERACTIVE : LANE_STREAMING];
+            Slot* slot = nullptr;
+            uint64_t pos = ring.enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                slot = &ring.slots[pos & _mask];
+                const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+                if (0 == diff) {
+                    if (ring.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    // The slot still holds an event the dispatcher has not consumed: lane is full.
+                    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+                    if (!ring.overflowing.exchange(true, std::memory_order_relaxed)) {
+                        ring.overflows.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return Core::ERROR_GENERAL;
+                } else {
+                    pos = ring.enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->eventMsg = eventMsg;
+            slot->ingressUs = ingressUs;
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            ring.enqueued.fetch_add(1, std::memory_order_relaxed);
+            ring.overflowing.store(false, std::memory_order_relaxed);
+
+            const uint64_t dequeuePos = ring.dequeuePos.load(std::memory_order_relaxed);
+            const uint32_t occupancy = (pos + 1 > dequeuePos) ? static_cast<uint32_t>(pos + 1 - dequeuePos) : 0;
+            uint32_t highWatermark = ring.highWatermark.load(std::memory_order_relaxed);
+            while ((occupancy > highWatermark) &&
+                   !ring.highWatermark.compare_exchange_weak(highWatermark, occupancy, std::memory_order_relaxed)) {
+            }
+
+            // Only take the wakeup lock when the dispatcher went idle; under load it is busy draining.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_waiting.load(std::memory_order_seq_cst)) {
+                std::lock_guard<std::mutex> lock(_waitLock);
+                _wakeup.notify_one();
+            }
+
+            return Core::ERROR_NONE;
+        }
+
+        bool BluetoothEventQueue::dispatchOne(Ring& ring)
+        {
+            const uint64_t pos = ring.dequeuePos.load(std::memory_order_relaxed);
+            Slot& slot = ring.slots[pos & _mask];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1) < 0) {
+                return false;
+            }
+
+            // Copy out and release the slot before running the handler so that a slow
+            // sendNotify does not reduce the capacity available to the BTRMGR thread.
+            BTRMGR_EventMessage_t eventMsg = slot.eventMsg;
+            const uint64_t ingressUs = slot.ingressUs;
+            slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+            ring.dequeuePos.store(pos + 1, std::memory_order_release);
+
+            _handler(eventMsg, ingressUs);
+            return true;
+        }
+
+        void BluetoothEventQueue::dispatchLoop()
+        {
+            while (_running.load(std::memory_order_acquire)) {
+                // Strict priority: one streaming event at most before the interactive lane is checked again.
+                if (dispatchOne(_lanes[LANE_INTERACTIVE]) || dispatchOne(_lanes[LANE_STREAMING])) {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(_waitLock);
+                _waiting.store(true, std::memory_order_seq_cst);
+                if ((0 == size()) && _running.load(std::memory_order_acquire)) {
+                    _wakeup.wait_for(lock, std::chrono::milliseconds(BLUETOOTH_EVENT_QUEUE_IDLE_WAIT_MS));
+                }
+                _waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,131 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <core/core.h>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_EVENT_QUEUE_DEFAULT_DEPTH 64
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Bounded multi-producer/single-consumer queue that decouples the BTRMGR callback
+        // thread from JSON encoding and sendNotify fan-out.
+        // Producers only claim a slot and copy the event message; they never block or allocate.
+        // When all slots are in use the event is dropped and accounted in the overflow counters.
+        // Events are pushed to one of two lanes, each a ring of depth slots. A single dispatcher
+        // thread owned by the queue drains each lane in FIFO order and the interactive lane always
+        // before the streaming lane, so there is no ordering between events of different lanes.
+        class BluetoothEventQueue {
+
+            public:
+
+                enum Lane {
+                    LANE_INTERACTIVE = 0,   // requests waiting for a user response
+                    LANE_STREAMING,         // device state changes, high rate telemetry and everything ordered with them
+                    LANE_COUNT
+                };
+
+                // ingressUs is the timestamp handed to push(), passed through untouched.
+                typedef std::function<void(BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs)> Handler;
+
+                BluetoothEventQueue() = default;
+                ~BluetoothEventQueue();
+
+                BluetoothEventQueue(const BluetoothEventQueue&) = delete;
+                BluetoothEventQueue& operator=(const BluetoothEventQueue&) = delete;
+
+                // depth is the number of slots of each lane, rounded up to the next power of two.
+                Core::hresult start(uint32_t depth, const Handler& handler);
+                // Stops the dispatcher and drops the events still queued. Returns once no producer
+                // is inside push(), so start() can reallocate the lanes afterwards.
+                void stop();
+
+                // Returns ERROR_UNAVAILABLE when the dispatcher is not running and
+                // ERROR_GENERAL when the event was dropped because the lane is full.
+                Core::hresult push(const BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs = 0, Lane lane = LANE_STREAMING);
+
+                static const char* laneName(Lane lane);
+
+                // Per lane depth.
+                uint32_t depth() const { return _capacity; }
+                // Counters summed over the lanes, the high watermark is the highest of any lane.
+                uint32_t size() const;
+                uint32_t highWatermark() const;
+                uint64_t enqueued() const;
+                uint64_t dropped() const;
+                uint64_t overflows() const;
+
+                uint32_t size(Lane lane) const;
+                uint32_t highWatermark(Lane lane) const { return _lanes[lane].highWatermark.load(std::memory_order_relaxed); }
+                uint64_t enqueued(Lane lane) const { return _lanes[lane].enqueued.load(std::memory_order_relaxed); }
+                uint64_t dropped(Lane lane) const { return _lanes[lane].dropped.load(std::memory_order_relaxed); }
+                uint64_t overflows(Lane lane) const { return _lanes[lane].overflows.load(std::memory_order_relaxed); }
+
+            private:
+
+                typedef struct _Slot {
+                    std::atomic<uint64_t>   sequence;
+                    BTRMGR_EventMessage_t   eventMsg;
+                    uint64_t                ingressUs;
+                } Slot;
+
+                typedef struct _Ring {
+                    std::unique_ptr<Slot[]> slots;
+                    std::atomic<uint64_t>   enqueuePos{0};
+                    std::atomic<uint64_t>   dequeuePos{0};
+
+                    std::atomic<uint32_t>   highWatermark{0};
+                    std::atomic<uint64_t>   enqueued{0};
+                    std::atomic<uint64_t>   dropped{0};
+                    // Number of times the lane transitioned from accepting to dropping events.
+                    std::atomic<uint64_t>   overflows{0};
+                    std::atomic<bool>       overflowing{false};
+                } Ring;
+
+                Core::hresult enqueue(const BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs, Lane lane);
+                bool dispatchOne(Ring& ring);
+                void dispatchLoop();
+
+                Ring _lanes[LANE_COUNT];
+                uint32_t _capacity = 0;
+                uint64_t _mask = 0;
+
+                Handler _handler;
+                std::thread _dispatcher;
+                std::atomic<bool> _running{false};
+                // Producers between their _running check and the release of their slot.
+                std::atomic<uint32_t> _producers{0};
+                std::atomic<bool> _waiting{false};
+                std::mutex _waitLock;
+                std::condition_variable _wakeup;
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,139 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothEventStats.h"
+
+#include <cstring>
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        constexpr uint32_t BluetoothLatencyHistogram::SUB_BUCKET_BITS;
+        constexpr uint32_t BluetoothLatencyHistogram::SUB_BUCKETS;
+        constexpr uint32_t BluetoothLatencyHistogram::BUCKETS;
+
+        uint32_t BluetoothLatencyHistogram::bucketOf(uint64_t valueUs)
+        {
+            if (valueUs < SUB_BUCKETS) {
+                return static_cast<uint32_t>(valueUs);
+            }
+            uint32_t msb = 63;
+            while (0 == (valueUs & (1ULL << msb))) {
+                --msb;
+            }
+            const uint32_t sub = static_cast<uint32_t>(valueUs >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+            return ((msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS) + sub;
+        }
+
+        uint64_t BluetoothLatencyHistogram::bucketUpperBound(uint32_t bucket)
+        {
+            if (bucket < SUB_BUCKETS) {
+                return bucket;
+            }
+            const uint32_t msb = (bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+            const uint64_t sub = bucket % SUB_BUCKETS;
+            const uint64_t width = 1ULL << (msb - SUB_BUCKET_BITS);
+            return (1ULL << msb) + ((sub + 1) * width) - 1;
+        }
+
+        void BluetoothLatencyHistogram::record(uint64_t valueUs)
+        {
+            ++_buckets[bucketOf(valueUs)];
+            ++_count;
+            if (valueUs > _max) {
+                _max = valueUs;
+            }
+        }
+
+        void BluetoothLatencyHistogram::reset()
+        {
+            _count = 0;
+            _max = 0;
+            memset(_buckets, 0, sizeof(_buckets));
+        }
+
+        uint64_t BluetoothLatencyHistogram::percentile(uint32_t percent) const
+        {
+            if (0 == _count) {
+                return 0;
+            }
+            if (percent > 100) {
+                percent = 100;
+            }
+
+            // Rank of the sample at the percentile, rounded up, at least the first sample.
+            uint64_t rank = ((_count * percent) + 99) / 100;
+            if (0 == rank) {
+                rank = 1;
+            }
+
+            uint64_t seen = 0;
+            for (uint32_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                seen += _buckets[bucket];
+                if (seen >= rank) {
+                    const uint64_t upperBound = bucketUpperBound(bucket);
+                    return (upperBound < _max) ? upperBound : _max;
+                }
+            }
+            return _max;
+        }
+
+        void BluetoothEventStats::record(BTRMGR_Events_t eventType, Stage stage, uint64_t valueUs)
+        {
+            if ((eventType < 0) || (eventType >= BTRMGR_EVENT_MAX) || (stage >= STAGE_COUNT)) {
+                return;
+            }
+            if (_events.size() < BTRMGR_EVENT_MAX) {
+                _events.resize(BTRMGR_EVENT_MAX);
+            }
+
+            std::unique_ptr<EventLatency>& latency = _events[eventType];
+            if (!latency) {
+                latency.reset(new EventLatency());
+            }
+            latency->stages[stage].record(valueUs);
+        }
+
+        void BluetoothEventStats::reset()
+        {
+            _events.clear();
+        }
+
+        const BluetoothLatencyHistogram* BluetoothEventStats::histogram(BTRMGR_Events_t eventType, Stage stage) const
+        {
+            if ((eventType < 0) || (static_cast<size_t>(eventType) >= _events.size()) || (stage >= STAGE_COUNT) || !_events[eventType]) {
+                return nullptr;
+            }
+            return &(_events[eventType]->stages[stage]);
+        }
+
+        const char* BluetoothEventStats::stageName(Stage stage)
+        {
+            switch (stage) {
+                case STAGE_QUEUE: return "queue";
+                case STAGE_ENCODE: return "encode";
+                case STAGE_NOTIFY: return "notify";
+                case STAGE_TOTAL: return "total";
+                default: break;
+            }
+            return "unknown";
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,101 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <memory>
+#include <vector>
+
+#include "btmgr.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Latency histogram in microseconds. Buckets are log2 ranges split in four linear
+        // sub-buckets, so a reported percentile is at most 25% above the recorded value.
+        class BluetoothLatencyHistogram {
+
+            public:
+
+                BluetoothLatencyHistogram() { reset(); }
+                ~BluetoothLatencyHistogram() = default;
+
+                void record(uint64_t valueUs);
+                void reset();
+
+                uint64_t count() const { return _count; }
+                uint64_t max() const { return _max; }
+                // Upper bound of the bucket holding the given percentile (0-100), capped by max().
+                uint64_t percentile(uint32_t percent) const;
+
+            private:
+
+                static constexpr uint32_t SUB_BUCKET_BITS = 2;
+                static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+                static constexpr uint32_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+                static uint32_t bucketOf(uint64_t valueUs);
+                static uint64_t bucketUpperBound(uint32_t bucket);
+
+                uint64_t _count;
+                uint64_t _max;
+                uint32_t _buckets[BUCKETS];
+        };
+
+        // Per BTRMGR event type latency of the event path, from the BTRMGR callback
+        // (ingress) to the end of sendNotify.
+        class BluetoothEventStats {
+
+            public:
+
+                enum Stage {
+                    STAGE_QUEUE = 0,    // ingress until the dispatcher picks the event up
+                    STAGE_ENCODE,       // building the notification payload
+                    STAGE_NOTIFY,       // sendNotify
+                    STAGE_TOTAL,        // ingress until sendNotify returned
+                    STAGE_COUNT
+                };
+
+                BluetoothEventStats() = default;
+                ~BluetoothEventStats() = default;
+
+                BluetoothEventStats(const BluetoothEventStats&) = delete;
+                BluetoothEventStats& operator=(const BluetoothEventStats&) = delete;
+
+                void record(BTRMGR_Events_t eventType, Stage stage, uint64_t valueUs);
+                void reset();
+
+                // Returns nullptr for event types without samples.
+                const BluetoothLatencyHistogram* histogram(BTRMGR_Events_t eventType, Stage stage) const;
+
+                static const char* stageName(Stage stage);
+
+            private:
+
+                typedef struct _EventLatency {
+                    BluetoothLatencyHistogram stages[STAGE_COUNT];
+                } EventLatency;
+
+                // Allocated on the first sample of an event type, most types are never seen.
+                std::vector<std::unique_ptr<EventLatency>> _events;
+        };
+
+    } // Plugin
+} // WPEFramework
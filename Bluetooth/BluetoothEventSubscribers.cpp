@@ -0,0 +1,88 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothEventSubscribers.h"
+
+#include "UtilsJsonRpc.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        void BluetoothEventSubscribers::Counter::onEventStatus(const std::string& client, Status status)
+        {
+            if (Status::registered == status) {
+                _count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            uint32_t count = _count.load(std::memory_order_relaxed);
+            while ((count > 0) && !_count.compare_exchange_weak(count, count - 1, std::memory_order_relaxed)) {
+            }
+            if (0 == count) {
+                LOGWARN("Unbalanced unregister from %s", client.c_str());
+            }
+        }
+
+        void BluetoothEventSubscribers::attach(PluginHost::JSONRPCSupportsEventStatus& dispatcher, const std::vector<std::string>& events)
+        {
+            if (_attached) {
+                LOGWARN("Event subscribers are already attached");
+                return;
+            }
+
+            for (const std::string& event : events) {
+                std::unique_ptr<Counter>& counter = _counters[event];
+                if (!counter) {
+                    counter.reset(new Counter());
+                }
+            }
+            for (auto& entry : _counters) {
+                entry.second->reset();
+                dispatcher.RegisterEventStatusListener(entry.first, &Counter::onEventStatus, entry.second.get());
+            }
+            _attached = true;
+        }
+
+        void BluetoothEventSubscribers::detach(PluginHost::JSONRPCSupportsEventStatus& dispatcher)
+        {
+            if (!_attached) {
+                return;
+            }
+
+            for (auto& entry : _counters) {
+                dispatcher.UnregisterEventStatusListener(entry.first);
+                entry.second->reset();
+            }
+            _attached = false;
+        }
+
+        bool BluetoothEventSubscribers::hasSubscribers(const std::string& event) const
+        {
+            auto it = _counters.find(event);
+            return (it == _counters.end()) || (it->second->count() > 0);
+        }
+
+        uint32_t BluetoothEventSubscribers::count(const std::string& event) const
+        {
+            auto it = _counters.find(event);
+            return (it == _counters.end()) ? 0 : it->second->count();
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,83 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Subscriber count per event name, kept up to date from the JSONRPC register and
+        // unregister notifications so the event path can skip building a payload nobody receives.
+        // Counters are created by attach() before any event is dispatched and are never removed
+        // while the plugin lives, so lookups need no lock. Events that are not tracked are
+        // always reported as subscribed.
+        class BluetoothEventSubscribers {
+
+            public:
+
+                typedef PluginHost::JSONRPCSupportsEventStatus::Status Status;
+
+                class Counter {
+
+                    public:
+
+                        Counter() : _count(0) {}
+                        ~Counter() = default;
+
+                        Counter(const Counter&) = delete;
+                        Counter& operator=(const Counter&) = delete;
+
+                        void onEventStatus(const std::string& client, Status status);
+                        uint32_t count() const { return _count.load(std::memory_order_relaxed); }
+                        void reset() { _count.store(0, std::memory_order_relaxed); }
+
+                    private:
+
+                        std::atomic<uint32_t> _count;
+                };
+
+                BluetoothEventSubscribers() = default;
+                ~BluetoothEventSubscribers() = default;
+
+                BluetoothEventSubscribers(const BluetoothEventSubscribers&) = delete;
+                BluetoothEventSubscribers& operator=(const BluetoothEventSubscribers&) = delete;
+
+                // Registers one status listener per distinct event name.
+                void attach(PluginHost::JSONRPCSupportsEventStatus& dispatcher, const std::vector<std::string>& events);
+                // Unregisters the listeners and zeroes the counts, the counters themselves stay.
+                void detach(PluginHost::JSONRPCSupportsEventStatus& dispatcher);
+
+                bool hasSubscribers(const std::string& event) const;
+                uint32_t count(const std::string& event) const;
+
+            private:
+
+                std::map<std::string, std::unique_ptr<Counter>> _counters;
+                bool _attached = false;
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,203 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Map keyed by a 64-bit BTRMGR device handle. Entries live densely in one vector, so
+        // iteration walks contiguous memory and iterators are plain vector iterators. Lookups
+        // go through a power-of-two open-addressing index of (handle, entry position) slots with
+        // linear probing; erase swaps the last entry into the freed position and closes the gap
+        // in the index by backward shifting, so the index never holds tombstones.
+        // Iterators are invalidated by insertion and erase, like those of a std::vector.
+        template <typename VALUE>
+        class BluetoothHandleMap {
+
+            public:
+
+                typedef uint64_t Key;
+                typedef std::pair<Key, VALUE> value_type;
+                typedef typename std::vector<value_type>::iterator iterator;
+                typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+                BluetoothHandleMap() = default;
+
+                size_t size() const { return _entries.size(); }
+                bool empty() const { return _entries.empty(); }
+
+                iterator begin() { return _entries.begin(); }
+                iterator end() { return _entries.end(); }
+                const_iterator begin() const { return _entries.begin(); }
+                const_iterator end() const { return _entries.end(); }
+
+                void clear()
+                {
+                    _entries.clear();
+                    _slots.clear();
+                }
+
+                void reserve(size_t count)
+                {
+                    _entries.reserve(count);
+                    if (capacityFor(count) > _slots.size()) {
+                        rehash(capacityFor(count));
+                    }
+                }
+
+                iterator find(Key key)
+                {
+                    const size_t slot = locate(key);
+                    return (NO_ENTRY == slot) ? _entries.end() : (_entries.begin() + _slots[slot].entry);
+                }
+
+                const_iterator find(Key key) const
+                {
+                    const size_t slot = locate(key);
+                    return (NO_ENTRY == slot) ? _entries.end() : (_entries.begin() + _slots[slot].entry);
+                }
+
+                size_t count(Key key) const { return (NO_ENTRY == locate(key)) ? 0 : 1; }
+
+                VALUE& operator[](Key key)
+                {
+                    const size_t slot = locate(key);
+                    if (NO_ENTRY != slot) {
+                        return _entries[_slots[slot].entry].second;
+                    }
+
+                    if (capacityFor(_entries.size() + 1) > _slots.size()) {
+                        rehash(capacityFor(_entries.size() + 1));
+                    }
+
+                    size_t index = home(key);
+                    while (NO_ENTRY != _slots[index].entry) {
+                        index = (index + 1) & (_slots.size() - 1);
+                    }
+                    _slots[index].key = key;
+                    _slots[index].entry = static_cast<uint32_t>(_entries.size());
+                    _entries.emplace_back(key, VALUE());
+                    return _entries.back().second;
+                }
+
+                size_t erase(Key key)
+                {
+                    size_t slot = locate(key);
+                    if (NO_ENTRY == slot) {
+                        return 0;
+                    }
+
+                    // Move the last entry into the freed position and repoint its slot.
+                    const uint32_t position = _slots[slot].entry;
+                    const uint32_t last = static_cast<uint32_t>(_entries.size() - 1);
+                    if (position != last) {
+                        _slots[locate(_entries[last].first)].entry = position;
+                        _entries[position] = std::move(_entries[last]);
+                    }
+                    _entries.pop_back();
+
+                    // Backward shift: pull every following slot of the probe run that may live
+                    // at or before the hole into it, until the run ends.
+                    const size_t mask = _slots.size() - 1;
+                    size_t next = (slot + 1) & mask;
+                    while (NO_ENTRY != _slots[next].entry) {
+                        const size_t wanted = home(_slots[next].key);
+                        if (((next - wanted) & mask) >= ((next - slot) & mask)) {
+                            _slots[slot] = _slots[next];
+                            slot = next;
+                        }
+                        next = (next + 1) & mask;
+                    }
+                    _slots[slot].entry = NO_ENTRY;
+                    return 1;
+                }
+
+            private:
+
+                static constexpr uint32_t NO_ENTRY = std::numeric_limits<uint32_t>::max();
+
+                typedef struct _Slot {
+                    Key         key     = 0;
+                    uint32_t    entry   = NO_ENTRY;
+                } Slot;
+
+                // Keeps the index at most half full so probe runs stay short.
+                static size_t capacityFor(size_t count)
+                {
+                    size_t capacity = 8;
+                    while (capacity < (count * 2)) {
+                        capacity <<= 1;
+                    }
+                    return capacity;
+                }
+
+                // Handles are derived from device addresses, so the low bits alone cluster;
+                // Fibonacci hashing spreads them over the index.
+                size_t home(Key key) const
+                {
+                    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - _shift)) & (_slots.size() - 1);
+                }
+
+                // Slot holding key, or NO_ENTRY.
+                size_t locate(Key key) const
+                {
+                    if (_slots.empty()) {
+                        return NO_ENTRY;
+                    }
+                    for (size_t index = home(key); NO_ENTRY != _slots[index].entry; index = (index + 1) & (_slots.size() - 1)) {
+                        if (_slots[index].key == key) {
+                            return index;
+                        }
+                    }
+                    return NO_ENTRY;
+                }
+
+                void rehash(size_t capacity)
+                {
+                    _slots.assign(capacity, Slot());
+                    _shift = 0;
+                    while ((static_cast<size_t>(1) << _shift) < capacity) {
+                        ++_shift;
+                    }
+                    for (uint32_t position = 0; position < _entries.size(); ++position) {
+                        size_t index = home(_entries[position].first);
+                        while (NO_ENTRY != _slots[index].entry) {
+                            index = (index + 1) & (capacity - 1);
+                        }
+                        _slots[index].key = _entries[position].first;
+                        _slots[index].entry = position;
+                    }
+                }
+
+                std::vector<value_type> _entries;
+                std::vector<Slot> _slots;
+                uint32_t _shift = 0;
+        };
+
+        template <typename VALUE>
+        constexpr uint32_t BluetoothHandleMap<VALUE>::NO_ENTRY;
+
+    } // Plugin
+} // WPEFramework
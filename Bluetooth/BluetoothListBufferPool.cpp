@@ -0,0 +1,44 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothListBufferPool.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        BluetoothListBufferPool<BTRMGR_DiscoveredDevicesList_t>& BluetoothListBuffers::discovered()
+        {
+            static BluetoothListBufferPool<BTRMGR_DiscoveredDevicesList_t> pool;
+            return pool;
+        }
+
+        BluetoothListBufferPool<BTRMGR_PairedDevicesList_t>& BluetoothListBuffers::paired()
+        {
+            static BluetoothListBufferPool<BTRMGR_PairedDevicesList_t> pool;
+            return pool;
+        }
+
+        BluetoothListBufferPool<BTRMGR_ConnectedDevicesList_t>& BluetoothListBuffers::connected()
+        {
+            static BluetoothListBufferPool<BTRMGR_ConnectedDevicesList_t> pool;
+            return pool;
+        }
+
+    } // Plugin
+} // WPEFramework
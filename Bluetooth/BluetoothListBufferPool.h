@@ -0,0 +1,152 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "btmgr.h"
+
+// Buffers kept per list type. Device list requests are serialized by the JSON-RPC and
+// timer threads in practice, two covers a request racing a registry reconciliation.
+#define BLUETOOTH_LIST_BUFFER_POOL_SLOTS 2
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Recycles the large fixed-size BTRMGR device list structures instead of allocating one
+        // per request. Buffers are zeroed when they are returned, so acquire() hands out a zeroed
+        // buffer either way. The free list is a fixed set of atomic slots: acquire() and release
+        // take a buffer out of or put it into a slot with a single atomic exchange, without a lock.
+        // A buffer returned while every slot is taken is freed.
+        template <typename LIST>
+        class BluetoothListBufferPool {
+
+            static_assert(std::is_trivially_copyable<LIST>::value, "BTRMGR lists are plain C structures");
+
+            public:
+
+                // Owns a buffer until it goes out of scope, then gives it back to the pool.
+                class Buffer {
+
+                    public:
+
+                        Buffer(Buffer&& other) : _pool(other._pool), _list(other._list) { other._list = nullptr; }
+                        ~Buffer() { if (nullptr != _list) { _pool->release(_list); } }
+
+                        Buffer(const Buffer&) = delete;
+                        Buffer& operator=(const Buffer&) = delete;
+                        Buffer& operator=(Buffer&&) = delete;
+
+                        // Null when the allocation failed.
+                        LIST* get() const { return _list; }
+                        LIST* operator->() const { return _list; }
+                        LIST& operator*() const { return *_list; }
+                        explicit operator bool() const { return (nullptr != _list); }
+
+                    private:
+
+                        friend class BluetoothListBufferPool;
+                        Buffer(BluetoothListBufferPool* pool, LIST* list) : _pool(pool), _list(list) {}
+
+                        BluetoothListBufferPool* _pool;
+                        LIST* _list;
+                };
+
+                BluetoothListBufferPool()
+                {
+                    for (std::atomic<LIST*>& slot : _slots) {
+                        slot.store(nullptr, std::memory_order_relaxed);
+                    }
+                }
+
+                ~BluetoothListBufferPool()
+                {
+                    for (std::atomic<LIST*>& slot : _slots) {
+                        delete slot.exchange(nullptr, std::memory_order_acquire);
+                    }
+                }
+
+                BluetoothListBufferPool(const BluetoothListBufferPool&) = delete;
+                BluetoothListBufferPool& operator=(const BluetoothListBufferPool&) = delete;
+
+                Buffer acquire()
+                {
+                    for (std::atomic<LIST*>& slot : _slots) {
+                        LIST* list = slot.exchange(nullptr, std::memory_order_acquire);
+                        if (nullptr != list) {
+                            _hits.fetch_add(1, std::memory_order_relaxed);
+                            return Buffer(this, list);
+                        }
+                    }
+
+                    _misses.fetch_add(1, std::memory_order_relaxed);
+                    // Value-initialized, i.e. zeroed like a recycled buffer.
+                    return Buffer(this, new (std::nothrow) LIST());
+                }
+
+                uint64_t hits() const { return _hits.load(std::memory_order_relaxed); }
+                uint64_t misses() const { return _misses.load(std::memory_order_relaxed); }
+                // Buffers currently waiting in the pool.
+                uint32_t pooled() const
+                {
+                    uint32_t count = 0;
+                    for (const std::atomic<LIST*>& slot : _slots) {
+                        if (nullptr != slot.load(std::memory_order_relaxed)) {
+                            ++count;
+                        }
+                    }
+                    return count;
+                }
+
+            private:
+
+                void release(LIST* list)
+                {
+                    memset(list, 0, sizeof(LIST));
+                    for (std::atomic<LIST*>& slot : _slots) {
+                        LIST* expected = nullptr;
+                        if (slot.compare_exchange_strong(expected, list, std::memory_order_release, std::memory_order_relaxed)) {
+                            return;
+                        }
+                    }
+                    delete list;
+                }
+
+                std::atomic<LIST*> _slots[BLUETOOTH_LIST_BUFFER_POOL_SLOTS];
+                std::atomic<uint64_t> _hits { 0 };
+                std::atomic<uint64_t> _misses { 0 };
+        };
+
+        // Pools shared by the plugin and the device manager, one per BTRMGR list type.
+        class BluetoothListBuffers {
+
+            public:
+
+                static BluetoothListBufferPool<BTRMGR_DiscoveredDevicesList_t>& discovered();
+                static BluetoothListBufferPool<BTRMGR_PairedDevicesList_t>& paired();
+                static BluetoothListBufferPool<BTRMGR_ConnectedDevicesList_t>& connected();
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,335 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <chrono>
+
+#include "BluetoothOperationExecutor.h"
+
+#include "UtilsJsonRpc.h"
+
+#define BLUETOOTH_OPERATION_MAX_WORKERS 8
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        BluetoothOperationExecutor::~BluetoothOperationExecutor()
+        {
+            stop();
+        }
+
+        const char* BluetoothOperationExecutor::stateName(State state)
+        {
+            switch (state) {
+                case STATE_PENDING:     return "PENDING";
+                case STATE_RUNNING:     return "RUNNING";
+                case STATE_SUCCEEDED:   return "SUCCEEDED";
+                case STATE_FAILED:      return "FAILED";
+                case STATE_CANCELLED:   return "CANCELLED";
+                default:                return "UNKNOWN";
+            }
+        }
+
+        uint64_t BluetoothOperationExecutor::nowMs()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        Core::hresult BluetoothOperationExecutor::start(uint32_t workers, const Completion& completion)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_running) {
+                LOGWARN("Bluetooth operation executor is already running");
+                return Core::ERROR_ILLEGAL_STATE;
+            }
+
+            if (0 == workers) {
+                LOGWARN("Bluetooth operation workers raised to 1");
+                workers = 1;
+            } else if (workers > BLUETOOTH_OPERATION_MAX_WORKERS) {
+                LOGWARN("Bluetooth operation workers %u capped to %u", workers, BLUETOOTH_OPERATION_MAX_WORKERS);
+                workers = BLUETOOTH_OPERATION_MAX_WORKERS;
+            }
+
+            _completion = completion;
+            _running = true;
+            for (uint32_t i = 0; i < workers; ++i) {
+                _workers.emplace_back(&BluetoothOperationExecutor::workerLoop, this);
+            }
+            return Core::ERROR_NONE;
+        }
+
+        void BluetoothOperationExecutor::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (!_running) {
+                    return;
+                }
+                _running = false;
+                _wakeup.notify_all();
+            }
+            for (std::thread& worker : _workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+            _workers.clear();
+
+            std::lock_guard<std::mutex> lock(_lock);
+            for (Entry& entry : _jobs) {
+                if (entry.waiter) {
+                    entry.waiter->done = true;
+                }
+            }
+            _done.notify_all();
+            _jobs.clear();
+            _devices.clear();
+            _pending = 0;
+            _finished = 0;
+        }
+
+        BluetoothOperationExecutor::JobId BluetoothOperationExecutor::enqueue(const std::string& operation, BTRMgrDeviceHandle deviceHandle,
+                                                                              const Operation& run, const std::shared_ptr<Waiter>& waiter)
+        {
+            if (_pending >= BLUETOOTH_OPERATION_MAX_PENDING) {
+                LOGERR("%u operations pending, %s refused", _pending, operation.c_str());
+                return 0;
+            }
+
+            Entry entry;
+            entry.job.id = ++_lastId;
+            if (0 == entry.job.id) {
+                entry.job.id = ++_lastId;
+            }
+            entry.job.operation = operation;
+            entry.job.deviceHandle = deviceHandle;
+            entry.job.submittedMs = nowMs();
+            entry.job.async = !waiter;
+            entry.run = run;
+            entry.waiter = waiter;
+            _jobs.push_back(std::move(entry));
+            ++_devices[deviceHandle].depth;
+            ++_pending;
+            _wakeup.notify_one();
+            return _jobs.back().job.id;
+        }
+
+        BluetoothOperationExecutor::JobId BluetoothOperationExecutor::submit(const std::string& operation, BTRMgrDeviceHandle deviceHandle, const Operation& run)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (!_running) {
+                LOGERR("Bluetooth operation executor is not running, %s refused", operation.c_str());
+                return 0;
+            }
+            return enqueue(operation, deviceHandle, run, nullptr);
+        }
+
+        bool BluetoothOperationExecutor::execute(const std::string& operation, BTRMgrDeviceHandle deviceHandle, const Operation& run)
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            if (!_running) {
+                lock.unlock();
+                return run();
+            }
+
+            std::shared_ptr<Waiter> waiter = std::make_shared<Waiter>();
+            if (0 == enqueue(operation, deviceHandle, run, waiter)) {
+                return false;
+            }
+            _done.wait(lock, [&waiter]() { return waiter->done; });
+            return waiter->result;
+        }
+
+        bool BluetoothOperationExecutor::status(JobId id, Job& job) const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            for (const Entry& entry : _jobs) {
+                if (entry.job.id == id) {
+                    job = entry.job;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::deque<BluetoothOperationExecutor::Entry>::iterator BluetoothOperationExecutor::find(JobId id)
+        {
+            std::deque<Entry>::iterator entry = _jobs.begin();
+            while ((entry != _jobs.end()) && (entry->job.id != id)) {
+                ++entry;
+            }
+            return entry;
+        }
+
+        Core::hresult BluetoothOperationExecutor::cancel(JobId id)
+        {
+            Job job;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                std::deque<Entry>::iterator entry = find(id);
+                if (entry == _jobs.end()) {
+                    return Core::ERROR_UNKNOWN_KEY;
+                }
+                if (STATE_PENDING != entry->job.state) {
+                    return Core::ERROR_ILLEGAL_STATE;
+                }
+
+                --_pending;
+                job = finish(entry, STATE_CANCELLED, false);
+            }
+
+            if (job.async && _completion) {
+                _completion(job);
+            }
+            return Core::ERROR_NONE;
+        }
+
+        BluetoothOperationExecutor::Job BluetoothOperationExecutor::finish(std::deque<Entry>::iterator entry, State state, bool result)
+        {
+            entry->job.state = state;
+            entry->job.finishedMs = nowMs();
+            entry->run = nullptr;
+            const Job job = entry->job;
+
+            BluetoothHandleMap<DeviceQueue>::iterator device = _devices.find(job.deviceHandle);
+            if (device != _devices.end()) {
+                --device->second.depth;
+                if ((0 == device->second.depth) && !device->second.running && (_devices.size() > BLUETOOTH_OPERATION_HISTORY)) {
+                    _devices.erase(job.deviceHandle);
+                }
+            }
+
+            if (entry->waiter) {
+                entry->waiter->result = result;
+                entry->waiter->done = true;
+                _done.notify_all();
+                _jobs.erase(entry);
+            } else {
+                ++_finished;
+                trimHistory();
+            }
+            return job;
+        }
+
+        void BluetoothOperationExecutor::trimHistory()
+        {
+            // Jobs of different devices finish out of order, drop the oldest finished ones wherever they are.
+            for (std::deque<Entry>::iterator entry = _jobs.begin(); (_finished > BLUETOOTH_OPERATION_HISTORY) && (entry != _jobs.end());) {
+                if (finished(*entry)) {
+                    entry = _jobs.erase(entry);
+                    --_finished;
+                } else {
+                    ++entry;
+                }
+            }
+        }
+
+        void BluetoothOperationExecutor::deviceStats(std::vector<DeviceStats>& stats) const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            stats.clear();
+            stats.reserve(_devices.size());
+            for (const auto& device : _devices) {
+                DeviceStats entry;
+                entry.deviceHandle = device.first;
+                entry.depth = device.second.depth;
+                entry.running = device.second.running;
+                entry.started = device.second.started;
+                entry.totalWaitMs = device.second.totalWaitMs;
+                entry.maxWaitMs = device.second.maxWaitMs;
+                stats.push_back(entry);
+            }
+        }
+
+        void BluetoothOperationExecutor::resetStats()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            for (auto& device : _devices) {
+                device.second.started = 0;
+                device.second.totalWaitMs = 0;
+                device.second.maxWaitMs = 0;
+            }
+        }
+
+        void BluetoothOperationExecutor::workerLoop()
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            while (_running) {
+                // The first pending job of a device that has none running; anything queued behind
+                // a running job of the same device waits for it.
+                std::deque<Entry>::iterator next = _jobs.begin();
+                DeviceQueue* device = nullptr;
+                for (; next != _jobs.end(); ++next) {
+                    if (STATE_PENDING == next->job.state) {
+                        device = &_devices[next->job.deviceHandle];
+                        if (!device->running) {
+                            break;
+                        }
+                    }
+                }
+                if (next == _jobs.end()) {
+                    _wakeup.wait(lock);
+                    continue;
+                }
+
+                const JobId id = next->job.id;
+                const BTRMgrDeviceHandle deviceHandle = next->job.deviceHandle;
+                Operation run = std::move(next->run);
+                next->run = nullptr;
+                next->job.state = STATE_RUNNING;
+                next->job.startedMs = nowMs();
+                --_pending;
+
+                const uint64_t waitMs = next->job.startedMs - next->job.submittedMs;
+                device->running = true;
+                ++device->started;
+                device->totalWaitMs += waitMs;
+                if (waitMs > device->maxWaitMs) {
+                    device->maxWaitMs = waitMs;
+                }
+
+                lock.unlock();
+                const bool succeeded = run();
+                lock.lock();
+
+                // The entry and the device queue stay while the job runs, but the deque and the map
+                // may have changed meanwhile; look both up again.
+                const Job job = finish(find(id), succeeded ? STATE_SUCCEEDED : STATE_FAILED, succeeded);
+
+                // The device stays busy until the completion was handled, so that completions of one
+                // device are reported in order.
+                if (job.async && _completion) {
+                    lock.unlock();
+                    _completion(job);
+                    lock.lock();
+                }
+
+                BluetoothHandleMap<DeviceQueue>::iterator idle = _devices.find(deviceHandle);
+                idle->second.running = false;
+                if ((0 == idle->second.depth) && (_devices.size() > BLUETOOTH_OPERATION_HISTORY)) {
+                    _devices.erase(deviceHandle);
+                }
+                // Jobs queued behind this one may be runnable now.
+                _wakeup.notify_all();
+            }
+        }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,168 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <core/core.h>
+
+#include "btmgr.h"
+#include "BluetoothHandleMap.h"
+
+#define BLUETOOTH_OPERATION_DEFAULT_WORKERS 2
+#define BLUETOOTH_OPERATION_MAX_PENDING 16
+#define BLUETOOTH_OPERATION_HISTORY 32
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // Per-device command queues for the requests that change a device. Jobs of one device handle run
+        // strictly in the order they were submitted, one at a time; jobs of different devices run
+        // concurrently on a small pool of worker threads, whose size bounds the number of BTRMGR calls
+        // in flight. submit() queues a job and returns its id, as for the requests made with
+        // "async": true; execute() queues one and blocks until it ran, so synchronous requests keep
+        // their place in the device queue too.
+        // Every submitted job ends with one call of the completion handler, on a worker thread; the last
+        // BLUETOOTH_OPERATION_HISTORY finished ones can still be queried. Executed jobs leave no history.
+        // A job can be cancelled until it started, BTRMGR calls cannot be interrupted.
+        class BluetoothOperationExecutor {
+
+            public:
+
+                typedef uint32_t JobId;
+                typedef std::function<bool()> Operation;
+
+                enum State {
+                    STATE_PENDING = 0,
+                    STATE_RUNNING,
+                    STATE_SUCCEEDED,
+                    STATE_FAILED,
+                    STATE_CANCELLED
+                };
+
+                typedef struct _Job {
+                    JobId               id          = 0;
+                    std::string         operation;              // method name, e.g. "pair"
+                    BTRMgrDeviceHandle  deviceHandle = 0;
+                    State               state       = STATE_PENDING;
+                    uint64_t            submittedMs = 0;
+                    uint64_t            startedMs   = 0;
+                    uint64_t            finishedMs  = 0;
+                    bool                async       = false;    // queued with submit()
+                } Job;
+
+                typedef struct _DeviceStats {
+                    BTRMgrDeviceHandle  deviceHandle = 0;
+                    uint32_t            depth       = 0;        // pending and running jobs
+                    bool                running     = false;
+                    uint64_t            started     = 0;
+                    uint64_t            totalWaitMs = 0;        // from submission until the job started
+                    uint64_t            maxWaitMs   = 0;
+                } DeviceStats;
+
+                typedef std::function<void(const Job&)> Completion;
+
+                BluetoothOperationExecutor() = default;
+                ~BluetoothOperationExecutor();
+
+                BluetoothOperationExecutor(const BluetoothOperationExecutor&) = delete;
+                BluetoothOperationExecutor& operator=(const BluetoothOperationExecutor&) = delete;
+
+                static const char* stateName(State state);
+
+                // workers is the number of devices served at a time, at least 1.
+                Core::hresult start(uint32_t workers, const Completion& completion);
+                // Waits for the running jobs; pending jobs are dropped without completion and
+                // execute() calls waiting for them return false.
+                void stop();
+
+                uint32_t workers() const { return static_cast<uint32_t>(_workers.size()); }
+
+                // Returns the id of the queued job, 0 if the executor is not running or the queue is full.
+                JobId submit(const std::string& operation, BTRMgrDeviceHandle deviceHandle, const Operation& run);
+                // Queues run behind the jobs of deviceHandle and returns its result once it ran, false if
+                // the queue is full or the job was cancelled. Runs it right away when the executor is not
+                // running. Must not be called from an operation.
+                bool execute(const std::string& operation, BTRMgrDeviceHandle deviceHandle, const Operation& run);
+                // False if the job is unknown or was dropped from the history.
+                bool status(JobId id, Job& job) const;
+                // ERROR_NONE if the job was pending and is cancelled now, ERROR_UNKNOWN_KEY if it is unknown
+                // and ERROR_ILLEGAL_STATE if it already started.
+                Core::hresult cancel(JobId id);
+
+                // Devices with queued jobs, and idle ones as long as no more than BLUETOOTH_OPERATION_HISTORY
+                // devices are known.
+                void deviceStats(std::vector<DeviceStats>& stats) const;
+                void resetStats();
+
+            private:
+
+                typedef struct _Waiter {
+                    bool        done        = false;
+                    bool        result      = false;
+                } Waiter;
+
+                typedef struct _Entry {
+                    Job                         job;
+                    Operation                   run;
+                    std::shared_ptr<Waiter>     waiter;     // set by execute()
+                } Entry;
+
+                typedef struct _DeviceQueue {
+                    uint32_t    depth       = 0;
+                    bool        running     = false;
+                    uint64_t    started     = 0;
+                    uint64_t    totalWaitMs = 0;
+                    uint64_t    maxWaitMs   = 0;
+                } DeviceQueue;
+
+                static uint64_t nowMs();
+                static bool finished(const Entry& entry) { return (entry.job.state >= STATE_SUCCEEDED); }
+                // The helpers below expect _lock to be held.
+                JobId enqueue(const std::string& operation, BTRMgrDeviceHandle deviceHandle, const Operation& run,
+                              const std::shared_ptr<Waiter>& waiter);
+                std::deque<Entry>::iterator find(JobId id);
+                // Ends the job and returns a copy of it; an executed job is woken and removed.
+                Job finish(std::deque<Entry>::iterator entry, State state, bool result);
+                void trimHistory();
+                void workerLoop();
+
+                std::vector<std::thread> _workers;
+                mutable std::mutex _lock;
+                std::condition_variable _wakeup;
+                std::condition_variable _done;      // wakes execute() callers
+                std::deque<Entry> _jobs;            // in submission order
+                BluetoothHandleMap<DeviceQueue> _devices;
+                Completion _completion;
+                JobId _lastId = 0;
+                uint32_t _pending = 0;
+                uint32_t _finished = 0;
+                bool _running = false;
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -149,7 +149,7 @@ Core::hresult BluetoothPersistenceAdapter::Parse(const std::string& payload, std
         }
 
         if (entry.HasLabel("deviceType")) {
-            info.deviceType = entry["deviceType"].String();
+            info.deviceType = bluetoothDeviceTypeFromString(entry["deviceType"].String());
         }
 
         if (entry.HasLabel("friendlyName") &&
@@ -268,7 +268,7 @@ Core::hresult BluetoothPersistenceAdapter::ReadRaw(std::string& content) const
     return Core::ERROR_NONE;
 }
 
-Core::hresult BluetoothPersistenceAdapter::Write(const std::unordered_map<std::string, BluetoothDeviceInfo>& deviceCache) const
+Core::hresult BluetoothPersistenceAdapter::Write(const BluetoothDeviceInfoMap& deviceCache) const
 {
     std::lock_guard<std::mutex> writeGuard(gFilesystemPersistenceWriteMutex);
 
@@ -312,7 +312,7 @@ Core::hresult BluetoothPersistenceAdapter::Write(const std::unordered_map<std::s
     for (const auto& entry : deviceCache) {
         const std::string& deviceAddr = entry.second.deviceAddr;
         if (deviceAddr.empty()) {
-            LOGWARN("Skipping device entry with no deviceAddr (deviceID=%s)", entry.first.c_str());
+            LOGWARN("Skipping device entry with no deviceAddr (deviceID=%llu)", static_cast<unsigned long long>(entry.first));
             continue;
         }
 
@@ -323,8 +323,7 @@ Core::hresult BluetoothPersistenceAdapter::Write(const std::unordered_map<std::s
         const std::string persistedName = !entry.second.friendlyName.empty() ? entry.second.friendlyName : deviceAddr;
         device["friendlyName"] = persistedName;
 
-        const std::string persistedType = !entry.second.deviceType.empty() ? entry.second.deviceType : "UNKNOWN";
-        device["deviceType"] = persistedType;
+        device["deviceType"] = std::string(bluetoothDeviceTypeName(entry.second.deviceType));
 
         device["lastVolumeSetting"] = entry.second.lastVolumeSetting;
 
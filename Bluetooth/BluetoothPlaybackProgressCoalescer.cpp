@@ -0,0 +1,92 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "BluetoothPlaybackProgressCoalescer.h"
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        bool BluetoothPlaybackProgressCoalescer::offer(const PlaybackProgress& progress, uint64_t nowMs, uint64_t& nextDueMs)
+        {
+            nextDueMs = 0;
+            if (0 == _intervalMs) {
+                return true;
+            }
+
+            DeviceState& state = _devices[progress.deviceHandle];
+            const uint64_t dueMs = state.lastNotifiedMs + _intervalMs;
+            if (!state.notified || (nowMs >= dueMs)) {
+                state.lastNotifiedMs = nowMs;
+                state.notified = true;
+                state.pending = false;
+                return true;
+            }
+
+            state.latest = progress;
+            state.pending = true;
+            nextDueMs = dueMs - nowMs;
+            return false;
+        }
+
+        bool BluetoothPlaybackProgressCoalescer::takePending(BTRMgrDeviceHandle deviceHandle, uint64_t nowMs, PlaybackProgress& progress)
+        {
+            auto it = _devices.find(deviceHandle);
+            if ((it == _devices.end()) || !it->second.pending) {
+                return false;
+            }
+
+            progress = it->second.latest;
+            it->second.pending = false;
+            it->second.lastNotifiedMs = nowMs;
+            return true;
+        }
+
+        uint64_t BluetoothPlaybackProgressCoalescer::takeDue(uint64_t nowMs, std::vector<PlaybackProgress>& due)
+        {
+            uint64_t nextDueMs = 0;
+            for (auto& entry : _devices) {
+                DeviceState& state = entry.second;
+                if (!state.pending) {
+                    continue;
+                }
+
+                const uint64_t dueMs = state.lastNotifiedMs + _intervalMs;
+                if (nowMs >= dueMs) {
+                    due.push_back(state.latest);
+                    state.pending = false;
+                    state.lastNotifiedMs = nowMs;
+                } else if ((0 == nextDueMs) || ((dueMs - nowMs) < nextDueMs)) {
+                    nextDueMs = dueMs - nowMs;
+                }
+            }
+            return nextDueMs;
+        }
+
+        void BluetoothPlaybackProgressCoalescer::remove(BTRMgrDeviceHandle deviceHandle)
+        {
+            _devices.erase(deviceHandle);
+        }
+
+        void BluetoothPlaybackProgressCoalescer::clear()
+        {
+            _devices.clear();
+        }
+
+    } // Plugin
+} // WPEFramework
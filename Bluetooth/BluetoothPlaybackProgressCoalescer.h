@@ -0,0 +1,77 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2026 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+#include <unordered_map>
+#include <vector>
+
+#include "btmgr.h"
+
+#define BLUETOOTH_PLAYBACK_PROGRESS_DEFAULT_INTERVAL_MS 1000
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        typedef struct _PlaybackProgress {
+            BTRMgrDeviceHandle  deviceHandle    = 0;
+            unsigned int        position        = 0;
+            unsigned int        duration        = 0;
+        } PlaybackProgress;
+
+        // Rate limits onPlaybackProgress per device: at most one notification per interval,
+        // keeping only the latest position reported in between.
+        class BluetoothPlaybackProgressCoalescer {
+
+            public:
+
+                BluetoothPlaybackProgressCoalescer() = default;
+                ~BluetoothPlaybackProgressCoalescer() = default;
+
+                // 0 disables coalescing, every progress update is notified.
+                void setInterval(uint32_t intervalMs) { _intervalMs = intervalMs; }
+                uint32_t interval() const { return _intervalMs; }
+
+                // Returns true when progress must be notified now. Otherwise it replaces the pending
+                // value of the device and nextDueMs is set to the delay until it is due.
+                bool offer(const PlaybackProgress& progress, uint64_t nowMs, uint64_t& nextDueMs);
+                // Removes the pending value of a device so it can be notified ahead of a state change.
+                bool takePending(BTRMgrDeviceHandle deviceHandle, uint64_t nowMs, PlaybackProgress& progress);
+                // Collects pending values whose interval elapsed. Returns the delay until the
+                // next pending value is due, 0 if nothing is pending anymore.
+                uint64_t takeDue(uint64_t nowMs, std::vector<PlaybackProgress>& due);
+                void remove(BTRMgrDeviceHandle deviceHandle);
+                void clear();
+
+            private:
+
+                typedef struct _DeviceState {
+                    uint64_t            lastNotifiedMs  = 0;
+                    bool                notified        = false;
+                    bool                pending         = false;
+                    PlaybackProgress    latest;
+                } DeviceState;
+
+                uint32_t _intervalMs = BLUETOOTH_PLAYBACK_PROGRESS_DEFAULT_INTERVAL_MS;
+                std::unordered_map<BTRMgrDeviceHandle, DeviceState> _devices;
+        };
+
+    } // Plugin
+} // WPEFramework
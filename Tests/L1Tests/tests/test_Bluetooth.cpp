@@ -24,6 +24,11 @@
 #include <cerrno>
 #include <cstdlib>
 #include <sys/stat.h>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 #include "Bluetooth.h"
 #include "StoreMock.h"
 #include "btmgrMock.h"
@@ -190,17 +195,16 @@ protected:
 
         BTRMGR_DevicesProperty_t deviceProperty = {};
 
-        #ifdef BTRMGR_DEVICE_TYPE_UNKNOWN
-        deviceProperty.m_deviceType = BTRMGR_DEVICE_TYPE_UNKNOWN;
-        #endif
+        deviceProperty.m_deviceType = BTRMGR_DEVICE_TYPE_HEADPHONES;
 
         EXPECT_CALL(*p_btmgrMock, BTRMGR_GetDeviceProperties(::testing::_, ::testing::_, ::testing::_))
             .WillOnce(::testing::DoAll(
                 ::testing::SetArgPointee<2>(deviceProperty),
                 ::testing::Return(BTRMGR_RESULT_SUCCESS)));
 
+        // Known BTRMGR types are mapped without a name lookup.
         EXPECT_CALL(*p_btmgrMock, BTRMGR_GetDeviceTypeAsString(::testing::_))
-            .WillOnce(::testing::Return("HEADPHONES"));
+            .Times(0);
 
         EXPECT_CALL(*p_storeMock, SetValue(::testing::_, ::testing::_, ::testing::_))
             .WillRepeatedly(::testing::Return(Core::ERROR_NONE));
@@ -251,10 +255,18 @@ TEST_F(BluetoothTest, startScanWrapper_NoAdapters_Failure)
 TEST_F(BluetoothTest, startScanWrapper_StartDiscoveryFailed_Failure)
 {
     EXPECT_CALL(*p_btmgrMock, BTRMGR_GetNumberOfAdapters(::testing::_))
-        .WillOnce(::testing::DoAll(::testing::SetArgPointee<0>(1), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+        .Times(2)
+        .WillRepeatedly(::testing::DoAll(::testing::SetArgPointee<0>(1), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
     EXPECT_CALL(*p_btmgrMock, BTRMGR_StartDeviceDiscovery(::testing::_, ::testing::_))
-        .WillOnce(::testing::Return(BTRMGR_RESULT_GENERIC_FAILURE));
+        .WillOnce(::testing::Return(BTRMGR_RESULT_GENERIC_FAILURE))
+        .WillOnce(::testing::Return(BTRMGR_RESULT_SUCCESS));
     
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"timeout\":5}"), response));
+    EXPECT_TRUE(response.find("\"status\":\"DISCOVERY_FAILED\"") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+    EXPECT_TRUE(response.find("\"sessionID\"") == string::npos);
+
+    // No session joined the failed discovery, the next startScan starts it again.
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"timeout\":5}"), response));
     EXPECT_TRUE(response.find("\"status\":\"AVAILABLE\"") != string::npos);
 }
@@ -281,6 +293,71 @@ TEST_F(BluetoothTest, stopScanWrapper_Success)
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopScan"), _T("{}"), response));
 }
 
+TEST_F(BluetoothTest, stopScanWrapper_SessionID_StopsWithLastSession)
+{
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetNumberOfAdapters(::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SetArgPointee<0>(1), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+    // The second scan asks for devices the first one already finds and joins it.
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_StartDeviceDiscovery(::testing::_, BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID))
+        .WillOnce(::testing::Return(BTRMGR_RESULT_SUCCESS));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"timeout\":30}"), response));
+    EXPECT_TRUE(response.find("\"sessionID\":1") != string::npos);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"timeout\":5,\"profile\":\"HEADPHONES\"}"), response));
+    EXPECT_TRUE(response.find("\"sessionID\":2") != string::npos);
+
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_StopDeviceDiscovery(::testing::_, ::testing::_)).Times(0);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopScan"), _T("{\"sessionID\":1}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopScan"), _T("{\"sessionID\":1}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+
+    // Newer expectations take precedence, only the release of the last session stops BTRMGR.
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_StopDeviceDiscovery(::testing::_, BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID))
+        .WillOnce(::testing::Return(BTRMGR_RESULT_SUCCESS));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopScan"), _T("{\"sessionID\":2}"), response));
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+}
+
+TEST_F(BluetoothTest, setBackgroundDiscoveryWrapper_MissingEnable_Failure)
+{
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setBackgroundDiscovery"), _T("{\"profile\":\"HEADPHONES\"}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getBackgroundDiscovery"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"enabled\":false") != string::npos);
+    EXPECT_TRUE(response.find("\"cycles\":0") != string::npos);
+    EXPECT_TRUE(response.find("\"scanningMs\":0") != string::npos);
+}
+
+TEST_F(BluetoothTest, startScanWrapper_MatchWithoutCriteria_Failure)
+{
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_StartDeviceDiscovery(::testing::_, ::testing::_))
+        .Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"timeout\":10,\"match\":{}}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"match\":{\"name\":\"speaker\"}}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+}
+
+TEST_F(BluetoothTest, cancelOperationWrapper_UnknownJob_Failure)
+{
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("cancelOperation"), _T("{\"jobID\":42}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getOperationStatus"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+}
+
+TEST_F(BluetoothTest, startScanWrapper_UnknownProfile_Failure)
+{
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_StartDeviceDiscovery(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startScan"), _T("{\"timeout\":5, \"profile\":\"HEADPHONE\"}"), response));
+    EXPECT_TRUE(response.find("\"unknownProfiles\":[\"HEADPHONE\"]") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":false") != string::npos);
+}
+
 TEST_F(BluetoothTest, isDiscoverableWrapper_True)
 {
     EXPECT_CALL(*p_btmgrMock, BTRMGR_GetNumberOfAdapters(::testing::_))
@@ -388,6 +465,30 @@ TEST_F(BluetoothTest, getPairedDevicesWrapper_Success)
     EXPECT_TRUE(response.find("\"pairedDevices\"") != string::npos);
 }
 
+TEST_F(BluetoothTest, getPairedDevicesWrapper_SinceCurrentGeneration_ReturnsEmptyDelta)
+{
+    BTRMGR_PairedDevicesList_t pairedDevices;
+    memset(&pairedDevices, 0, sizeof(pairedDevices));
+    pairedDevices.m_numOfDevices = 1;
+    pairedDevices.m_deviceProperty[0].m_deviceHandle = 123;
+    strcpy(pairedDevices.m_deviceProperty[0].m_name, "PairedDevice");
+
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetPairedDevices(::testing::_, ::testing::_))
+        .Times(2)
+        .WillRepeatedly(::testing::DoAll(::testing::SetArgPointee<1>(pairedDevices), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getPairedDevices"), _T("{}"), response));
+    JsonObject listed;
+    listed.FromString(response);
+    ASSERT_TRUE(listed.HasLabel("generation"));
+    const string since = "{\"since\":" + std::to_string(listed["generation"].Number()) + "}";
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getPairedDevices"), since, response));
+    EXPECT_TRUE(response.find("\"delta\":true") != string::npos);
+    EXPECT_TRUE(response.find("\"pairedDevices\"") == string::npos);
+    EXPECT_TRUE(response.find("PairedDevice") == string::npos);
+}
+
 TEST_F(BluetoothTest, getPairedDevicesWrapper_Failed)
 {
     EXPECT_CALL(*p_btmgrMock, BTRMGR_GetPairedDevices(::testing::_, ::testing::_))
@@ -423,6 +524,40 @@ TEST_F(BluetoothTest, getConnectedDevicesWrapper_Failed)
     EXPECT_TRUE(response.find("\"connectedDevices\"") != string::npos);
 }
 
+TEST_F(BluetoothTest, getDeviceSnapshotWrapper_MergesListsPerDevice)
+{
+    BTRMGR_DiscoveredDevicesList_t discoveredDevices;
+    memset(&discoveredDevices, 0, sizeof(discoveredDevices));
+    discoveredDevices.m_numOfDevices = 1;
+    discoveredDevices.m_deviceProperty[0].m_deviceHandle = 456;
+    strcpy(discoveredDevices.m_deviceProperty[0].m_name, "NearbyDevice");
+
+    BTRMGR_PairedDevicesList_t pairedDevices;
+    memset(&pairedDevices, 0, sizeof(pairedDevices));
+    pairedDevices.m_numOfDevices = 1;
+    pairedDevices.m_deviceProperty[0].m_deviceHandle = 123;
+    strcpy(pairedDevices.m_deviceProperty[0].m_name, "Headphones");
+
+    BTRMGR_ConnectedDevicesList_t connectedDevices;
+    memset(&connectedDevices, 0, sizeof(connectedDevices));
+    connectedDevices.m_numOfDevices = 1;
+    connectedDevices.m_deviceProperty[0].m_deviceHandle = 123;
+    strcpy(connectedDevices.m_deviceProperty[0].m_name, "Headphones");
+
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetDiscoveredDevices(::testing::_, ::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SetArgPointee<1>(discoveredDevices), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetPairedDevices(::testing::_, ::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SetArgPointee<1>(pairedDevices), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetConnectedDevices(::testing::_, ::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SetArgPointee<1>(connectedDevices), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getDeviceSnapshot"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"deviceID\":\"123\"") != string::npos);
+    EXPECT_TRUE(response.find("\"deviceID\":\"456\"") != string::npos);
+    EXPECT_TRUE(response.find("\"discovered\":false,\"paired\":true,\"connected\":true") != string::npos);
+    EXPECT_TRUE(response.find("\"discovered\":true,\"paired\":false,\"connected\":false") != string::npos);
+}
+
 TEST_F(BluetoothTest, connectWrapper_Smartphone_Success)
 {
     EXPECT_CALL(*p_btmgrMock, BTRMGR_StartAudioStreamingIn(::testing::_, ::testing::_, BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT))
@@ -822,6 +957,26 @@ TEST_F(BluetoothTest, getDeviceInfoWrapper_Success)
     EXPECT_TRUE(response.find("\"deviceInfo\"") != string::npos);
 }
 
+TEST_F(BluetoothTest, getDeviceInfoWrapper_DeviceIDs_ReportsErrorsInline)
+{
+    BTRMGR_DevicesProperty_t deviceProperty;
+    memset(&deviceProperty, 0, sizeof(deviceProperty));
+    deviceProperty.m_deviceHandle = 123;
+    strcpy(deviceProperty.m_name, "TestDevice");
+
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetDeviceProperties(::testing::_, 123, ::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SetArgPointee<2>(deviceProperty), ::testing::Return(BTRMGR_RESULT_SUCCESS)));
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetDeviceProperties(::testing::_, 456, ::testing::_))
+        .WillOnce(::testing::Return(BTRMGR_RESULT_GENERIC_FAILURE));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getDeviceInfo"), _T("{\"deviceIDs\":[\"123\",\"456\",\"abc\"]}"), response));
+    EXPECT_TRUE(response.find("\"deviceInfos\"") != string::npos);
+    EXPECT_TRUE(response.find("TestDevice") != string::npos);
+    EXPECT_TRUE(response.find("\"456\":{\"error\"") != string::npos);
+    EXPECT_TRUE(response.find("\"abc\":{\"error\":\"Invalid deviceID\"}") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+}
+
 TEST_F(BluetoothTest, getDeviceInfoWrapper_MissingDeviceID_Failure)
 {
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getDeviceInfo"), _T("{}"), response));
@@ -968,6 +1123,17 @@ TEST_F(BluetoothTest, getAutoConnectWrapper_Disabled_Success)
     EXPECT_TRUE(response.find("\"autoconnect\":false") != string::npos);
 }
 
+TEST_F(BluetoothTest, getAutoConnectWrapper_Toggled_ReturnsLatestSetting)
+{
+    setupDevice();
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setAutoConnect"), _T("{\"deviceID\":\"123\",\"enable\":true}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setAutoConnect"), _T("{\"deviceID\":\"123\",\"enable\":false}"), response));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getAutoConnect"), _T("{\"deviceID\":\"123\"}"), response));
+    EXPECT_TRUE(response.find("\"autoconnect\":false") != string::npos);
+}
+
 TEST_F(BluetoothTest, getAutoConnectWrapper_MissingDeviceID_Failure)
 {
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getAutoConnect"), _T("{}"), response));
@@ -2113,3 +2279,1263 @@ TEST_F(BluetoothTest, featureGateCompileCoverage_BaselinePersistenceFunctionalWh
     EXPECT_TRUE(response.find("\"autoconnect\":true") != string::npos);
 }
 #endif
+
+TEST_F(BluetoothTest, notifyEventWrapper_NoSubscribers_SkipsPayloadOfEventsNotReplayed)
+{
+    EXPECT_CALL(*p_btmgrMock, BTRMGR_GetDeviceTypeAsString(::testing::_)).Times(0);
+
+    const BTRMGR_Events_t eventTypes[] = {
+        BTRMGR_EVENT_DEVICE_FOUND,
+        BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE,
+        BTRMGR_EVENT_MEDIA_TRACK_PLAYING,
+        BTRMGR_EVENT_MEDIA_TRACK_POSITION,
+        BTRMGR_EVENT_MAX
+    };
+    for (const BTRMGR_Events_t eventType : eventTypes) {
+        BTRMGR_EventMessage_t eventMsg;
+        memset(&eventMsg, 0, sizeof(eventMsg));
+        eventMsg.m_eventType = eventType;
+        plugin->notifyEventWrapper(eventMsg);
+    }
+}
+
+class BluetoothEventReplayTest : public BluetoothTest {
+protected:
+    BluetoothEventReplayTest() : BluetoothTest(false)
+    {
+        // The journal is opt-in.
+        ON_CALL(service, ConfigLine())
+            .WillByDefault(::testing::Return(string("{\"eventreplaysize\":8}")));
+
+        EXPECT_EQ(string(""), plugin->Initialize(&service));
+    }
+};
+
+TEST_F(BluetoothTest, getEventsSince_JournalDisabledByDefault_ReportsTruncated)
+{
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED;
+    plugin->notifyEventWrapper(eventMsg);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getEventsSince"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"events\":[]") != string::npos);
+    EXPECT_TRUE(response.find("\"truncated\":true") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+}
+
+TEST_F(BluetoothEventReplayTest, getEventsSince_ReplaysStatusEventsNotifiedBeforeSubscribing)
+{
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED;
+    plugin->notifyEventWrapper(eventMsg);
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE;
+    plugin->notifyEventWrapper(eventMsg);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getEventsSince"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"newStatus\":\"DISCOVERY_STARTED\"") != string::npos);
+    EXPECT_TRUE(response.find("\"newStatus\":\"DISCOVERY_COMPLETED\"") != string::npos);
+    EXPECT_TRUE(response.find("\"event\":\"onStatusChanged\"") != string::npos);
+    EXPECT_TRUE(response.find("\"truncated\":false") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getEventsSince"), _T("{\"sequence\":1}"), response));
+    EXPECT_TRUE(response.find("\"newStatus\":\"DISCOVERY_STARTED\"") == string::npos);
+    EXPECT_TRUE(response.find("\"newStatus\":\"DISCOVERY_COMPLETED\"") != string::npos);
+    EXPECT_TRUE(response.find("\"sequence\":2") != string::npos);
+}
+
+TEST_F(BluetoothTest, getEventStats_ReportsDispatchedEventTypesAndResets)
+{
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED;
+    plugin->notifyEventWrapper(eventMsg);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getEventStats"), _T("{\"reset\":true}"), response));
+    EXPECT_TRUE(response.find("\"name\":\"DISCOVERY_STARTED\"") != string::npos);
+    EXPECT_TRUE(response.find("\"queue\":{") != string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != string::npos);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getEventStats"), _T("{}"), response));
+    EXPECT_TRUE(response.find("\"name\":\"DISCOVERY_STARTED\"") == string::npos);
+}
+
+TEST(BluetoothEventQueueTest, push_NotStarted_ReturnsUnavailable)
+{
+    Plugin::BluetoothEventQueue queue;
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+
+    EXPECT_EQ(Core::ERROR_UNAVAILABLE, queue.push(eventMsg));
+    EXPECT_EQ(0u, queue.enqueued());
+}
+
+TEST(BluetoothEventQueueTest, push_DeliversEventsInOrderOnDispatcherThread)
+{
+    Plugin::BluetoothEventQueue queue;
+    std::mutex lock;
+    std::condition_variable delivered;
+    std::vector<int> eventTypes;
+    std::vector<uint64_t> ingressTimes;
+    std::thread::id dispatcherId;
+
+    ASSERT_EQ(Core::ERROR_NONE, queue.start(3, [&](BTRMGR_EventMessage_t& eventMsg, uint64_t ingressUs) {
+        std::lock_guard<std::mutex> guard(lock);
+        eventTypes.push_back(static_cast<int>(eventMsg.m_eventType));
+        ingressTimes.push_back(ingressUs);
+        dispatcherId = std::this_thread::get_id();
+        delivered.notify_one();
+    }));
+    EXPECT_EQ(4u, queue.depth());
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED;
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg, 100));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_FOUND;
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg, 200));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE;
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg, 300));
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        EXPECT_TRUE(delivered.wait_for(guard, std::chrono::seconds(2), [&]() { return eventTypes.size() == 3; }));
+    }
+    queue.stop();
+
+    ASSERT_EQ(3u, eventTypes.size());
+    EXPECT_EQ(static_cast<int>(BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED), eventTypes[0]);
+    EXPECT_EQ(static_cast<int>(BTRMGR_EVENT_DEVICE_FOUND), eventTypes[1]);
+    EXPECT_EQ(static_cast<int>(BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE), eventTypes[2]);
+    EXPECT_EQ((std::vector<uint64_t>{ 100, 200, 300 }), ingressTimes);
+    EXPECT_NE(std::this_thread::get_id(), dispatcherId);
+    EXPECT_EQ(3u, queue.enqueued());
+    EXPECT_EQ(0u, queue.dropped());
+}
+
+TEST(BluetoothEventQueueTest, push_WhenFull_DropsAndCountsOverflow)
+{
+    Plugin::BluetoothEventQueue queue;
+    std::promise<void> handlerEntered;
+    std::promise<void> releaseHandler;
+    std::shared_future<void> released(releaseHandler.get_future());
+    std::atomic<int> handled{0};
+
+    ASSERT_EQ(Core::ERROR_NONE, queue.start(4, [&](BTRMGR_EventMessage_t&, uint64_t) {
+        if (0 == handled.fetch_add(1)) {
+            handlerEntered.set_value();
+            released.wait();
+        }
+    }));
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_MEDIA_TRACK_POSITION;
+
+    // The first event occupies the dispatcher, the next four fill every slot.
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg));
+    ASSERT_EQ(std::future_status::ready, handlerEntered.get_future().wait_for(std::chrono::seconds(2)));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg));
+    }
+    EXPECT_EQ(Core::ERROR_GENERAL, queue.push(eventMsg));
+    EXPECT_EQ(Core::ERROR_GENERAL, queue.push(eventMsg));
+
+    EXPECT_EQ(5u, queue.enqueued());
+    EXPECT_EQ(2u, queue.dropped());
+    EXPECT_EQ(1u, queue.overflows());
+    EXPECT_EQ(4u, queue.highWatermark());
+
+    releaseHandler.set_value();
+    queue.stop();
+}
+
+TEST(BluetoothEventQueueTest, push_InteractiveLaneDrainsBeforeStreamingLane)
+{
+    Plugin::BluetoothEventQueue queue;
+    std::promise<void> handlerEntered;
+    std::promise<void> releaseHandler;
+    std::shared_future<void> released(releaseHandler.get_future());
+    std::mutex lock;
+    std::condition_variable delivered;
+    std::vector<int> eventTypes;
+
+    ASSERT_EQ(Core::ERROR_NONE, queue.start(4, [&](BTRMGR_EventMessage_t& eventMsg, uint64_t) {
+        std::unique_lock<std::mutex> guard(lock);
+        eventTypes.push_back(eventMsg.m_eventType);
+        if (1 == eventTypes.size()) {
+            guard.unlock();
+            handlerEntered.set_value();
+            released.wait();
+            guard.lock();
+        }
+        delivered.notify_one();
+    }));
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_MEDIA_TRACK_POSITION;
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg, 0, Plugin::BluetoothEventQueue::LANE_STREAMING));
+    ASSERT_EQ(std::future_status::ready, handlerEntered.get_future().wait_for(std::chrono::seconds(2)));
+
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE;
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg, 0, Plugin::BluetoothEventQueue::LANE_STREAMING));
+    eventMsg.m_eventType = BTRMGR_EVENT_RECEIVED_EXTERNAL_PAIR_REQUEST;
+    EXPECT_EQ(Core::ERROR_NONE, queue.push(eventMsg, 0, Plugin::BluetoothEventQueue::LANE_INTERACTIVE));
+    EXPECT_EQ(1u, queue.size(Plugin::BluetoothEventQueue::LANE_INTERACTIVE));
+    EXPECT_EQ(1u, queue.size(Plugin::BluetoothEventQueue::LANE_STREAMING));
+    releaseHandler.set_value();
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ASSERT_TRUE(delivered.wait_for(guard, std::chrono::seconds(2), [&]() { return eventTypes.size() == 3; }));
+    }
+    queue.stop();
+
+    EXPECT_EQ(BTRMGR_EVENT_MEDIA_TRACK_POSITION, eventTypes[0]);
+    EXPECT_EQ(BTRMGR_EVENT_RECEIVED_EXTERNAL_PAIR_REQUEST, eventTypes[1]);
+    EXPECT_EQ(BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE, eventTypes[2]);
+    EXPECT_EQ(1u, queue.enqueued(Plugin::BluetoothEventQueue::LANE_INTERACTIVE));
+    EXPECT_EQ(2u, queue.enqueued(Plugin::BluetoothEventQueue::LANE_STREAMING));
+    EXPECT_EQ(3u, queue.enqueued());
+}
+
+TEST(BluetoothEventQueueTest, stop_WaitsForProducersAcrossRestarts)
+{
+    Plugin::BluetoothEventQueue queue;
+    std::atomic<bool> producing{true};
+    std::atomic<uint64_t> accepted{0};
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_MEDIA_TRACK_POSITION;
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i) {
+        producers.emplace_back([&]() {
+            while (producing.load()) {
+                if (Core::ERROR_NONE == queue.push(eventMsg)) {
+                    accepted.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    // Alternate depths so every start() reallocates the lanes under the running producers.
+    for (uint32_t cycle = 0; cycle < 200; ++cycle) {
+        const uint64_t before = accepted.load();
+        ASSERT_EQ(Core::ERROR_NONE, queue.start((cycle % 2) ? 4 : 16, [](BTRMGR_EventMessage_t&, uint64_t) {}));
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while ((accepted.load() == before) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::yield();
+        }
+        queue.stop();
+        EXPECT_EQ(Core::ERROR_UNAVAILABLE, queue.push(eventMsg));
+    }
+
+    producing.store(false);
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    EXPECT_LE(200u, accepted.load());
+}
+
+TEST(BluetoothPlaybackProgressCoalescerTest, offer_WithinInterval_KeepsOnlyLatestPosition)
+{
+    Plugin::BluetoothPlaybackProgressCoalescer coalescer;
+    coalescer.setInterval(1000);
+
+    Plugin::PlaybackProgress progress;
+    progress.deviceHandle = 123;
+    progress.duration = 200000;
+    uint64_t nextDueMs = 0;
+
+    progress.position = 1000;
+    EXPECT_TRUE(coalescer.offer(progress, 10000, nextDueMs));
+    progress.position = 1200;
+    EXPECT_FALSE(coalescer.offer(progress, 10200, nextDueMs));
+    EXPECT_EQ(800u, nextDueMs);
+    progress.position = 1400;
+    EXPECT_FALSE(coalescer.offer(progress, 10400, nextDueMs));
+    EXPECT_EQ(600u, nextDueMs);
+
+    std::vector<Plugin::PlaybackProgress> due;
+    EXPECT_EQ(500u, coalescer.takeDue(10500, due));
+    EXPECT_TRUE(due.empty());
+
+    EXPECT_EQ(0u, coalescer.takeDue(11000, due));
+    ASSERT_EQ(1u, due.size());
+    EXPECT_EQ(123u, due[0].deviceHandle);
+    EXPECT_EQ(1400u, due[0].position);
+
+    progress.position = 2500;
+    EXPECT_TRUE(coalescer.offer(progress, 12100, nextDueMs));
+}
+
+TEST(BluetoothPlaybackProgressCoalescerTest, takePending_FlushesHeldPositionOfThatDeviceOnly)
+{
+    Plugin::BluetoothPlaybackProgressCoalescer coalescer;
+    coalescer.setInterval(1000);
+
+    Plugin::PlaybackProgress first;
+    first.deviceHandle = 1;
+    Plugin::PlaybackProgress second;
+    second.deviceHandle = 2;
+    uint64_t nextDueMs = 0;
+
+    EXPECT_TRUE(coalescer.offer(first, 0, nextDueMs));
+    EXPECT_TRUE(coalescer.offer(second, 0, nextDueMs));
+    first.position = 300;
+    second.position = 400;
+    EXPECT_FALSE(coalescer.offer(first, 300, nextDueMs));
+    EXPECT_FALSE(coalescer.offer(second, 400, nextDueMs));
+
+    Plugin::PlaybackProgress flushed;
+    EXPECT_TRUE(coalescer.takePending(1, 500, flushed));
+    EXPECT_EQ(300u, flushed.position);
+    EXPECT_FALSE(coalescer.takePending(1, 600, flushed));
+
+    std::vector<Plugin::PlaybackProgress> due;
+    coalescer.takeDue(1000, due);
+    ASSERT_EQ(1u, due.size());
+    EXPECT_EQ(2u, due[0].deviceHandle);
+}
+
+TEST(BluetoothPlaybackProgressCoalescerTest, offer_IntervalZero_NotifiesEveryUpdate)
+{
+    Plugin::BluetoothPlaybackProgressCoalescer coalescer;
+    coalescer.setInterval(0);
+
+    Plugin::PlaybackProgress progress;
+    progress.deviceHandle = 123;
+    uint64_t nextDueMs = 0;
+
+    EXPECT_TRUE(coalescer.offer(progress, 100, nextDueMs));
+    EXPECT_TRUE(coalescer.offer(progress, 101, nextDueMs));
+    EXPECT_TRUE(coalescer.offer(progress, 102, nextDueMs));
+    EXPECT_EQ(0u, nextDueMs);
+}
+
+TEST(BluetoothDiscoveryBatcherTest, add_SameHandleWithinWindow_IsDeduplicated)
+{
+    Plugin::BluetoothDiscoveryBatcher batcher;
+    batcher.setLimits(500, 32);
+
+    Plugin::DiscoveredDeviceUpdate update;
+    update.deviceHandle = 61579454946360ULL;
+    update.name = "Speaker";
+    bool windowOpened = false;
+
+    EXPECT_FALSE(batcher.add(update, 1000, windowOpened));
+    EXPECT_TRUE(windowOpened);
+    update.name = "Speaker (renamed)";
+    update.updateType = Plugin::DISCOVERY_UPDATE_LOST;
+    EXPECT_FALSE(batcher.add(update, 1100, windowOpened));
+    EXPECT_FALSE(windowOpened);
+    update.deviceHandle = 26499258260618ULL;
+    EXPECT_FALSE(batcher.add(update, 1200, windowOpened));
+
+    EXPECT_EQ(300u, batcher.remaining(1200));
+    EXPECT_EQ(0u, batcher.remaining(1500));
+    EXPECT_EQ(1u, batcher.deduplicated());
+
+    std::vector<Plugin::DiscoveredDeviceUpdate> batch;
+    batcher.take(batch);
+    ASSERT_EQ(2u, batch.size());
+    EXPECT_EQ(61579454946360ULL, batch[0].deviceHandle);
+    EXPECT_EQ(string("Speaker (renamed)"), batch[0].name);
+    EXPECT_EQ(Plugin::DISCOVERY_UPDATE_LOST, batch[0].updateType);
+    EXPECT_EQ(26499258260618ULL, batch[1].deviceHandle);
+    EXPECT_TRUE(batcher.empty());
+}
+
+TEST(BluetoothDiscoveryBatcherTest, add_SizeLimitReached_RequestsFlush)
+{
+    Plugin::BluetoothDiscoveryBatcher batcher;
+    batcher.setLimits(500, 2);
+
+    Plugin::DiscoveredDeviceUpdate update;
+    bool windowOpened = false;
+
+    update.deviceHandle = 1;
+    EXPECT_FALSE(batcher.add(update, 0, windowOpened));
+    update.deviceHandle = 1;
+    EXPECT_FALSE(batcher.add(update, 10, windowOpened));
+    update.deviceHandle = 2;
+    EXPECT_TRUE(batcher.add(update, 20, windowOpened));
+
+    std::vector<Plugin::DiscoveredDeviceUpdate> batch;
+    batcher.take(batch);
+    EXPECT_EQ(2u, batch.size());
+
+    update.deviceHandle = 3;
+    EXPECT_FALSE(batcher.add(update, 30, windowOpened));
+    EXPECT_TRUE(windowOpened);
+}
+
+TEST(BluetoothDiscoveryBatcherTest, setLimits_ZeroWindow_DisablesBatching)
+{
+    Plugin::BluetoothDiscoveryBatcher batcher;
+    EXPECT_TRUE(batcher.enabled());
+    batcher.setLimits(0, 32);
+    EXPECT_FALSE(batcher.enabled());
+}
+
+TEST(BluetoothEventSubscribersTest, counter_RegisterUnregister_TracksCountAndNeverUnderflows)
+{
+    typedef Plugin::BluetoothEventSubscribers::Status Status;
+    Plugin::BluetoothEventSubscribers::Counter counter;
+
+    counter.onEventStatus("client.events.1", Status::registered);
+    counter.onEventStatus("client.events.2", Status::registered);
+    EXPECT_EQ(2u, counter.count());
+
+    counter.onEventStatus("client.events.1", Status::unregistered);
+    counter.onEventStatus("client.events.2", Status::unregistered);
+    counter.onEventStatus("client.events.2", Status::unregistered);
+    EXPECT_EQ(0u, counter.count());
+}
+
+TEST(BluetoothEventSubscribersTest, hasSubscribers_TrackedEventsStartEmptyUntrackedAreAssumedSubscribed)
+{
+    PluginHost::JSONRPCSupportsEventStatus dispatcher;
+    Plugin::BluetoothEventSubscribers subscribers;
+
+    subscribers.attach(dispatcher, { "onPlaybackProgress", "onPlaybackChange", "onPlaybackChange" });
+    EXPECT_FALSE(subscribers.hasSubscribers("onPlaybackProgress"));
+    EXPECT_FALSE(subscribers.hasSubscribers("onPlaybackChange"));
+    EXPECT_TRUE(subscribers.hasSubscribers("onStatusChanged"));
+    EXPECT_EQ(0u, subscribers.count("onStatusChanged"));
+
+    subscribers.detach(dispatcher);
+}
+
+TEST(BluetoothLatencyHistogramTest, percentile_StaysWithinBucketResolutionAndMax)
+{
+    Plugin::BluetoothLatencyHistogram histogram;
+    EXPECT_EQ(0u, histogram.percentile(50));
+
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value * 100);
+    }
+    EXPECT_EQ(100u, histogram.count());
+    EXPECT_EQ(10000u, histogram.max());
+
+    const uint64_t p50 = histogram.percentile(50);
+    EXPECT_GE(p50, 5000u);
+    EXPECT_LE(p50, 6250u);
+    const uint64_t p99 = histogram.percentile(99);
+    EXPECT_GE(p99, 9900u);
+    EXPECT_LE(p99, 10000u);
+    EXPECT_EQ(10000u, histogram.percentile(100));
+
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.max());
+}
+
+TEST(BluetoothEventStatsTest, record_KeepsStagesPerEventType)
+{
+    Plugin::BluetoothEventStats stats;
+    EXPECT_EQ(nullptr, stats.histogram(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, Plugin::BluetoothEventStats::STAGE_TOTAL));
+
+    stats.record(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, Plugin::BluetoothEventStats::STAGE_ENCODE, 40);
+    stats.record(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, Plugin::BluetoothEventStats::STAGE_TOTAL, 900);
+    stats.record(BTRMGR_EVENT_MAX, Plugin::BluetoothEventStats::STAGE_TOTAL, 1);
+
+    const Plugin::BluetoothLatencyHistogram* encode = stats.histogram(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, Plugin::BluetoothEventStats::STAGE_ENCODE);
+    ASSERT_NE(nullptr, encode);
+    EXPECT_EQ(1u, encode->count());
+    EXPECT_EQ(40u, encode->max());
+    EXPECT_EQ(0u, stats.histogram(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, Plugin::BluetoothEventStats::STAGE_NOTIFY)->count());
+    EXPECT_EQ(nullptr, stats.histogram(BTRMGR_EVENT_DEVICE_PAIRING_COMPLETE, Plugin::BluetoothEventStats::STAGE_TOTAL));
+
+    stats.reset();
+    EXPECT_EQ(nullptr, stats.histogram(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, Plugin::BluetoothEventStats::STAGE_ENCODE));
+}
+
+TEST(BluetoothEventJournalTest, since_ReturnsNewerEntriesAndReportsEviction)
+{
+    Plugin::BluetoothEventJournal journal;
+    journal.setCapacity(2);
+    JsonObject params;
+
+    for (int i = 0; i < 3; ++i) {
+        journal.append(journal.next(), "onStatusChanged", params);
+    }
+    // Not journaled, only consumes a sequence number.
+    journal.next();
+
+    EXPECT_EQ(4u, journal.sequence());
+    EXPECT_EQ(2u, journal.oldest());
+
+    std::vector<Plugin::BluetoothEventJournal::Entry> entries;
+    EXPECT_TRUE(journal.since(1, entries));
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_EQ(2u, entries[0].sequence);
+    EXPECT_EQ(3u, entries[1].sequence);
+    EXPECT_EQ("onStatusChanged", entries[1].event);
+
+    entries.clear();
+    EXPECT_FALSE(journal.since(0, entries));
+    EXPECT_EQ(2u, entries.size());
+
+    // A sequence number this journal never assigned replays everything held.
+    entries.clear();
+    EXPECT_FALSE(journal.since(100, entries));
+    EXPECT_EQ(2u, entries.size());
+
+    entries.clear();
+    journal.clear();
+    EXPECT_EQ(0u, journal.oldest());
+    EXPECT_FALSE(journal.since(2, entries));
+    EXPECT_TRUE(journal.since(3, entries));
+    EXPECT_TRUE(entries.empty());
+    EXPECT_EQ(5u, journal.next());
+}
+
+TEST(BluetoothEventJournalTest, setCapacity_ZeroDisablesJournaling)
+{
+    Plugin::BluetoothEventJournal journal;
+    journal.setCapacity(0);
+    JsonObject params;
+
+    EXPECT_FALSE(journal.enabled());
+    journal.append(journal.next(), "onStatusChanged", params);
+
+    std::vector<Plugin::BluetoothEventJournal::Entry> entries;
+    // Nothing is held, so only a client that saw every sequence is complete.
+    EXPECT_FALSE(journal.since(0, entries));
+    EXPECT_TRUE(entries.empty());
+    EXPECT_TRUE(journal.since(1, entries));
+    EXPECT_TRUE(entries.empty());
+    EXPECT_EQ(1u, journal.sequence());
+}
+
+TEST(BluetoothConnectionDebouncerTest, offer_SuppressesTransitionsRevertedWithinSettleTime)
+{
+    Plugin::BluetoothConnectionDebouncer debouncer;
+    debouncer.setSettleTime(500);
+    uint64_t nextDueMs = 0;
+    auto connectionEvent = [](BTRMGR_Events_t eventType, BTRMgrDeviceHandle deviceHandle) {
+        BTRMGR_EventMessage_t eventMsg;
+        memset(&eventMsg, 0, sizeof(eventMsg));
+        eventMsg.m_eventType = eventType;
+        eventMsg.m_pairedDevice.m_deviceHandle = deviceHandle;
+        return eventMsg;
+    };
+
+    const BTRMGR_EventMessage_t connected = connectionEvent(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, 7);
+    const BTRMGR_EventMessage_t disconnected = connectionEvent(BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE, 7);
+
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_NOTIFY, debouncer.offer(connected, 1000, nextDueMs));
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_HOLD, debouncer.offer(disconnected, 1100, nextDueMs));
+    EXPECT_EQ(500u, nextDueMs);
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_SUPPRESS, debouncer.offer(connected, 1200, nextDueMs));
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_HOLD, debouncer.offer(disconnected, 1300, nextDueMs));
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_SUPPRESS, debouncer.offer(connected, 1400, nextDueMs));
+
+    std::vector<BTRMGR_EventMessage_t> due;
+    EXPECT_EQ(0u, debouncer.takeDue(5000, due));
+    EXPECT_TRUE(due.empty());
+
+    // Stable again: the next transition is not delayed.
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_NOTIFY, debouncer.offer(disconnected, 5000, nextDueMs));
+
+    std::map<BTRMgrDeviceHandle, uint32_t> flaps;
+    debouncer.flaps(flaps);
+    ASSERT_EQ(1u, flaps.size());
+    EXPECT_EQ(2u, flaps[7]);
+}
+
+TEST(BluetoothConnectionDebouncerTest, takeDue_NotifiesTransitionThatSettled)
+{
+    Plugin::BluetoothConnectionDebouncer debouncer;
+    debouncer.setSettleTime(500);
+    uint64_t nextDueMs = 0;
+    auto connectionEvent = [](BTRMGR_Events_t eventType, BTRMgrDeviceHandle deviceHandle) {
+        BTRMGR_EventMessage_t eventMsg;
+        memset(&eventMsg, 0, sizeof(eventMsg));
+        eventMsg.m_eventType = eventType;
+        eventMsg.m_pairedDevice.m_deviceHandle = deviceHandle;
+        return eventMsg;
+    };
+    std::vector<BTRMGR_EventMessage_t> due;
+
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_NOTIFY,
+        debouncer.offer(connectionEvent(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, 7), 1000, nextDueMs));
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_HOLD,
+        debouncer.offer(connectionEvent(BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE, 7), 1200, nextDueMs));
+    // Other devices are not affected.
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_NOTIFY,
+        debouncer.offer(connectionEvent(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, 8), 1300, nextDueMs));
+
+    EXPECT_EQ(100u, debouncer.takeDue(1600, due));
+    EXPECT_TRUE(due.empty());
+    EXPECT_EQ(0u, debouncer.takeDue(1700, due));
+    ASSERT_EQ(1u, due.size());
+    EXPECT_EQ(BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE, due[0].m_eventType);
+
+    // A repeated event of the settled state is not a transition.
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_NOTIFY,
+        debouncer.offer(connectionEvent(BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE, 7), 1800, nextDueMs));
+
+    debouncer.setSettleTime(0);
+    EXPECT_FALSE(debouncer.enabled());
+    EXPECT_EQ(Plugin::BluetoothConnectionDebouncer::ACTION_NOTIFY,
+        debouncer.offer(connectionEvent(BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE, 7), 1900, nextDueMs));
+}
+
+TEST(BluetoothDeviceRegistryTest, apply_TracksPairingConnectionAndDiscoveryEvents)
+{
+    Plugin::BluetoothDeviceRegistry registry;
+    std::unique_ptr<BTRMGR_PairedDevicesList_t> paired(new BTRMGR_PairedDevicesList_t());
+    paired->m_numOfDevices = 1;
+    paired->m_deviceProperty[0].m_deviceHandle = 7;
+    strncpy(paired->m_deviceProperty[0].m_name, "Headphones", BTRMGR_NAME_LEN_MAX - 1);
+
+    EXPECT_FALSE(registry.seeded(Plugin::BluetoothDeviceRegistry::LIST_PAIRED));
+    EXPECT_EQ(0u, registry.syncPaired(*paired));
+    EXPECT_TRUE(registry.seeded(Plugin::BluetoothDeviceRegistry::LIST_PAIRED));
+    EXPECT_FALSE(registry.seeded(Plugin::BluetoothDeviceRegistry::LIST_CONNECTED));
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE;
+    eventMsg.m_pairedDevice.m_deviceHandle = 7;
+    strncpy(eventMsg.m_pairedDevice.m_name, "Headphones", BTRMGR_NAME_LEN_MAX - 1);
+    EXPECT_TRUE(registry.apply(eventMsg, 1000));
+    EXPECT_EQ(1u, registry.size(Plugin::BluetoothDeviceRegistry::LIST_CONNECTED));
+
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE;
+    eventMsg.m_discoveredDevice.m_deviceHandle = 9;
+    eventMsg.m_discoveredDevice.m_isDiscovered = 1;
+    EXPECT_TRUE(registry.apply(eventMsg, 1000));
+
+    std::vector<Plugin::RegisteredDevice> devices;
+    registry.devices(Plugin::BluetoothDeviceRegistry::LIST_DISCOVERED, devices);
+    ASSERT_EQ(1u, devices.size());
+    EXPECT_EQ(9u, devices[0].deviceHandle);
+
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE;
+    eventMsg.m_pairedDevice.m_deviceHandle = 7;
+    EXPECT_TRUE(registry.apply(eventMsg, 1000));
+    EXPECT_EQ(0u, registry.size(Plugin::BluetoothDeviceRegistry::LIST_PAIRED));
+    EXPECT_EQ(0u, registry.size(Plugin::BluetoothDeviceRegistry::LIST_CONNECTED));
+
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED;
+    EXPECT_TRUE(registry.apply(eventMsg, 1000));
+    EXPECT_EQ(0u, registry.size(Plugin::BluetoothDeviceRegistry::LIST_DISCOVERED));
+
+    eventMsg.m_eventType = BTRMGR_EVENT_MEDIA_TRACK_POSITION;
+    EXPECT_FALSE(registry.apply(eventMsg, 1000));
+    EXPECT_EQ(4u, registry.applied());
+}
+
+TEST(BluetoothDeviceRegistryTest, syncConnected_CountsDevicesThatDrifted)
+{
+    Plugin::BluetoothDeviceRegistry registry;
+    std::unique_ptr<BTRMGR_ConnectedDevicesList_t> connected(new BTRMGR_ConnectedDevicesList_t());
+    connected->m_numOfDevices = 2;
+    connected->m_deviceProperty[0].m_deviceHandle = 7;
+    connected->m_deviceProperty[1].m_deviceHandle = 8;
+    EXPECT_EQ(0u, registry.syncConnected(*connected));
+
+    // A missed disconnect of 8 and a missed connect of 9.
+    connected->m_deviceProperty[1].m_deviceHandle = 9;
+    EXPECT_EQ(2u, registry.syncConnected(*connected));
+    EXPECT_EQ(0u, registry.syncConnected(*connected));
+
+    std::vector<Plugin::RegisteredDevice> devices;
+    registry.devices(Plugin::BluetoothDeviceRegistry::LIST_CONNECTED, devices);
+    ASSERT_EQ(2u, devices.size());
+    EXPECT_EQ(7u, devices[0].deviceHandle);
+    EXPECT_EQ(9u, devices[1].deviceHandle);
+    EXPECT_EQ(2u, registry.reconciliations());
+    EXPECT_EQ(2u, registry.mismatches());
+    EXPECT_EQ(2u, registry.mismatches(Plugin::BluetoothDeviceRegistry::LIST_CONNECTED));
+}
+
+TEST(BluetoothDeviceRegistryTest, apply_AdvancesTheGenerationsOfTheChangedLists)
+{
+    Plugin::BluetoothDeviceRegistry registry;
+    std::unique_ptr<BTRMGR_PairedDevicesList_t> paired(new BTRMGR_PairedDevicesList_t());
+    paired->m_numOfDevices = 1;
+    paired->m_deviceProperty[0].m_deviceHandle = 7;
+    strncpy(paired->m_deviceProperty[0].m_name, "Headphones", BTRMGR_NAME_LEN_MAX - 1);
+    registry.syncPaired(*paired);
+
+    const Plugin::BluetoothDeviceListTracker& pairedList = registry.tracker(Plugin::BluetoothDeviceRegistry::LIST_PAIRED);
+    const Plugin::BluetoothDeviceListTracker& connectedList = registry.tracker(Plugin::BluetoothDeviceRegistry::LIST_CONNECTED);
+    const uint64_t pairedGeneration = pairedList.generation();
+    const uint64_t connectedGeneration = connectedList.generation();
+
+    // The same list read again changes nothing.
+    registry.syncPaired(*paired);
+    EXPECT_EQ(pairedGeneration, pairedList.generation());
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE;
+    eventMsg.m_pairedDevice.m_deviceHandle = 7;
+    strncpy(eventMsg.m_pairedDevice.m_name, "Headphones", BTRMGR_NAME_LEN_MAX - 1);
+    EXPECT_TRUE(registry.apply(eventMsg, 1000));
+
+    std::vector<BTRMgrDeviceHandle> added, changed, removed;
+    EXPECT_TRUE(pairedList.delta(pairedGeneration, added, changed, removed));
+    EXPECT_TRUE(added.empty());
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 7 }), changed);
+
+    added.clear(); changed.clear();
+    EXPECT_TRUE(connectedList.delta(connectedGeneration, added, changed, removed));
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 7 }), added);
+
+    const uint64_t connected = connectedList.generation();
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE;
+    eventMsg.m_pairedDevice.m_deviceHandle = 7;
+    EXPECT_TRUE(registry.apply(eventMsg, 1000));
+    added.clear(); changed.clear();
+    EXPECT_TRUE(connectedList.delta(connected, added, changed, removed));
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 7 }), removed);
+}
+
+TEST(BluetoothDeviceListTrackerTest, delta_ReportsAddedChangedAndRemovedDevices)
+{
+    typedef Plugin::BluetoothDeviceListTracker::Device Device;
+    Plugin::BluetoothDeviceListTracker tracker;
+    std::vector<BTRMgrDeviceHandle> added, changed, removed;
+
+    tracker.sync({ Device(1, 10), Device(2, 20) });
+    const uint64_t first = tracker.generation();
+    tracker.sync({ Device(1, 10), Device(2, 20) });
+    EXPECT_EQ(first, tracker.generation());
+    tracker.sync({ Device(1, 11), Device(3, 30) });
+    EXPECT_GT(tracker.generation(), first);
+
+    EXPECT_TRUE(tracker.delta(first, added, changed, removed));
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 3 }), added);
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 1 }), changed);
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 2 }), removed);
+
+    added.clear(); changed.clear(); removed.clear();
+    tracker.touch(3);
+    EXPECT_TRUE(tracker.delta(first, added, changed, removed));
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ 3 }), added);
+
+    added.clear(); changed.clear(); removed.clear();
+    EXPECT_TRUE(tracker.delta(tracker.generation(), added, changed, removed));
+    EXPECT_TRUE(added.empty() && changed.empty() && removed.empty());
+    EXPECT_FALSE(tracker.delta(tracker.generation() + 1, added, changed, removed));
+}
+
+TEST(BluetoothDeviceListTrackerTest, delta_RejectsGenerationsOfOtherEpochs)
+{
+    typedef Plugin::BluetoothDeviceListTracker::Device Device;
+    Plugin::BluetoothDeviceListTracker tracker;
+    Plugin::BluetoothDeviceListTracker other;
+    std::vector<BTRMgrDeviceHandle> added, changed, removed;
+
+    tracker.sync({ Device(1, 10) });
+    other.sync({ Device(1, 10) });
+    EXPECT_NE(tracker.generation(), other.generation());
+    EXPECT_LT(tracker.generation(), 1ULL << 53);
+
+    // Issued by another instance, e.g. from before a restart.
+    EXPECT_FALSE(tracker.delta(other.generation(), added, changed, removed));
+    EXPECT_FALSE(tracker.delta(1, added, changed, removed));
+
+    const uint64_t beforeClear = tracker.generation();
+    tracker.clear();
+    tracker.sync({ Device(1, 10) });
+    EXPECT_NE(beforeClear, tracker.generation());
+    EXPECT_FALSE(tracker.delta(beforeClear, added, changed, removed));
+}
+
+TEST(BluetoothDeviceListTrackerTest, delta_FailsOnceTombstonesWerePruned)
+{
+    typedef Plugin::BluetoothDeviceListTracker::Device Device;
+    Plugin::BluetoothDeviceListTracker tracker;
+    std::vector<BTRMgrDeviceHandle> added, changed, removed;
+
+    tracker.sync({ Device(0, 1) });
+    const uint64_t first = tracker.generation();
+    tracker.sync({ Device(1, 1) });
+    const uint64_t second = tracker.generation();
+    for (BTRMgrDeviceHandle i = 2; i <= BLUETOOTH_DEVICE_LIST_MAX_TOMBSTONES + 1; ++i) {
+        tracker.sync({ Device(i, 1) });
+    }
+    // The tombstone of device 0, removed right after first, was pruned.
+    EXPECT_FALSE(tracker.delta(first, added, changed, removed));
+    EXPECT_TRUE(tracker.delta(second, added, changed, removed));
+    EXPECT_EQ(std::vector<BTRMgrDeviceHandle>({ BLUETOOTH_DEVICE_LIST_MAX_TOMBSTONES + 1 }), added);
+}
+
+TEST(BluetoothDeviceQueryTest, apply_FiltersBeforePaging)
+{
+    std::vector<Plugin::RegisteredDevice> devices(5);
+    const char* names[] = { "JBL Flip", "Pixel 7", "jbl go", "Sony WH", "JBL Charge" };
+    for (int i = 0; i < 5; ++i) {
+        devices[i].deviceHandle = i + 1;
+        devices[i].name = names[i];
+        devices[i].deviceType = (i == 1) ? BTRMGR_DEVICE_TYPE_SMARTPHONE : BTRMGR_DEVICE_TYPE_LOUDSPEAKER;
+        devices[i].paired = (i == 4);
+    }
+
+    Plugin::BluetoothDeviceQuery query;
+    EXPECT_TRUE(query.empty());
+    query.addDeviceType(BTRMGR_DEVICE_TYPE_LOUDSPEAKER);
+    query.setName("JBL");
+    query.setPaired(false);
+    query.setOffset(1);
+    query.setLimit(5);
+
+    // JBL Flip and jbl go match, JBL Charge is paired; the page starts at the second match.
+    EXPECT_EQ(2u, query.apply(devices));
+    ASSERT_EQ(1u, devices.size());
+    EXPECT_EQ(3u, devices[0].deviceHandle);
+
+    Plugin::BluetoothDeviceQuery unknownType;
+    unknownType.restrictDeviceTypes();
+    std::vector<Plugin::RegisteredDevice> more(2);
+    EXPECT_EQ(0u, unknownType.apply(more));
+    EXPECT_TRUE(more.empty());
+}
+
+TEST(BluetoothDeviceQueryTest, apply_SortsByRegistryLastSeen)
+{
+    Plugin::BluetoothDeviceRegistry registry;
+    BTRMGR_DiscoveredDevicesList_t list;
+    memset(&list, 0, sizeof(list));
+    list.m_numOfDevices = 2;
+    list.m_deviceProperty[0].m_deviceHandle = 1;
+    list.m_deviceProperty[1].m_deviceHandle = 2;
+    registry.syncDiscovered(list, 100);
+
+    BTRMGR_EventMessage_t eventMsg;
+    memset(&eventMsg, 0, sizeof(eventMsg));
+    eventMsg.m_eventType = BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE;
+    eventMsg.m_discoveredDevice.m_deviceHandle = 3;
+    eventMsg.m_discoveredDevice.m_isDiscovered = 1;
+    registry.apply(eventMsg, 300);
+    eventMsg.m_discoveredDevice.m_deviceHandle = 1;
+    registry.apply(eventMsg, 200);
+
+    std::vector<Plugin::RegisteredDevice> devices;
+    registry.devices(Plugin::BluetoothDeviceRegistry::LIST_DISCOVERED, devices);
+    Plugin::BluetoothDeviceQuery query;
+    query.setSort(Plugin::BluetoothDeviceQuery::SORT_LAST_SEEN);
+    query.setLimit(2);
+
+    EXPECT_EQ(3u, query.apply(devices));
+    ASSERT_EQ(2u, devices.size());
+    EXPECT_EQ(3u, devices[0].deviceHandle);
+    EXPECT_EQ(1u, devices[1].deviceHandle);
+}
+
+TEST(BluetoothListBufferPoolTest, acquire_ReusesZeroedBuffers)
+{
+    Plugin::BluetoothListBufferPool<BTRMGR_PairedDevicesList_t> pool;
+    BTRMGR_PairedDevicesList_t* first = nullptr;
+    {
+        auto buffer = pool.acquire();
+        ASSERT_TRUE(static_cast<bool>(buffer));
+        EXPECT_EQ(0, buffer->m_numOfDevices);
+        buffer->m_numOfDevices = 3;
+        first = buffer.get();
+    }
+    EXPECT_EQ(1u, pool.pooled());
+
+    {
+        auto buffer = pool.acquire();
+        EXPECT_EQ(first, buffer.get());
+        EXPECT_EQ(0, buffer->m_numOfDevices);
+
+        // Taken while the pooled buffer is out.
+        auto other = pool.acquire();
+        EXPECT_NE(first, other.get());
+    }
+    EXPECT_EQ(1u, pool.hits());
+    EXPECT_EQ(2u, pool.misses());
+    EXPECT_EQ(2u, pool.pooled());
+}
+
+TEST(BluetoothBatchExecutorTest, run_CompletesEveryTaskWithAndWithoutWorkers)
+{
+    for (uint32_t workers : { 0u, 3u }) {
+        Plugin::BluetoothBatchExecutor executor;
+        ASSERT_EQ(Core::ERROR_NONE, executor.start(workers));
+        EXPECT_EQ(workers, executor.workers());
+
+        std::vector<int> results(16, 0);
+        std::vector<Plugin::BluetoothBatchExecutor::Task> tasks;
+        for (size_t i = 0; i < results.size(); ++i) {
+            tasks.push_back([&results, i]() { results[i] = static_cast<int>(i) + 1; });
+        }
+
+        executor.run(tasks);
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_EQ(static_cast<int>(i) + 1, results[i]);
+        }
+        executor.stop();
+    }
+}
+
+TEST(BluetoothHandleMapTest, erase_KeepsRemainingHandlesReachableAcrossGrowth)
+{
+    Plugin::BluetoothHandleMap<int> map;
+    // Handles that share their low bits, as addresses of one vendor do.
+    for (uint64_t i = 0; i < 100; ++i) {
+        map[0xA4C1380000000000ULL + (i << 40)] = static_cast<int>(i);
+    }
+    EXPECT_EQ(100u, map.size());
+
+    for (uint64_t i = 0; i < 100; i += 3) {
+        EXPECT_EQ(1u, map.erase(0xA4C1380000000000ULL + (i << 40)));
+    }
+    EXPECT_EQ(0u, map.erase(0xA4C1380000000000ULL));
+
+    size_t iterated = 0;
+    for (const auto& entry : map) {
+        EXPECT_NE(0u, static_cast<uint64_t>(entry.second) % 3);
+        ++iterated;
+    }
+    EXPECT_EQ(map.size(), iterated);
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        auto it = map.find(0xA4C1380000000000ULL + (i << 40));
+        if (0 == (i % 3)) {
+            EXPECT_TRUE(it == map.end());
+        } else {
+            ASSERT_TRUE(it != map.end());
+            EXPECT_EQ(static_cast<int>(i), it->second);
+        }
+    }
+}
+
+TEST(BluetoothDeviceTypeTest, fromString_InternsNamesAndRoutesByCategory)
+{
+    static_assert(Plugin::BLUETOOTH_DEVICE_CATEGORY_HID == Plugin::kBluetoothDeviceTypes[Plugin::BLUETOOTH_DEVICE_TYPE_HUMAN_INTERFACE_DEVICE].category,
+        "the table is usable at compile time");
+
+    for (uint8_t i = 0; i < Plugin::BLUETOOTH_DEVICE_TYPE_COUNT; ++i) {
+        const Plugin::BluetoothDeviceType type = static_cast<Plugin::BluetoothDeviceType>(i);
+        EXPECT_EQ(type, Plugin::bluetoothDeviceTypeFromString(Plugin::bluetoothDeviceTypeName(type)));
+    }
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT, Plugin::bluetoothDeviceCategory(Plugin::BLUETOOTH_DEVICE_TYPE_TABLET));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_LE, Plugin::bluetoothDeviceCategory(Plugin::BLUETOOTH_DEVICE_TYPE_LE_TILE));
+
+    // Names outside the table are interned once and keep their spelling.
+    const Plugin::BluetoothDeviceType keyboard = Plugin::bluetoothDeviceTypeFromString("BLE KEYBOARD");
+    EXPECT_LE(Plugin::BLUETOOTH_DEVICE_TYPE_COUNT, keyboard);
+    EXPECT_EQ(keyboard, Plugin::bluetoothDeviceTypeFromString("BLE KEYBOARD"));
+    EXPECT_STREQ("BLE KEYBOARD", Plugin::bluetoothDeviceTypeName(keyboard));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_HID, Plugin::bluetoothDeviceCategory(keyboard));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_AUDIO_OUTPUT, Plugin::bluetoothDeviceCategory(Plugin::bluetoothDeviceTypeFromString("SPEAKER")));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_TYPE_UNKNOWN, Plugin::bluetoothDeviceTypeFromString(""));
+
+    // Request input is categorized without taking an interned value.
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_HID, Plugin::bluetoothDeviceCategoryFromString("BLE MOUSE"));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_AUDIO_INPUT, Plugin::bluetoothDeviceCategoryFromString("SMARTPHONE"));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_CATEGORY_HID, Plugin::bluetoothDeviceCategoryFromString("BLE KEYBOARD"));
+    for (int i = 0; i < BLUETOOTH_DEVICE_TYPE_MAX_INTERNED; ++i) {
+        Plugin::bluetoothDeviceCategoryFromString("JUNK " + std::to_string(i));
+    }
+    EXPECT_NE(Plugin::BLUETOOTH_DEVICE_TYPE_UNKNOWN, Plugin::bluetoothDeviceTypeFromString("BLE GAMEPAD"));
+
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_TYPE_HEADPHONES, Plugin::bluetoothDeviceTypeFromBtrmgr(BTRMGR_DEVICE_TYPE_HEADPHONES));
+    EXPECT_EQ(Plugin::BLUETOOTH_DEVICE_TYPE_HUMAN_INTERFACE_DEVICE, Plugin::bluetoothDeviceTypeFromBtrmgr(BTRMGR_DEVICE_TYPE_HID));
+}
+
+TEST(BluetoothDiscoverySessionsTest, mergedType_WidensUntilLastSessionEnds)
+{
+    Plugin::BluetoothDiscoverySessions sessions;
+    EXPECT_EQ(0u, sessions.nextDeadline());
+
+    const Plugin::BluetoothDiscoverySessions::SessionId audio = sessions.open(BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT, 5000);
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT, sessions.mergedType());
+
+    const Plugin::BluetoothDiscoverySessions::SessionId hid = sessions.open(BTRMGR_DEVICE_OP_TYPE_HID, 2000);
+    EXPECT_NE(audio, hid);
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID, sessions.mergedType());
+    EXPECT_FALSE(Plugin::BluetoothDiscoverySessions::covers(BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT, sessions.mergedType()));
+    EXPECT_TRUE(Plugin::BluetoothDiscoverySessions::covers(BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID, BTRMGR_DEVICE_OP_TYPE_HID));
+    EXPECT_EQ(2000u, sessions.nextDeadline());
+
+    // No narrower type finds both audio output and LE devices.
+    sessions.open(BTRMGR_DEVICE_OP_TYPE_LE, 3000);
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_UNKNOWN, sessions.mergedType());
+    EXPECT_TRUE(Plugin::BluetoothDiscoverySessions::covers(BTRMGR_DEVICE_OP_TYPE_UNKNOWN, BTRMGR_DEVICE_OP_TYPE_LE));
+
+    EXPECT_EQ(2u, sessions.expire(3000));
+    EXPECT_FALSE(sessions.close(hid));
+    EXPECT_EQ(5000u, sessions.nextDeadline());
+    EXPECT_TRUE(sessions.close(audio));
+    EXPECT_TRUE(sessions.empty());
+}
+
+TEST(BluetoothDiscoveryDutyCycleTest, next_BacksOffUntilNewDeviceAndAdaptsToConditions)
+{
+    Plugin::BluetoothDiscoveryDutyCycle dutyCycle;
+    dutyCycle.setLimits(4000, 8000, 30000);
+    Plugin::BluetoothDiscoveryDutyCycle::Conditions conditions;
+
+    EXPECT_EQ(8000u, dutyCycle.next(conditions).idleMs);
+    EXPECT_EQ(16000u, dutyCycle.next(conditions).idleMs);
+    EXPECT_EQ(30000u, dutyCycle.next(conditions).idleMs);
+
+    // Only a device not seen before resets the back-off.
+    EXPECT_TRUE(dutyCycle.deviceSeen(7));
+    EXPECT_EQ(8000u, dutyCycle.next(conditions).idleMs);
+    EXPECT_FALSE(dutyCycle.deviceSeen(7));
+    EXPECT_EQ(16000u, dutyCycle.next(conditions).idleMs);
+
+    conditions.audioStreaming = true;
+    Plugin::BluetoothDiscoveryDutyCycle::Window window = dutyCycle.next(conditions);
+    EXPECT_EQ(2000u, window.scanMs);
+    EXPECT_EQ(30000u, window.idleMs);
+
+    conditions.audioStreaming = false;
+    conditions.suspended = true;
+    window = dutyCycle.next(conditions);
+    EXPECT_EQ(0u, window.scanMs);
+    EXPECT_EQ(30000u, window.idleMs);
+
+    EXPECT_EQ(6u, dutyCycle.cycles());
+    EXPECT_EQ(22000u, dutyCycle.scanningMs());
+}
+
+TEST(BluetoothDiscoveryMatcherTest, match_DropsTargetsWithTheirFirstMatch)
+{
+    Plugin::BluetoothDiscoveryMatcher matcher;
+    EXPECT_EQ("AABBCC", Plugin::BluetoothDiscoveryMatcher::addressDigits("aa:bb-cc"));
+
+    Plugin::BluetoothDiscoveryMatcher::Target byAddress;
+    byAddress.addressPrefix = Plugin::BluetoothDiscoveryMatcher::addressDigits("aa:bb");
+    matcher.add(1, byAddress);
+
+    Plugin::BluetoothDiscoveryMatcher::Target byName;
+    byName.query.setName("Speaker");
+    byName.query.addDeviceType(BTRMGR_DEVICE_TYPE_LOUDSPEAKER);
+    matcher.add(2, byName);
+
+    Plugin::RegisteredDevice device;
+    device.name = "Kitchen speaker";
+    device.deviceType = BTRMGR_DEVICE_TYPE_HEADPHONES;
+    std::vector<Plugin::BluetoothDiscoverySessions::SessionId> matched;
+    matcher.match(device, "11:22:33:44:55:66", matched);
+    EXPECT_TRUE(matched.empty());
+
+    device.deviceType = BTRMGR_DEVICE_TYPE_LOUDSPEAKER;
+    matcher.match(device, "AA:BB:33:44:55:66", matched);
+    EXPECT_EQ((std::vector<Plugin::BluetoothDiscoverySessions::SessionId>{ 1, 2 }), matched);
+    EXPECT_TRUE(matcher.empty());
+
+    matcher.add(3, byAddress);
+    matcher.remove(3);
+    matched.clear();
+    matcher.match(device, "AA:BB:33:44:55:66", matched);
+    EXPECT_TRUE(matched.empty());
+}
+
+TEST(BluetoothDiscoveryProfileTest, profiles_TokenizeListsIntoUnions)
+{
+    std::vector<std::string> unknown;
+    const uint32_t profiles = Plugin::bluetoothDiscoveryProfiles("LOUDSPEAKER, le tile,KEYBOARD , TELEVISION", &unknown);
+    EXPECT_EQ(BLUETOOTH_DISCOVERY_PROFILE_AUDIO_OUTPUT | BLUETOOTH_DISCOVERY_PROFILE_LE | BLUETOOTH_DISCOVERY_PROFILE_HID, profiles);
+    ASSERT_EQ(1u, unknown.size());
+    EXPECT_EQ("TELEVISION", unknown[0]);
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_UNKNOWN, Plugin::bluetoothDiscoveryOperationType(profiles));
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT, Plugin::bluetoothDeviceOperationType(profiles));
+
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_AUDIO_AND_HID, Plugin::bluetoothDiscoveryOperationType(Plugin::bluetoothDiscoveryProfiles(BLUETOOTH_DEFAULT_DISCOVERY_PROFILE)));
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_AUDIO_INPUT, Plugin::bluetoothDiscoveryOperationType(Plugin::bluetoothDiscoveryProfiles("TABLET")));
+
+    // Names are whole tokens, one merely containing "LE" is not LE.
+    unknown.clear();
+    EXPECT_EQ(0u, Plugin::bluetoothDiscoveryProfiles("TABLE LAMP", &unknown));
+    EXPECT_EQ(1u, unknown.size());
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_UNKNOWN, Plugin::bluetoothDiscoveryOperationType(0));
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_AUDIO_OUTPUT, Plugin::bluetoothDeviceOperationType(0));
+    EXPECT_EQ(BTRMGR_DEVICE_OP_TYPE_UNKNOWN, Plugin::bluetoothDeviceOperationType(Plugin::bluetoothDiscoveryProfiles("DEFAULT")));
+}
+
+TEST(BluetoothDiscoveryIndexTest, expire_ReportsDevicesNotSeenWithinTtl)
+{
+    Plugin::BluetoothDiscoveryIndex index;
+    std::vector<Plugin::DiscoveredDeviceUpdate> evicted;
+    index.setLimits(1000, 2, evicted);
+    EXPECT_TRUE(index.enabled());
+
+    Plugin::DiscoveredDeviceUpdate update;
+    update.deviceHandle = 1;
+    index.seen(update, 100, evicted);
+    update.deviceHandle = 2;
+    index.seen(update, 200, evicted);
+    update.deviceHandle = 1;
+    index.seen(update, 300, evicted);
+    EXPECT_EQ(300u, index.lastSeen(1));
+    EXPECT_TRUE(evicted.empty());
+
+    // Full: the least recently seen device makes room and is handed back lost.
+    update.deviceHandle = 3;
+    index.seen(update, 400, evicted);
+    EXPECT_EQ(0u, index.lastSeen(2));
+    EXPECT_EQ(1u, index.evicted());
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ(2u, evicted[0].deviceHandle);
+    EXPECT_EQ(Plugin::DISCOVERY_UPDATE_LOST, evicted[0].updateType);
+    EXPECT_TRUE(index.lost(2));
+
+    std::vector<Plugin::DiscoveredDeviceUpdate> expired;
+    EXPECT_EQ(100u, index.expire(1200, expired));
+    EXPECT_TRUE(expired.empty());
+
+    EXPECT_EQ(100u, index.expire(1300, expired));
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(1u, expired[0].deviceHandle);
+    EXPECT_EQ(Plugin::DISCOVERY_UPDATE_LOST, expired[0].updateType);
+    EXPECT_TRUE(index.lost(1));
+
+    EXPECT_TRUE(index.forget(3));
+    EXPECT_EQ(0u, index.expire(5000, expired));
+    EXPECT_EQ(1u, expired.size());
+    EXPECT_EQ(1u, index.expired());
+}
+
+TEST(BluetoothDiscoveryIndexTest, lost_OnlyCoversDevicesReportedLostUntilSeenAgain)
+{
+    Plugin::BluetoothDiscoveryIndex index;
+    std::vector<Plugin::DiscoveredDeviceUpdate> evicted;
+    index.setLimits(1000, 2, evicted);
+
+    // Never indexed, e.g. discovered before activation.
+    EXPECT_FALSE(index.lost(7));
+    EXPECT_EQ(0u, index.lastSeen(7));
+
+    Plugin::DiscoveredDeviceUpdate update;
+    for (BTRMgrDeviceHandle handle = 1; handle <= 3; ++handle) {
+        update.deviceHandle = handle;
+        index.seen(update, 100 * handle, evicted);
+    }
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_TRUE(index.lost(1));
+
+    // Seen again: indexed and no longer lost.
+    update.deviceHandle = 1;
+    index.seen(update, 400, evicted);
+    EXPECT_FALSE(index.lost(1));
+    EXPECT_EQ(400u, index.lastSeen(1));
+    ASSERT_EQ(2u, evicted.size());
+    EXPECT_EQ(2u, evicted[1].deviceHandle);
+
+    // Lowering the limit hands back the devices beyond it as well.
+    index.setLimits(1000, 1, evicted);
+    ASSERT_EQ(3u, evicted.size());
+    EXPECT_EQ(3u, evicted[2].deviceHandle);
+    EXPECT_TRUE(index.lost(3));
+
+    // BTRMGR reporting the device lost itself clears the mark.
+    EXPECT_FALSE(index.forget(3));
+    EXPECT_FALSE(index.lost(3));
+
+    index.clear();
+    EXPECT_FALSE(index.lost(2));
+}
+
+TEST(BluetoothOperationExecutorTest, submit_RunsInOrderAndCancelsPendingJobs)
+{
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<Plugin::BluetoothOperationExecutor::Job> completed;
+
+    Plugin::BluetoothOperationExecutor executor;
+    ASSERT_EQ(Core::ERROR_NONE, executor.start(1, [&](const Plugin::BluetoothOperationExecutor::Job& job) {
+        std::lock_guard<std::mutex> guard(lock);
+        completed.push_back(job);
+        changed.notify_all();
+    }));
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    const Plugin::BluetoothOperationExecutor::JobId pair = executor.submit("pair", 7, [released]() { released.wait(); return true; });
+    const Plugin::BluetoothOperationExecutor::JobId connect = executor.submit("connect", 7, []() { return false; });
+    const Plugin::BluetoothOperationExecutor::JobId unpair = executor.submit("unpair", 8, []() { return true; });
+    EXPECT_NE(0u, pair);
+
+    EXPECT_EQ(Core::ERROR_NONE, executor.cancel(unpair));
+    EXPECT_EQ(Core::ERROR_UNKNOWN_KEY, executor.cancel(99));
+
+    Plugin::BluetoothOperationExecutor::Job job;
+    ASSERT_TRUE(executor.status(connect, job));
+    EXPECT_EQ(Plugin::BluetoothOperationExecutor::STATE_PENDING, job.state);
+
+    release.set_value();
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ASSERT_TRUE(changed.wait_for(guard, std::chrono::seconds(5), [&completed]() { return completed.size() == 3; }));
+    }
+    EXPECT_EQ(unpair, completed[0].id);
+    EXPECT_EQ(Plugin::BluetoothOperationExecutor::STATE_CANCELLED, completed[0].state);
+    EXPECT_EQ(pair, completed[1].id);
+    EXPECT_EQ(Plugin::BluetoothOperationExecutor::STATE_SUCCEEDED, completed[1].state);
+    EXPECT_EQ(connect, completed[2].id);
+    EXPECT_EQ(Plugin::BluetoothOperationExecutor::STATE_FAILED, completed[2].state);
+
+    EXPECT_EQ(Core::ERROR_ILLEGAL_STATE, executor.cancel(pair));
+    executor.stop();
+    EXPECT_EQ(0u, executor.submit("pair", 7, []() { return true; }));
+}
+
+TEST(BluetoothOperationExecutorTest, execute_SerializesPerDeviceAndRunsDevicesConcurrently)
+{
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<Plugin::BluetoothOperationExecutor::JobId> completed;
+
+    Plugin::BluetoothOperationExecutor executor;
+    ASSERT_EQ(Core::ERROR_NONE, executor.start(2, [&](const Plugin::BluetoothOperationExecutor::Job& job) {
+        std::lock_guard<std::mutex> guard(lock);
+        completed.push_back(job.id);
+        changed.notify_all();
+    }));
+    EXPECT_EQ(2u, executor.workers());
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    const Plugin::BluetoothOperationExecutor::JobId disconnect = executor.submit("disconnect", 7, [released]() { released.wait(); return true; });
+    const Plugin::BluetoothOperationExecutor::JobId setVolume = executor.submit("setDeviceVolumeMuteInfo", 7, []() { return true; });
+
+    // Device 8 does not wait for device 7, and a synchronous call keeps its result.
+    EXPECT_FALSE(executor.execute("connect", 8, []() { return false; }));
+
+    std::vector<Plugin::BluetoothOperationExecutor::DeviceStats> stats;
+    executor.deviceStats(stats);
+    ASSERT_EQ(2u, stats.size());
+    for (const Plugin::BluetoothOperationExecutor::DeviceStats& device : stats) {
+        if (7 == device.deviceHandle) {
+            EXPECT_EQ(2u, device.depth);
+            EXPECT_TRUE(device.running);
+        } else {
+            EXPECT_EQ(8u, device.deviceHandle);
+            EXPECT_EQ(0u, device.depth);
+            EXPECT_EQ(1u, device.started);
+        }
+    }
+
+    release.set_value();
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ASSERT_TRUE(changed.wait_for(guard, std::chrono::seconds(5), [&completed]() { return completed.size() == 2; }));
+    }
+    EXPECT_EQ(disconnect, completed[0]);
+    EXPECT_EQ(setVolume, completed[1]);
+
+    executor.stop();
+    EXPECT_TRUE(executor.execute("connect", 8, []() { return true; }));
+}